@@ -0,0 +1,15 @@
+#!/usr/bin/env python3
+# Copyright (c) 2013-2016 The Bitcoin Core developers
+# Copyright (c) 2025 The Soteria Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+SRCDIR="/root/repo"
+BUILDDIR="/root/repo"
+EXEEXT=""
+
+# These will turn into comments if they were disabled when configuring.
+#ENABLE_WALLET=1
+@BUILD_BITCOIN_UTILS_TRUE@ENABLE_UTILS=1
+@BUILD_BITCOIND_TRUE@ENABLE_SOTERIAD=1
+#ENABLE_ZMQ=1
@@ -15,6 +15,7 @@ this program.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 
 #include "LibBoolEE.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -148,6 +149,121 @@ bool LibBoolEE::resolveRec(const std::string &source, const Vals & valuation, Er
     }
 }
 
+LibBoolEE::Program LibBoolEE::compile(const std::string &source, const std::vector<std::string> & variables, ErrorReport* errorReport) {
+    if (variables.size() > Program::MAX_VARIABLES) {
+        throw std::runtime_error("Too many variables to compile the formula '" + source + "'.");
+    }
+    std::map<std::string, uint32_t> indices;
+    for (uint32_t i = 0; i < variables.size(); i++) {
+        indices.emplace(variables[i], i);
+    }
+
+    Program program;
+    if (compileRec(removeWhitespaces(source), indices, program, errorReport) > Program::MAX_STACK) {
+        throw std::runtime_error("The formula '" + source + "' is too deep to compile.");
+    }
+    return program;
+}
+
+// Mirrors resolveRec: the same subexpressions are visited in the same order, so the same errors are raised.
+size_t LibBoolEE::compileRec(const std::string &source, const std::map<std::string, uint32_t> & variables, Program & program, ErrorReport* errorReport) {
+    if (source.empty()) {
+        if (errorReport) {
+            errorReport->type = ErrorReport::ErrorType::EmptySubExpression;
+            errorReport->vecUserData.emplace_back(source);
+            errorReport->strDevData = "bad-txns-null-verifier-empty-sub-expression";
+        }
+        throw std::runtime_error("An empty subexpression was encountered");
+    }
+
+    char current_op = '|';
+    std::vector<std::string> subexpressions = singleParse(source, current_op, errorReport);
+    if (subexpressions.size() == 1) {
+        current_op = '&';
+        subexpressions = singleParse(source, current_op, errorReport);
+    }
+
+    if (subexpressions.size() == 0) {
+        if (errorReport) {
+            errorReport->type = ErrorReport::ErrorType::InvalidQualifierName;
+            errorReport->vecUserData.emplace_back(source);
+            errorReport->strDevData = "bad-txns-null-verifier-no-sub-expressions";
+        }
+        throw std::runtime_error("The subexpression " + source + " is not a valid formula.");
+    }
+    else if (subexpressions.size() == 1) {
+        if (source[0] == '!') {
+            size_t depth = compileRec(removeWhitespaces(source.substr(1)), variables, program, errorReport);
+            program.code.push_back({Program::NOT, 0});
+            return depth;
+        }
+        else if (source[0] == '(') {
+            return compileRec(removeWhitespaces(source.substr(1, source.size() - 2)), variables, program, errorReport);
+        }
+        else if (source == "1") {
+            program.code.push_back({Program::PUSH_TRUE, 0});
+            return 1;
+        }
+        else if (source == "0") {
+            program.code.push_back({Program::PUSH_FALSE, 0});
+            return 1;
+        }
+
+        auto it = variables.find(source);
+        if (it == variables.end()) {
+            if (errorReport) {
+                errorReport->type = ErrorReport::ErrorType::VariableNotFound;
+                errorReport->vecUserData.emplace_back(source);
+                errorReport->strDevData = "bad-txns-null-verifier-variable-not-found";
+            }
+            throw std::runtime_error("Variable '" + source + "' not found in the interpretation.");
+        }
+        program.code.push_back({Program::PUSH_VAR, it->second});
+        return 1;
+    }
+    else {
+        // Operand i is evaluated with i results already on the stack
+        size_t depth = 0;
+        for (size_t i = 0; i < subexpressions.size(); i++) {
+            depth = std::max(depth, i + compileRec(removeWhitespaces(subexpressions[i]), variables, program, errorReport));
+        }
+        program.code.push_back({current_op == '|' ? Program::OR : Program::AND, static_cast<uint32_t>(subexpressions.size())});
+        return depth;
+    }
+}
+
+bool LibBoolEE::Program::evaluate(uint64_t valuation) const {
+    bool stack[MAX_STACK];
+    size_t top = 0;
+    for (const Instr & instr : code) {
+        switch (instr.op) {
+            case PUSH_FALSE:
+                stack[top++] = false;
+                break;
+            case PUSH_TRUE:
+                stack[top++] = true;
+                break;
+            case PUSH_VAR:
+                stack[top++] = (valuation >> instr.arg) & 1;
+                break;
+            case NOT:
+                stack[top - 1] = !stack[top - 1];
+                break;
+            case AND:
+                top -= instr.arg;
+                stack[top] = std::all_of(stack + top, stack + top + instr.arg, [](bool b) { return b; });
+                top++;
+                break;
+            case OR:
+                top -= instr.arg;
+                stack[top] = std::any_of(stack + top, stack + top + instr.arg, [](bool b) { return b; });
+                top++;
+                break;
+        }
+    }
+    return stack[0];
+}
+
 std::string LibBoolEE::trim(const std::string &source) {
     static const std::string WHITESPACES = " \n\r\t\v\f";
     const size_t front = source.find_first_not_of(WHITESPACES);
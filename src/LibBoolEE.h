@@ -33,6 +33,7 @@ this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "assets/assets.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -44,6 +45,26 @@ public:
     typedef std::map<std::string, bool> Vals; ///< Valuation of atomic propositions
     typedef std::pair<std::string, bool> Val; ///< A single proposition valuation
 
+    /// A formula compiled to postfix code over numbered variables, so it can be evaluated without parsing.
+    struct Program {
+        static const size_t MAX_VARIABLES = 64;
+        static const size_t MAX_STACK = 128;
+
+        enum Op : uint8_t { PUSH_FALSE, PUSH_TRUE, PUSH_VAR, NOT, AND, OR };
+        struct Instr {
+            Op op;
+            uint32_t arg; ///< Variable index for PUSH_VAR, operand count for AND and OR
+        };
+        std::vector<Instr> code;
+
+        // @return	the value of the formula when variable i has the value of bit i of valuation
+        bool evaluate(uint64_t valuation) const;
+    };
+
+    // @return	a program that evaluates like resolve(source, v) for every valuation v of the given variables.
+    //		Throws (and fills errorReport) exactly where resolve would, or if the formula exceeds the Program limits.
+    static Program compile(const std::string & source, const std::vector<std::string> & variables, ErrorReport* errorReport = nullptr);
+
     // @return	true iff the formula is true under the valuation (where the valuation are pairs (variable,value))
     static bool resolve(const std::string & source, const Vals & valuation,  ErrorReport* errorReport = nullptr);
 
@@ -62,6 +83,9 @@ private:
     // @return	true iff the formula is true under the valuation (where the valuation are pairs (variable,value))---used internally
     static bool resolveRec(const std::string & source, const Vals & valuation, ErrorReport* errorReport = nullptr);
 
+    // Appends the code for source to program and returns the stack depth it needs---used internally by compile
+    static size_t compileRec(const std::string & source, const std::map<std::string, uint32_t> & variables, Program & program, ErrorReport* errorReport = nullptr);
+
 
     // @return	new string made from the source by removing the leading and trailing white spaces
     static std::string trim(const std::string & source);
@@ -105,6 +105,38 @@ struct CAddressUnspentValue {
     }
 };
 
+/** Totals over all address index entries of one (address, asset) */
+struct CAddressBalanceValue {
+    CAmount received;
+    CAmount balance;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(received);
+        READWRITE(balance);
+    }
+
+    CAddressBalanceValue(CAmount receivedIn, CAmount balanceIn) {
+        received = receivedIn;
+        balance = balanceIn;
+    }
+
+    CAddressBalanceValue() {
+        SetNull();
+    }
+
+    void SetNull() {
+        received = 0;
+        balance = 0;
+    }
+
+    bool IsNull() const {
+        return (received == 0 && balance == 0);
+    }
+};
+
 struct CAddressIndexKey {
     unsigned int type;
     uint160 hashBytes;
@@ -68,7 +68,7 @@ struct SotercGarden {
 };
 
 // Get a 64-byte hash for given 64-byte input, using given SotercGarden contexts and given algo index
-uint512 Soterc(uint512 inputHash, SotercGarden* garden, unsigned int algo, yespower_local_t* local)
+inline uint512 Soterc(uint512 inputHash, SotercGarden* garden, unsigned int algo, yespower_local_t* local)
 {
     uint512 outputHash;
     switch (algo) {
@@ -130,7 +130,7 @@ uint512 Soterc(uint512 inputHash, SotercGarden* garden, unsigned int algo, yespo
 }
 
 // Recursively traverse a given garden starting with a given hash and given node within the garden. The hash is overwritten with the final hash.
-uint512 TraverseSotercGarden(SotercGarden* garden, uint512 hash, SotercNode* node, yespower_local_t* local)
+inline uint512 TraverseSotercGarden(SotercGarden* garden, uint512 hash, SotercNode* node, yespower_local_t* local)
 {
     uint512 partialHash = Soterc(hash, garden, node->algo, local);
 
@@ -151,44 +151,82 @@ uint512 TraverseSotercGarden(SotercGarden* garden, uint512 hash, SotercNode* nod
 }
 
 // Associate child nodes with a parent node
-void LinkSotercNodes(SotercNode* parent, SotercNode* childLeft, SotercNode* childRight)
+inline void LinkSotercNodes(SotercNode* parent, SotercNode* childLeft, SotercNode* childRight)
 {
     parent->childLeft = childLeft;
     parent->childRight = childRight;
 }
 
-// Produce a Soterc 32-byte hash from variable length data
+// Link the garden nodes. Note that both sides of 19 and 20 lead to 21, and 21 has no children (to make traversal complete).
+// Every path through the garden stops at 7 nodes.
+inline void LinkSotercGarden(SotercGarden* garden)
+{
+    LinkSotercNodes(&garden->nodes[0], &garden->nodes[1], &garden->nodes[2]);
+    LinkSotercNodes(&garden->nodes[1], &garden->nodes[3], &garden->nodes[4]);
+    LinkSotercNodes(&garden->nodes[2], &garden->nodes[5], &garden->nodes[6]);
+    LinkSotercNodes(&garden->nodes[3], &garden->nodes[7], &garden->nodes[8]);
+    LinkSotercNodes(&garden->nodes[4], &garden->nodes[9], &garden->nodes[10]);
+    LinkSotercNodes(&garden->nodes[5], &garden->nodes[11], &garden->nodes[12]);
+    LinkSotercNodes(&garden->nodes[6], &garden->nodes[13], &garden->nodes[14]);
+    LinkSotercNodes(&garden->nodes[7], &garden->nodes[15], &garden->nodes[16]);
+    LinkSotercNodes(&garden->nodes[8], &garden->nodes[15], &garden->nodes[16]);
+    LinkSotercNodes(&garden->nodes[9], &garden->nodes[15], &garden->nodes[16]);
+    LinkSotercNodes(&garden->nodes[10], &garden->nodes[15], &garden->nodes[16]);
+    LinkSotercNodes(&garden->nodes[11], &garden->nodes[17], &garden->nodes[18]);
+    LinkSotercNodes(&garden->nodes[12], &garden->nodes[17], &garden->nodes[18]);
+    LinkSotercNodes(&garden->nodes[13], &garden->nodes[17], &garden->nodes[18]);
+    LinkSotercNodes(&garden->nodes[14], &garden->nodes[17], &garden->nodes[18]);
+    LinkSotercNodes(&garden->nodes[15], &garden->nodes[19], &garden->nodes[20]);
+    LinkSotercNodes(&garden->nodes[16], &garden->nodes[19], &garden->nodes[20]);
+    LinkSotercNodes(&garden->nodes[17], &garden->nodes[19], &garden->nodes[20]);
+    LinkSotercNodes(&garden->nodes[18], &garden->nodes[19], &garden->nodes[20]);
+    LinkSotercNodes(&garden->nodes[19], &garden->nodes[21], &garden->nodes[21]);
+    LinkSotercNodes(&garden->nodes[20], &garden->nodes[21], &garden->nodes[21]);
+    garden->nodes[21].childLeft = NULL;
+    garden->nodes[21].childRight = NULL;
+}
+
+/**
+ * What a thread needs to compute Soterc hashes, set up once and reused by every
+ * hash: a garden with its nodes already linked, and yespower memory allocated
+ * (on huge pages where available) and faulted in up front. yespower with
+ * N = 2048, r = 8 works through 2 MiB per hash, so allocating and first
+ * touching that memory is a cost worth keeping out of the hashing.
+ *
+ * Not thread safe: every thread needs its own, see GetThreadSotercContext().
+ */
+class SotercContext
+{
+public:
+    SotercContext()
+    {
+        LinkSotercGarden(&garden);
+        if (yespower_init_local_prealloc(&local, &yespower_params) != 0)
+            yespower_init_local(&local); // Allocate on demand instead
+    }
+
+    ~SotercContext() { yespower_free_local(&local); }
+
+    SotercContext(const SotercContext&) = delete;
+    SotercContext& operator=(const SotercContext&) = delete;
+
+    SotercGarden garden;
+    yespower_local_t local;
+};
+
+/** The SotercContext of the calling thread, set up on its first use */
+inline SotercContext& GetThreadSotercContext()
+{
+    static thread_local SotercContext context;
+    return context;
+}
+
+// Produce a Soterc 32-byte hash from variable length data, using the garden and yespower memory of context.
 // Optionally, use the Soterc hardened hash.
-// Optionally, use provided thread-local memory for yespower.
 template <typename T>
-uint256 Soterc(const T begin, const T end, bool sotercHardened = true, yespower_local_t* local = NULL)
+uint256 Soterc(const T begin, const T end, SotercContext& context, bool sotercHardened = true)
 {
-    // Create garden nodes. Note that both sides of 19 and 20 lead to 21, and 21 has no children (to make traversal complete).
-    // Every path through the garden stops at 7 nodes.
-    SotercGarden garden;
-    LinkSotercNodes(&garden.nodes[0], &garden.nodes[1], &garden.nodes[2]);
-    LinkSotercNodes(&garden.nodes[1], &garden.nodes[3], &garden.nodes[4]);
-    LinkSotercNodes(&garden.nodes[2], &garden.nodes[5], &garden.nodes[6]);
-    LinkSotercNodes(&garden.nodes[3], &garden.nodes[7], &garden.nodes[8]);
-    LinkSotercNodes(&garden.nodes[4], &garden.nodes[9], &garden.nodes[10]);
-    LinkSotercNodes(&garden.nodes[5], &garden.nodes[11], &garden.nodes[12]);
-    LinkSotercNodes(&garden.nodes[6], &garden.nodes[13], &garden.nodes[14]);
-    LinkSotercNodes(&garden.nodes[7], &garden.nodes[15], &garden.nodes[16]);
-    LinkSotercNodes(&garden.nodes[8], &garden.nodes[15], &garden.nodes[16]);
-    LinkSotercNodes(&garden.nodes[9], &garden.nodes[15], &garden.nodes[16]);
-    LinkSotercNodes(&garden.nodes[10], &garden.nodes[15], &garden.nodes[16]);
-    LinkSotercNodes(&garden.nodes[11], &garden.nodes[17], &garden.nodes[18]);
-    LinkSotercNodes(&garden.nodes[12], &garden.nodes[17], &garden.nodes[18]);
-    LinkSotercNodes(&garden.nodes[13], &garden.nodes[17], &garden.nodes[18]);
-    LinkSotercNodes(&garden.nodes[14], &garden.nodes[17], &garden.nodes[18]);
-    LinkSotercNodes(&garden.nodes[15], &garden.nodes[19], &garden.nodes[20]);
-    LinkSotercNodes(&garden.nodes[16], &garden.nodes[19], &garden.nodes[20]);
-    LinkSotercNodes(&garden.nodes[17], &garden.nodes[19], &garden.nodes[20]);
-    LinkSotercNodes(&garden.nodes[18], &garden.nodes[19], &garden.nodes[20]);
-    LinkSotercNodes(&garden.nodes[19], &garden.nodes[21], &garden.nodes[21]);
-    LinkSotercNodes(&garden.nodes[20], &garden.nodes[21], &garden.nodes[21]);
-    garden.nodes[21].childLeft = NULL;
-    garden.nodes[21].childRight = NULL;
+    SotercGarden& garden = context.garden;
 
     // Find initial sha512 hash of the variable length data
     uint512 hash;
@@ -211,7 +249,7 @@ uint256 Soterc(const T begin, const T end, bool sotercHardened = true, yespower_
         garden.nodes[21].algo = SOTERC_ALGO_COUNT;
 
     // Send the initial hash through the garden
-    hash = TraverseSotercGarden(&garden, hash, &garden.nodes[0], local);
+    hash = TraverseSotercGarden(&garden, hash, &garden.nodes[0], &context.local);
 
 #ifdef SOTERC_DEBUG
     printf("** Soterc Final hash:\t\t\t%s\n", hash.trim256().ToString().c_str());
@@ -222,4 +260,11 @@ uint256 Soterc(const T begin, const T end, bool sotercHardened = true, yespower_
     return hash.trim256();
 }
 
+// Produce a Soterc 32-byte hash from variable length data, with the SotercContext of the calling thread.
+template <typename T>
+uint256 Soterc(const T begin, const T end, bool sotercHardened = true)
+{
+    return Soterc(begin, end, GetThreadSotercContext(), sotercHardened);
+}
+
 #endif // SOTERIA_ALGO_SOTERC_H
@@ -1232,6 +1232,111 @@ int yespower_init_local(yespower_local_t *local)
 	return 0;
 }
 
+/*
+ * The number of bytes yespower() allocates for params, or 0 if params are
+ * invalid.
+ */
+static size_t yespower_local_size(const yespower_params_t *params)
+{
+	uint32_t N = params->N;
+	uint32_t r = params->r;
+	size_t B_size, V_size, XY_size, Sbytes;
+
+	if ((params->version != YESPOWER_0_5 &&
+	    params->version != YESPOWER_1_0) ||
+	    N < 1024 || N > 512 * 1024 || r < 8 || r > 32 ||
+	    (N & (N - 1)) != 0)
+		return 0;
+
+	B_size = (size_t)128 * r;
+	V_size = B_size * N;
+	if (params->version == YESPOWER_0_5) {
+		XY_size = B_size * 2;
+		Sbytes = 2 * Swidth_to_Sbytes1(Swidth_0_5);
+	} else {
+		XY_size = B_size + 64;
+		Sbytes = 3 * Swidth_to_Sbytes1(Swidth_1_0);
+	}
+	return B_size + V_size + XY_size + Sbytes;
+}
+
+/*
+ * Like alloc_region(), but back the region with huge pages whatever its size:
+ * explicit ones (MAP_HUGETLB) when the system has some reserved, otherwise a
+ * huge page aligned mapping that the kernel is asked to back with transparent
+ * huge pages.  The region is touched, so that its page faults are taken here
+ * rather than in the first yespower() call.
+ */
+static void *alloc_region_huge(yespower_region_t *region, size_t size)
+{
+#if defined(MAP_ANON) && defined(HUGEPAGE_SIZE)
+	const size_t hugepage_mask = (size_t)HUGEPAGE_SIZE - 1;
+	size_t new_size;
+	uint8_t *base, *aligned;
+	int flags =
+#ifdef MAP_NOCORE
+	    MAP_NOCORE |
+#endif
+	    MAP_ANON | MAP_PRIVATE;
+
+	if (size + 2 * hugepage_mask + 1 < size) {
+		errno = ENOMEM;
+		return NULL;
+	}
+	new_size = (size + hugepage_mask) & ~hugepage_mask;
+
+#ifdef MAP_HUGETLB
+	base = mmap(NULL, new_size, PROT_READ | PROT_WRITE,
+	    flags | MAP_HUGETLB, -1, 0);
+	if (base != MAP_FAILED) {
+		aligned = base;
+	} else
+#endif
+	{
+/*
+ * Over-allocate by one huge page so that the region can start on a huge page
+ * boundary, which transparent huge pages need.
+ */
+		base = mmap(NULL, new_size + hugepage_mask + 1,
+		    PROT_READ | PROT_WRITE, flags, -1, 0);
+		if (base == MAP_FAILED)
+			return NULL;
+		new_size += hugepage_mask + 1;
+		aligned = base + hugepage_mask;
+		aligned -= (uintptr_t)aligned & hugepage_mask;
+#ifdef MADV_HUGEPAGE
+		madvise(aligned, (size + hugepage_mask) & ~hugepage_mask,
+		    MADV_HUGEPAGE);
+#endif
+	}
+
+	region->base = base;
+	region->aligned = aligned;
+	region->base_size = new_size;
+	region->aligned_size = size;
+#else
+	if (!alloc_region(region, size))
+		return NULL;
+#endif
+	memset(region->aligned, 0, size);
+	return region->aligned;
+}
+
+int yespower_init_local_prealloc(yespower_local_t *local,
+    const yespower_params_t *params)
+{
+	size_t need = yespower_local_size(params);
+
+	init_region(local);
+	if (!need) {
+		errno = EINVAL;
+		return -1;
+	}
+	if (!alloc_region_huge(local, need))
+		return -1;
+	return 0;
+}
+
 int yespower_free_local(yespower_local_t *local)
 {
 	return free_region(local);
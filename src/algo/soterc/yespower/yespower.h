@@ -84,6 +84,21 @@ typedef struct {
  */
 extern int yespower_init_local(yespower_local_t *local);
 
+/**
+ * yespower_init_local_prealloc(local, params):
+ * Initialize the thread-local (RAM) data structure and allocate the memory
+ * yespower() needs for params right away.  Where the system provides them the
+ * memory is backed by huge pages, and it is touched before returning, so that
+ * neither allocation nor page faults are left to the first yespower() call.
+ *
+ * Return 0 on success; or -1 on error, in which case local is still
+ * initialized and yespower() allocates on demand.
+ *
+ * MT-safe as long as local is local to the thread.
+ */
+extern int yespower_init_local_prealloc(yespower_local_t *local,
+    const yespower_params_t *params);
+
 /**
  * yespower_free_local(local):
  * Free memory that may have been allocated for an initialized thread-local
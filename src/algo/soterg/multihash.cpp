@@ -0,0 +1,506 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algo/soterg/multihash.h>
+
+#include <algo/soterg/sph_blake.h>
+#include <algo/soterg/sph_cubehash.h>
+#include <algo/soterg/sph_keccak.h>
+#include <algo/soterg/sph_skein.h>
+#include <crypto/common.h>
+
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MULTIHASH_X86 1
+#endif
+
+namespace {
+
+#if defined(__GNUC__)
+
+// The kernels are written once against a generic vector of four 64-bit lanes
+// and inlined into one wrapper per instruction set, which is what decides
+// whether the compiler emits AVX2 or SSE2 code for them.
+#define MULTIHASH_INLINE inline __attribute__((always_inline))
+// Fully unrolled loops turn the table lookups and rotation counts into constants
+#define MULTIHASH_UNROLL _Pragma("GCC unroll 32")
+
+typedef uint64_t u64x4 __attribute__((vector_size(32)));
+
+#define ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+// Vectors are only passed by reference, so the helpers have the same ABI with and without AVX
+MULTIHASH_INLINE void LoadLE(u64x4& v, const unsigned char* const in[MULTIHASH_LANES], int i)
+{
+    v = u64x4{ReadLE64(in[0] + 8 * i), ReadLE64(in[1] + 8 * i), ReadLE64(in[2] + 8 * i), ReadLE64(in[3] + 8 * i)};
+}
+
+MULTIHASH_INLINE void LoadBE(u64x4& v, const unsigned char* const in[MULTIHASH_LANES], int i)
+{
+    v = u64x4{ReadBE64(in[0] + 8 * i), ReadBE64(in[1] + 8 * i), ReadBE64(in[2] + 8 * i), ReadBE64(in[3] + 8 * i)};
+}
+
+MULTIHASH_INLINE void StoreLE(unsigned char* const out[MULTIHASH_LANES], int i, const u64x4& v)
+{
+    for (size_t lane = 0; lane < MULTIHASH_LANES; lane++)
+        WriteLE64(out[lane] + 8 * i, v[lane]);
+}
+
+MULTIHASH_INLINE void StoreBE(unsigned char* const out[MULTIHASH_LANES], int i, const u64x4& v)
+{
+    for (size_t lane = 0; lane < MULTIHASH_LANES; lane++)
+        WriteBE64(out[lane] + 8 * i, v[lane]);
+}
+
+// BLAKE-512: the 64 byte message and its padding fit in a single block
+
+const uint64_t BLAKE512_IV[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL};
+
+const uint64_t BLAKE512_CB[16] = {
+    0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL,
+    0x452821E638D01377ULL, 0xBE5466CF34E90C6CULL, 0xC0AC29B7C97C50DDULL, 0x3F84D5B5B5470917ULL,
+    0x9216D5D98979FB1BULL, 0xD1310BA698DFB5ACULL, 0x2FFD72DBD01ADFB7ULL, 0xB8E1AFED6A267E96ULL,
+    0xBA7C9045F12C7F99ULL, 0x24A19947B3916CF7ULL, 0x0801F2E2858EFC16ULL, 0x636920D871574E69ULL};
+
+const uint8_t BLAKE_SIGMA[10][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0}};
+
+#define BLAKE_G(r, i, a, b, c, d) do { \
+        a += b + (m[BLAKE_SIGMA[r][2 * i]] ^ BLAKE512_CB[BLAKE_SIGMA[r][2 * i + 1]]); \
+        d = ROTR64(d ^ a, 32); \
+        c += d; \
+        b = ROTR64(b ^ c, 25); \
+        a += b + (m[BLAKE_SIGMA[r][2 * i + 1]] ^ BLAKE512_CB[BLAKE_SIGMA[r][2 * i]]); \
+        d = ROTR64(d ^ a, 16); \
+        c += d; \
+        b = ROTR64(b ^ c, 11); \
+    } while (0)
+
+MULTIHASH_INLINE void Blake512x4Impl(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    u64x4 m[16];
+    for (int i = 0; i < 8; i++)
+        LoadBE(m[i], in, i);
+    for (int i = 8; i < 16; i++)
+        m[i] = u64x4{} + (uint64_t)0;
+    m[8] += 0x8000000000000000ULL; // padding bit after the message
+    m[13] += 1;                    // closing padding bit of BLAKE-512
+    m[15] += 512;                  // message length in bits
+
+    u64x4 v[16];
+    for (int i = 0; i < 8; i++)
+        v[i] = u64x4{} + BLAKE512_IV[i];
+    for (int i = 0; i < 8; i++)
+        v[8 + i] = u64x4{} + BLAKE512_CB[i];
+    // The counter is the 512 message bits hashed so far, the salt is zero
+    v[12] ^= 512;
+    v[13] ^= 512;
+
+    MULTIHASH_UNROLL
+    for (int r = 0; r < 16; r++) {
+        int s = r % 10;
+        BLAKE_G(s, 0, v[0], v[4], v[8], v[12]);
+        BLAKE_G(s, 1, v[1], v[5], v[9], v[13]);
+        BLAKE_G(s, 2, v[2], v[6], v[10], v[14]);
+        BLAKE_G(s, 3, v[3], v[7], v[11], v[15]);
+        BLAKE_G(s, 4, v[0], v[5], v[10], v[15]);
+        BLAKE_G(s, 5, v[1], v[6], v[11], v[12]);
+        BLAKE_G(s, 6, v[2], v[7], v[8], v[13]);
+        BLAKE_G(s, 7, v[3], v[4], v[9], v[14]);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        u64x4 h = (u64x4{} + BLAKE512_IV[i]) ^ v[i] ^ v[8 + i];
+        StoreBE(out, i, h);
+    }
+}
+
+#undef BLAKE_G
+
+// Keccak-512 (the original submission padding sph uses): the 64 byte message
+// and its padding fit in the 72 byte rate, so it is a single permutation
+
+const uint64_t KECCAK_RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+//! Rotation of lane x + 5y
+const int KECCAK_RHO[25] = {
+    0, 1, 62, 28, 27,
+    36, 44, 6, 55, 20,
+    3, 10, 43, 25, 39,
+    41, 45, 15, 21, 8,
+    18, 2, 61, 56, 14};
+
+MULTIHASH_INLINE void Keccak512x4Impl(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    u64x4 a[25];
+    for (int i = 0; i < 8; i++)
+        LoadLE(a[i], in, i);
+    a[8] = u64x4{} + 0x8000000000000001ULL;
+    for (int i = 9; i < 25; i++)
+        a[i] = u64x4{} + (uint64_t)0;
+
+    for (int round = 0; round < 24; round++) {
+        u64x4 c[5], b[25];
+        MULTIHASH_UNROLL
+        for (int x = 0; x < 5; x++)
+            c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        MULTIHASH_UNROLL
+        for (int x = 0; x < 5; x++) {
+            u64x4 d = c[(x + 4) % 5] ^ ROTL64(c[(x + 1) % 5], 1);
+            MULTIHASH_UNROLL
+            for (int y = 0; y < 25; y += 5)
+                a[y + x] ^= d;
+        }
+        // rho and pi: lane (x, y) moves to (y, 2x + 3y)
+        b[0] = a[0];
+        MULTIHASH_UNROLL
+        for (int x = 0; x < 5; x++) {
+            MULTIHASH_UNROLL
+            for (int y = 0; y < 5; y++) {
+                if (x == 0 && y == 0)
+                    continue;
+                int n = KECCAK_RHO[x + 5 * y];
+                b[y + 5 * ((2 * x + 3 * y) % 5)] = ROTL64(a[x + 5 * y], n);
+            }
+        }
+        MULTIHASH_UNROLL
+        for (int y = 0; y < 25; y += 5) {
+            MULTIHASH_UNROLL
+            for (int x = 0; x < 5; x++)
+                a[y + x] = b[y + x] ^ (~b[y + (x + 1) % 5] & b[y + (x + 2) % 5]);
+        }
+        a[0] ^= KECCAK_RC[round];
+    }
+
+    for (int i = 0; i < 8; i++)
+        StoreLE(out, i, a[i]);
+}
+
+// Skein-512-512: one UBI call for the 64 byte message and one for the output
+
+const uint64_t SKEIN512_IV[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL};
+
+const int SKEIN_ROT_EVEN[4][4] = {{46, 36, 19, 37}, {33, 27, 14, 42}, {17, 49, 36, 39}, {44, 9, 54, 56}};
+const int SKEIN_ROT_ODD[4][4] = {{39, 30, 34, 24}, {13, 50, 10, 17}, {25, 29, 39, 43}, {8, 35, 56, 22}};
+
+#define SKEIN_MIX(x0, x1, rc) do { \
+        x0 += x1; \
+        x1 = ROTL64(x1, rc) ^ x0; \
+    } while (0)
+
+#define SKEIN_MIX8(w0, w1, w2, w3, w4, w5, w6, w7, rot) do { \
+        SKEIN_MIX(w0, w1, rot[0]); \
+        SKEIN_MIX(w2, w3, rot[1]); \
+        SKEIN_MIX(w4, w5, rot[2]); \
+        SKEIN_MIX(w6, w7, rot[3]); \
+    } while (0)
+
+//! One UBI block: h = Threefish-512(key h, tweak t0/t1, m) ^ m
+MULTIHASH_INLINE void SkeinUBI(u64x4 h[8], const u64x4 m[8], uint64_t t0, uint64_t t1)
+{
+    u64x4 k[9];
+    k[8] = u64x4{} + 0x1BD11BDAA9FC1A22ULL;
+    for (int i = 0; i < 8; i++) {
+        k[i] = h[i];
+        k[8] ^= h[i];
+    }
+    const uint64_t t[3] = {t0, t1, t0 ^ t1};
+
+    u64x4 p[8];
+    for (int i = 0; i < 8; i++)
+        p[i] = m[i];
+
+    MULTIHASH_UNROLL
+    for (int s = 0; s < 18; s++) {
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 8; i++)
+            p[i] += k[(s + i) % 9];
+        p[5] += t[s % 3];
+        p[6] += t[(s + 1) % 3];
+        p[7] += (uint64_t)s;
+
+        const int (*rot)[4] = (s & 1) ? SKEIN_ROT_ODD : SKEIN_ROT_EVEN;
+        SKEIN_MIX8(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], rot[0]);
+        SKEIN_MIX8(p[2], p[1], p[4], p[7], p[6], p[5], p[0], p[3], rot[1]);
+        SKEIN_MIX8(p[4], p[1], p[6], p[3], p[0], p[5], p[2], p[7], rot[2]);
+        SKEIN_MIX8(p[6], p[1], p[0], p[7], p[2], p[5], p[4], p[3], rot[3]);
+    }
+    for (int i = 0; i < 8; i++)
+        p[i] += k[(18 + i) % 9];
+    p[5] += t[18 % 3];
+    p[6] += t[(18 + 1) % 3];
+    p[7] += (uint64_t)18;
+
+    for (int i = 0; i < 8; i++)
+        h[i] = m[i] ^ p[i];
+}
+
+#undef SKEIN_MIX8
+#undef SKEIN_MIX
+
+MULTIHASH_INLINE void Skein512x4Impl(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    u64x4 h[8], m[8];
+    for (int i = 0; i < 8; i++) {
+        h[i] = u64x4{} + SKEIN512_IV[i];
+        LoadLE(m[i], in, i);
+    }
+    // Message block: first and final, type msg, 64 bytes
+    SkeinUBI(h, m, 64, (uint64_t)480 << 55);
+
+    // Output block: first and final, type out, the 8 byte counter 0
+    for (int i = 0; i < 8; i++)
+        m[i] = u64x4{} + (uint64_t)0;
+    SkeinUBI(h, m, 8, (uint64_t)510 << 55);
+
+    for (int i = 0; i < 8; i++)
+        StoreLE(out, i, h[i]);
+}
+
+// CubeHash16/32-512: its 32-bit words take four lanes per 128-bit vector, so
+// the kernel runs at full width on SSE2 as well
+
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+const uint32_t CUBEHASH512_IV[32] = {
+    0x2AEA2A61, 0x50F494D4, 0x2D538B8B, 0x4167D83E, 0x3FEE2313, 0xC701CF8C, 0xCC39968E, 0x50AC5695,
+    0x4D42C787, 0xA647A8B3, 0x97CF0BEF, 0x825B4537, 0xEEF864D2, 0xF22090C4, 0xD0E5CD33, 0xA23911AE,
+    0xFCD398D9, 0x148FE485, 0x1B017BEF, 0xB6444532, 0x6A536159, 0x2FF5781C, 0x91FA7934, 0x0DBADEA9,
+    0xD65C8A2B, 0xA5A70E75, 0xB1C62456, 0xBC796576, 0x1921C8F7, 0xE7989AF1, 0x7795D246, 0xD43E3B44};
+
+MULTIHASH_INLINE void CubeHashLoad(u32x4& v, const unsigned char* const in[MULTIHASH_LANES], int i)
+{
+    v = u32x4{ReadLE32(in[0] + 4 * i), ReadLE32(in[1] + 4 * i), ReadLE32(in[2] + 4 * i), ReadLE32(in[3] + 4 * i)};
+}
+
+//! Sixteen rounds over x[32], word x_ijklm at index 16i + 8j + 4k + 2l + m
+MULTIHASH_INLINE void CubeHashRounds(u32x4 x[32])
+{
+    MULTIHASH_UNROLL
+    for (int r = 0; r < 16; r++) {
+        u32x4 t;
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[16 + i] += x[i];
+            x[i] = ROTL32(x[i], 7);
+        }
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 8; i++) {
+            t = x[i];
+            x[i] = x[i + 8];
+            x[i + 8] = t;
+        }
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 16; i++)
+            x[i] ^= x[16 + i];
+        MULTIHASH_UNROLL
+        for (int i = 16; i < 32; i++) {
+            if (i & 2)
+                continue;
+            t = x[i];
+            x[i] = x[i + 2];
+            x[i + 2] = t;
+        }
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[16 + i] += x[i];
+            x[i] = ROTL32(x[i], 11);
+        }
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 16; i++) {
+            if (i & 4)
+                continue;
+            t = x[i];
+            x[i] = x[i + 4];
+            x[i + 4] = t;
+        }
+        MULTIHASH_UNROLL
+        for (int i = 0; i < 16; i++)
+            x[i] ^= x[16 + i];
+        MULTIHASH_UNROLL
+        for (int i = 16; i < 32; i++) {
+            if (i & 1)
+                continue;
+            t = x[i];
+            x[i] = x[i + 1];
+            x[i + 1] = t;
+        }
+    }
+}
+
+MULTIHASH_INLINE void CubeHash512x4Impl(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    u32x4 m[16];
+    for (int i = 0; i < 16; i++)
+        CubeHashLoad(m[i], in, i);
+
+    u32x4 x[32];
+    for (int i = 0; i < 32; i++)
+        x[i] = u32x4{} + CUBEHASH512_IV[i];
+    // Two 32 byte message blocks, then the padding block
+    for (int block = 0; block < 2; block++) {
+        for (int i = 0; i < 8; i++)
+            x[i] ^= m[8 * block + i];
+        CubeHashRounds(x);
+    }
+    x[0] ^= 0x80;
+    CubeHashRounds(x);
+    // Finalization
+    x[31] ^= 1;
+    for (int i = 0; i < 10; i++)
+        CubeHashRounds(x);
+
+    for (int i = 0; i < 16; i++) {
+        for (size_t lane = 0; lane < MULTIHASH_LANES; lane++)
+            WriteLE32(out[lane] + 4 * i, x[i][lane]);
+    }
+}
+
+#undef ROTL32
+#undef ROTL64
+#undef ROTR64
+#undef MULTIHASH_UNROLL
+
+#define MULTIHASH_WRAPPERS(name) \
+    void name##Generic(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]) \
+    { \
+        name##Impl(in, out); \
+    }
+
+MULTIHASH_WRAPPERS(Keccak512x4)
+MULTIHASH_WRAPPERS(CubeHash512x4)
+
+#undef MULTIHASH_WRAPPERS
+
+#ifdef MULTIHASH_X86
+#define MULTIHASH_WRAPPERS(name) \
+    __attribute__((target("avx2"))) void name##AVX2(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]) \
+    { \
+        name##Impl(in, out); \
+    }
+
+MULTIHASH_WRAPPERS(Blake512x4)
+MULTIHASH_WRAPPERS(Keccak512x4)
+MULTIHASH_WRAPPERS(Skein512x4)
+MULTIHASH_WRAPPERS(CubeHash512x4)
+
+#undef MULTIHASH_WRAPPERS
+#endif // MULTIHASH_X86
+
+#endif // __GNUC__
+
+// The lanes hashed one after the other by sph. BLAKE and Skein are add and
+// rotate heavy, which two 64-bit lanes per SSE2 register do not speed up, so
+// only AVX2 gets vector versions of them.
+#define MULTIHASH_WRAPPERS(name, algo) \
+    void name##Scalar(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]) \
+    { \
+        for (size_t lane = 0; lane < MULTIHASH_LANES; lane++) { \
+            sph_##algo##_context ctx; \
+            sph_##algo##_init(&ctx); \
+            sph_##algo(&ctx, in[lane], 64); \
+            sph_##algo##_close(&ctx, out[lane]); \
+        } \
+    }
+
+MULTIHASH_WRAPPERS(Blake512x4, blake512)
+MULTIHASH_WRAPPERS(Skein512x4, skein512)
+#ifndef __GNUC__
+MULTIHASH_WRAPPERS(Keccak512x4, keccak512)
+MULTIHASH_WRAPPERS(CubeHash512x4, cubehash512)
+#endif
+
+#undef MULTIHASH_WRAPPERS
+
+struct MultiHashDispatch
+{
+    const char* name;
+    MultiHash512Fn blake512;
+    MultiHash512Fn keccak512;
+    MultiHash512Fn skein512;
+    MultiHash512Fn cubehash512;
+};
+
+const MultiHashDispatch& GetDispatch()
+{
+    static const MultiHashDispatch dispatch = []() -> MultiHashDispatch {
+#ifdef MULTIHASH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return {"avx2", Blake512x4AVX2, Keccak512x4AVX2, Skein512x4AVX2, CubeHash512x4AVX2};
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+        return {"sse2", Blake512x4Scalar, Keccak512x4Generic, Skein512x4Scalar, CubeHash512x4Generic};
+#elif defined(__GNUC__)
+        return {"generic", Blake512x4Scalar, Keccak512x4Generic, Skein512x4Scalar, CubeHash512x4Generic};
+#else
+        return {"generic", Blake512x4Scalar, Keccak512x4Scalar, Skein512x4Scalar, CubeHash512x4Scalar};
+#endif
+    }();
+    return dispatch;
+}
+
+} // namespace
+
+void Blake512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    GetDispatch().blake512(in, out);
+}
+
+void Keccak512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    GetDispatch().keccak512(in, out);
+}
+
+void Skein512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    GetDispatch().skein512(in, out);
+}
+
+void CubeHash512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES])
+{
+    GetDispatch().cubehash512(in, out);
+}
+
+bool IsMultiHashVectorized(MultiHash512Fn fn)
+{
+#if defined(__GNUC__)
+    const MultiHashDispatch& dispatch = GetDispatch();
+    if (fn == Blake512x4_64)
+        return dispatch.blake512 != Blake512x4Scalar;
+    if (fn == Skein512x4_64)
+        return dispatch.skein512 != Skein512x4Scalar;
+    return fn == Keccak512x4_64 || fn == CubeHash512x4_64;
+#else
+    return false;
+#endif
+}
+
+const char* MultiHashImplementation()
+{
+    return GetDispatch().name;
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SOTER_MULTIHASH_H
+#define SOTER_MULTIHASH_H
+
+#include <stddef.h>
+
+/**
+ * Multi-buffer versions of the sph hash functions of the X12 chains.
+ *
+ * Each function hashes MULTIHASH_LANES independent 64 byte messages, the
+ * input of every X12 round after the first, with one lane per vector element.
+ * The results equal those of the scalar sph functions. in[i] and out[i]
+ * may point to the same buffer, but different lanes must not share buffers.
+ *
+ * On x86 the AVX2 kernels are picked at runtime when the CPU supports them,
+ * otherwise the same code is built for SSE2 (or whatever vector unit the
+ * target has) by the compiler. BLAKE and Skein gain nothing from two 64-bit
+ * lanes per SSE2 register and hash the lanes one by one there.
+ *
+ * The other X12 functions have no multi-buffer version: groestl, echo,
+ * shavite, fugue, hamsi and whirlpool are built on table lookups or AES
+ * rounds, and simd, jh, luffa, shabal and sha512 are left to sph as well.
+ * There is no 8 lane variant either, which for 64-bit words needs AVX-512.
+ */
+static const size_t MULTIHASH_LANES = 4;
+
+typedef void (*MultiHash512Fn)(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]);
+
+/** sph_blake512 of MULTIHASH_LANES 64 byte messages */
+void Blake512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]);
+/** sph_keccak512 of MULTIHASH_LANES 64 byte messages */
+void Keccak512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]);
+/** sph_skein512 of MULTIHASH_LANES 64 byte messages */
+void Skein512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]);
+/** sph_cubehash512 of MULTIHASH_LANES 64 byte messages */
+void CubeHash512x4_64(const unsigned char* const in[MULTIHASH_LANES], unsigned char* const out[MULTIHASH_LANES]);
+
+/** Whether fn, one of the functions above, runs a vector kernel on this CPU rather than hashing lane by lane */
+bool IsMultiHashVectorized(MultiHash512Fn fn);
+
+/** The instruction set the multi-buffer functions run on: "avx2", "sse2" or "generic" */
+const char* MultiHashImplementation();
+
+#endif // SOTER_MULTIHASH_H
@@ -23,7 +23,9 @@
 #include "sph_sha2.h"
 #include "sph_whirlpool.h"
 #include "sph_fugue.h"
+#include "multihash.h"
 #include "../../crypto/sha256.h"
+#include <algorithm>
 #include <vector>
 
 class CBlockHeader;
@@ -794,4 +796,264 @@ inline uint256 X8S(const T1 pbegin, const T1 pend, const uint256 PrevBlockHash)
     }
     return hash[8].trim256(); 
 }
+
+// Midstate hashing for X12R/X12ST
+//
+// A miner only changes the trailing 4 byte nNonce of the 80 byte header it
+// hashes, so the first round can absorb the other 76 bytes once per template
+// and start each nonce from a copy of that context.
+
+/** The 512-bit sph functions the X12R and X12ST chains are built from */
+enum class SphAlgo512 {
+    BLAKE, SHABAL, GROESTL, JH, KECCAK, SKEIN, LUFFA, CUBEHASH, SIMD, ECHO, HAMSI, SHA512, // X12R selections 0-11
+    FUGUE, WHIRLPOOL, SHAVITE
+};
+
+struct SphFunctions512 {
+    const char* name;
+    void (*init)(void* cc);
+    void (*write)(void* cc, const void* data, size_t len);
+    void (*close)(void* cc, void* dst);
+};
+
+static const SphFunctions512 SPH_FUNCTIONS_512[] = {
+    {"blake512", sph_blake512_init, sph_blake512, sph_blake512_close},
+    {"shabal512", sph_shabal512_init, sph_shabal512, sph_shabal512_close},
+    {"groestl512", sph_groestl512_init, sph_groestl512, sph_groestl512_close},
+    {"jh512", sph_jh512_init, sph_jh512, sph_jh512_close},
+    {"keccak512", sph_keccak512_init, sph_keccak512, sph_keccak512_close},
+    {"skein512", sph_skein512_init, sph_skein512, sph_skein512_close},
+    {"luffa512", sph_luffa512_init, sph_luffa512, sph_luffa512_close},
+    {"cubehash512", sph_cubehash512_init, sph_cubehash512, sph_cubehash512_close},
+    {"simd512", sph_simd512_init, sph_simd512, sph_simd512_close},
+    {"echo512", sph_echo512_init, sph_echo512, sph_echo512_close},
+    {"hamsi512", sph_hamsi512_init, sph_hamsi512, sph_hamsi512_close},
+    {"sha512", sph_sha512_init, sph_sha512, sph_sha512_close},
+    {"fugue512", sph_fugue512_init, sph_fugue512, sph_fugue512_close},
+    {"whirlpool", sph_whirlpool_init, sph_whirlpool, sph_whirlpool_close},
+    {"shavite512", sph_shavite512_init, sph_shavite512, sph_shavite512_close},
+};
+
+inline const SphFunctions512& GetSphFunctions512(SphAlgo512 algo)
+{
+    return SPH_FUNCTIONS_512[static_cast<int>(algo)];
+}
+
+/** Storage for the context of any SphAlgo512 */
+union SphContext512 {
+    sph_blake512_context blake;
+    sph_shabal512_context shabal;
+    sph_groestl512_context groestl;
+    sph_jh512_context jh;
+    sph_keccak512_context keccak;
+    sph_skein512_context skein;
+    sph_luffa512_context luffa;
+    sph_cubehash512_context cubehash;
+    sph_simd512_context simd;
+    sph_echo512_context echo;
+    sph_hamsi512_context hamsi;
+    sph_sha512_context sha512;
+    sph_fugue512_context fugue;
+    sph_whirlpool_context whirlpool;
+    sph_shavite512_context shavite;
+};
+
+static const int X12_ROUNDS = 12;
+
+/** The order of the HashX12ST chain */
+static const SphAlgo512 X12ST_CHAIN[X12_ROUNDS] = {
+    SphAlgo512::FUGUE, SphAlgo512::FUGUE, SphAlgo512::WHIRLPOOL, SphAlgo512::ECHO,
+    SphAlgo512::LUFFA, SphAlgo512::SHAVITE, SphAlgo512::HAMSI, SphAlgo512::JH,
+    SphAlgo512::SHAVITE, SphAlgo512::WHIRLPOOL, SphAlgo512::ECHO, SphAlgo512::LUFFA
+};
+
+/** The order of the HashX12R chain selected by PrevBlockHash */
+inline void GetX12RChain(const uint256& PrevBlockHash, SphAlgo512 chain[X12_ROUNDS])
+{
+    for (int i = 0; i < X12_ROUNDS; i++)
+        chain[i] = static_cast<SphAlgo512>(GetHashSelection(PrevBlockHash, i));
+}
+
+/**
+ * The multi-buffer version of a SphAlgo512 function, or null if it has no
+ * vector kernel on this CPU. Only BLAKE, Keccak, Skein and CubeHash have
+ * kernels (BLAKE and Skein on AVX2 only); the table and AES based functions
+ * and the rest of the X12ST chain are hashed one lane at a time.
+ */
+inline MultiHash512Fn GetMultiHash512(SphAlgo512 algo)
+{
+    MultiHash512Fn multi;
+    switch (algo) {
+    case SphAlgo512::BLAKE:
+        multi = Blake512x4_64;
+        break;
+    case SphAlgo512::KECCAK:
+        multi = Keccak512x4_64;
+        break;
+    case SphAlgo512::SKEIN:
+        multi = Skein512x4_64;
+        break;
+    case SphAlgo512::CUBEHASH:
+        multi = CubeHash512x4_64;
+        break;
+    default:
+        return nullptr;
+    }
+    return IsMultiHashVectorized(multi) ? multi : nullptr;
+}
+
+/** Whether a round after the first of chain has a multi-buffer kernel, the only case where batching it pays off */
+inline bool HasMultiHashRounds(const SphAlgo512 chain[X12_ROUNDS])
+{
+    for (int round = 1; round < X12_ROUNDS; round++) {
+        if (GetMultiHash512(chain[round]))
+            return true;
+    }
+    return false;
+}
+
+/** One round of an X12 chain on a single 64 byte hash, in place */
+inline void HashX12Round(SphAlgo512 algo, uint512& hash)
+{
+    const SphFunctions512& functions = GetSphFunctions512(algo);
+    uint512 result;
+    SphContext512 ctx;
+    functions.init(&ctx);
+    functions.write(&ctx, hash.begin(), 64);
+    functions.close(&ctx, result.begin());
+    hash = result;
+}
+
+/**
+ * Rounds 1 to 11 of n X12 chains, side by side.
+ *
+ * hashes[i] holds the output of the first round of chains[i] and is replaced
+ * by the output of its last round. In each round the lanes that run a function
+ * with a multi-buffer kernel are grouped and hashed MULTIHASH_LANES at a time,
+ * the others are hashed right away. Callers only pass chains for which
+ * HasMultiHashRounds() holds; for the others grouping gains nothing.
+ */
+inline void HashX12Rounds(const SphAlgo512* const chains[], uint512 hashes[], size_t n)
+{
+    static const size_t ALGO_COUNT = sizeof(SPH_FUNCTIONS_512) / sizeof(SPH_FUNCTIONS_512[0]);
+    std::vector<size_t> vLanes[ALGO_COUNT];
+    MultiHash512Fn vMulti[ALGO_COUNT];
+    for (size_t algo = 0; algo < ALGO_COUNT; algo++)
+        vMulti[algo] = GetMultiHash512(static_cast<SphAlgo512>(algo));
+
+    for (int round = 1; round < X12_ROUNDS; round++) {
+        for (size_t i = 0; i < n; i++) {
+            SphAlgo512 algo = chains[i][round];
+            if (vMulti[static_cast<int>(algo)])
+                vLanes[static_cast<int>(algo)].push_back(i);
+            else
+                HashX12Round(algo, hashes[i]);
+        }
+
+        for (size_t algo = 0; algo < ALGO_COUNT; algo++) {
+            std::vector<size_t>& vGroup = vLanes[algo];
+            if (vGroup.empty())
+                continue;
+            // Each lane hashes in place. The kernels allow that but not lanes
+            // sharing buffers, so a short last group is padded with a scratch
+            // slot per lane rather than duplicates.
+            uint512 scratch[MULTIHASH_LANES];
+            size_t nNext = 0;
+            for (; nNext + 1 < vGroup.size(); nNext += MULTIHASH_LANES) {
+                const unsigned char* in[MULTIHASH_LANES];
+                unsigned char* out[MULTIHASH_LANES];
+                for (size_t lane = 0; lane < MULTIHASH_LANES; lane++) {
+                    unsigned char* p = nNext + lane < vGroup.size() ? hashes[vGroup[nNext + lane]].begin() : scratch[lane].begin();
+                    in[lane] = p;
+                    out[lane] = p;
+                }
+                vMulti[algo](in, out);
+            }
+            for (; nNext < vGroup.size(); nNext++)
+                HashX12Round(static_cast<SphAlgo512>(algo), hashes[vGroup[nNext]]);
+            vGroup.clear();
+        }
+    }
+}
+
+/**
+ * HashX12R or HashX12ST of 80 byte headers that share their first 76 bytes.
+ *
+ * Init() absorbs the shared prefix into the first round; Hash() then equals
+ * HashX12R(prefix || nNonce, PrevBlockHash) or HashX12ST(prefix || nNonce)
+ * at the cost of a context copy and the 4 nonce bytes for that round.
+ */
+class CX12Midstate
+{
+public:
+    static const size_t PREFIX_SIZE = 76;
+
+    void InitX12R(const unsigned char* prefix, const uint256& PrevBlockHash)
+    {
+        GetX12RChain(PrevBlockHash, chain);
+        Absorb(prefix);
+    }
+
+    void InitX12ST(const unsigned char* prefix)
+    {
+        std::copy(X12ST_CHAIN, X12ST_CHAIN + X12_ROUNDS, chain);
+        Absorb(prefix);
+    }
+
+    const SphAlgo512* GetChain() const { return chain; }
+
+    /** The output of the first round, the one that takes the header */
+    void HashFirstRound(uint32_t nNonce, uint512& hash) const
+    {
+        SphContext512 ctx = ctxPrefix;
+        const SphFunctions512& first = GetSphFunctions512(chain[0]);
+        first.write(&ctx, &nNonce, sizeof(nNonce));
+        first.close(&ctx, hash.begin());
+    }
+
+    /** nNonce is hashed in memory order, as HashX12R over a CBlockHeader does */
+    uint256 Hash(uint32_t nNonce) const
+    {
+        uint512 hash[2];
+        HashFirstRound(nNonce, hash[0]);
+
+        SphContext512 ctx;
+        for (int i = 1; i < X12_ROUNDS; i++) {
+            const SphFunctions512& round = GetSphFunctions512(chain[i]);
+            round.init(&ctx);
+            round.write(&ctx, hash[(i - 1) & 1].begin(), 64);
+            round.close(&ctx, hash[i & 1].begin());
+        }
+        return hash[(X12_ROUNDS - 1) & 1].trim256();
+    }
+
+    /** Hash() of the n nonces nNonce, nNonce + 1, ..., with the later rounds run side by side if the chain has multi-buffer kernels */
+    void Hash(uint32_t nNonce, uint256 hashes[], size_t n) const
+    {
+        if (!HasMultiHashRounds(chain)) {
+            for (size_t i = 0; i < n; i++)
+                hashes[i] = Hash(nNonce + i);
+            return;
+        }
+        std::vector<uint512> vHashes(n);
+        std::vector<const SphAlgo512*> vChains(n, chain);
+        for (size_t i = 0; i < n; i++)
+            HashFirstRound(nNonce + i, vHashes[i]);
+        HashX12Rounds(vChains.data(), vHashes.data(), n);
+        for (size_t i = 0; i < n; i++)
+            hashes[i] = vHashes[i].trim256();
+    }
+
+private:
+    SphAlgo512 chain[X12_ROUNDS];
+    SphContext512 ctxPrefix;
+
+    void Absorb(const unsigned char* prefix)
+    {
+        const SphFunctions512& first = GetSphFunctions512(chain[0]);
+        first.init(&ctxPrefix);
+        first.write(&ctxPrefix, prefix, PREFIX_SIZE);
+    }
+};
+
 #endif // SOTER_HASHALGOS_H
@@ -9,6 +9,12 @@
 #include "assets.h"
 #include "validation.h"
 
+#include <util/strencodings.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
 #include <boost/thread.hpp>
 
 static const char ASSET_FLAG = 'A';
@@ -208,77 +214,209 @@ bool CAssetsDB::LoadAssets()
     return true;
 }
 
-bool CAssetsDB::AssetDir(std::vector<CDatabasedAssetData>& assets, const std::string filter, const size_t count, const long start)
+namespace {
+/**
+ * Asset keys are (ASSET_FLAG, name) with the name serialized behind its
+ * CompactSize length, so the database orders names by length first and
+ * bytewise second. Names sharing a prefix are therefore contiguous only
+ * within one length; this key seeks to the first name of a given length
+ * that starts with prefix.
+ */
+class AssetNameSeekKey
 {
-    FlushStateToDisk();
+private:
+    const size_t nLength;
+    const std::string& prefix;
+
+public:
+    AssetNameSeekKey(size_t nLengthIn, const std::string& prefixIn) : nLength(nLengthIn), prefix(prefixIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ::Serialize(s, ASSET_FLAG);
+        WriteCompactSize(s, nLength);
+        s.write(prefix.data(), prefix.size());
+    }
+};
 
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->Seek(std::make_pair(ASSET_FLAG, std::string()));
+//! Database order of asset names
+bool AssetNameLess(const std::string& a, const std::string& b)
+{
+    if (a.size() != b.size())
+        return a.size() < b.size();
+    return a < b;
+}
 
+bool AssetNameMatches(const std::string& name, const std::string& prefix, bool wildcard)
+{
+    return wildcard ? name.compare(0, prefix.size(), prefix) == 0 : name == prefix;
+}
+} // namespace
+
+bool CAssetsDB::ForEachAsset(const std::string& filter, const std::string& resumeAfter, const std::function<bool(const CDatabasedAssetData&)>& func)
+{
     auto prefix = filter;
-    bool wildcard = prefix.back() == '*';
-    if (wildcard)
+    bool wildcard = prefix.empty() || prefix.back() == '*';
+    if (!prefix.empty() && wildcard)
         prefix.pop_back();
 
-    size_t skip = 0;
-    if (start >= 0) {
-        skip = start;
-    }
-    else {
-        // compute table size for backwards offset
-        long table_size = 0;
-        while (pcursor->Valid()) {
-            boost::this_thread::interruption_point();
-
-            std::pair<char, std::string> key;
-            if (pcursor->GetKey(key) && key.first == ASSET_FLAG) {
-                if (prefix == "" ||
-                    (wildcard && key.second.find(prefix) == 0) ||
-                    (!wildcard && key.second == prefix)) {
-                    table_size += 1;
-                }
+    // Changes connected since the last flush are still in passets, overlay
+    // them instead of forcing a chainstate flush on every call.
+    std::map<std::string, CDatabasedAssetData, bool (*)(const std::string&, const std::string&)> mapAdded(&AssetNameLess);
+    std::set<std::string> setRemoved;
+    std::map<std::string, CNewAsset> mapReissued;
+    {
+        LOCK(cs_main);
+        if (passets) {
+            for (const auto& added : passets->setNewAssetsToAdd) {
+                const std::string& name = added.asset.strName;
+                if (AssetNameMatches(name, prefix, wildcard) && (resumeAfter.empty() || AssetNameLess(resumeAfter, name)))
+                    mapAdded.emplace(name, CDatabasedAssetData(added.asset, added.blockHeight, added.blockHash));
+            }
+            for (const auto& removed : passets->setNewAssetsToRemove)
+                setRemoved.insert(removed.asset.strName);
+            for (const auto& reissued : passets->mapReissuedAssetData) {
+                if (AssetNameMatches(reissued.first, prefix, wildcard))
+                    mapReissued.insert(reissued);
             }
-            pcursor->Next();
         }
-        skip = table_size + start;
-        pcursor->SeekToFirst();
     }
 
+    auto itAdded = mapAdded.begin();
+
+    // Hands one asset to func after applying the overlay. Returns false once func asks to stop.
+    auto emit = [&](CDatabasedAssetData& data) {
+        if (setRemoved.count(data.asset.strName))
+            return true;
+        auto itReissued = mapReissued.find(data.asset.strName);
+        if (itReissued != mapReissued.end())
+            data.asset = itReissued->second;
+        return func(data);
+    };
+
+    // Emits the overlay additions ordered before name (all of them if name is empty)
+    auto emitAddedBefore = [&](const std::string& name) {
+        while (itAdded != mapAdded.end() && (name.empty() || AssetNameLess(itAdded->first, name))) {
+            CDatabasedAssetData data = itAdded->second;
+            ++itAdded;
+            if (!emit(data))
+                return false;
+        }
+        return true;
+    };
 
-    size_t loaded = 0;
-    size_t offset = 0;
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
 
-    // Load assets
-    while (pcursor->Valid() && loaded < count) {
+    size_t nLength = std::max(prefix.size(), resumeAfter.size());
+    if (resumeAfter.empty())
+        pcursor->Seek(AssetNameSeekKey(nLength, prefix));
+    else
+        pcursor->Seek(std::make_pair(ASSET_FLAG, resumeAfter));
+
+    while (pcursor->Valid()) {
         boost::this_thread::interruption_point();
 
         std::pair<char, std::string> key;
-        if (pcursor->GetKey(key) && key.first == ASSET_FLAG) {
-            if (prefix == "" ||
-                    (wildcard && key.second.find(prefix) == 0) ||
-                    (!wildcard && key.second == prefix)) {
-                if (offset < skip) {
-                    offset += 1;
-                }
-                else {
-                    CDatabasedAssetData data;
-                    if (pcursor->GetValue(data)) {
-                        assets.push_back(data);
-                        loaded += 1;
-                    } else {
-                        return error("%s: failed to read asset", __func__);
-                    }
-                }
-            }
-            pcursor->Next();
-        } else {
+        if (!pcursor->GetKey(key) || key.first != ASSET_FLAG)
             break;
+
+        const std::string& name = key.second;
+        if (!resumeAfter.empty() && name == resumeAfter) {
+            pcursor->Next();
+            continue;
+        }
+
+        if (!AssetNameMatches(name, prefix, wildcard)) {
+            // An exact filter has a single candidate key
+            if (!wildcard)
+                break;
+            // Otherwise either seek forward to the prefix range of this name's
+            // length, or, if that range is behind us, to the next length.
+            if (name.size() > nLength)
+                nLength = name.size();
+            if (name.compare(0, prefix.size(), prefix) > 0)
+                nLength += 1;
+            pcursor->Seek(AssetNameSeekKey(nLength, prefix));
+            continue;
+        }
+
+        if (!emitAddedBefore(name))
+            return true;
+
+        CDatabasedAssetData data;
+        if (itAdded != mapAdded.end() && itAdded->first == name) {
+            // Re-added since the last flush: the overlay copy is current
+            data = itAdded->second;
+            ++itAdded;
+        } else if (!pcursor->GetValue(data)) {
+            return error("%s: failed to read asset", __func__);
         }
+        if (!emit(data))
+            return true;
+
+        pcursor->Next();
     }
 
+    emitAddedBefore(std::string());
     return true;
 }
 
+bool CAssetsDB::AssetDir(std::vector<CDatabasedAssetData>& assets, const std::string& filter, const size_t count, const std::string& cursor, std::string& nextCursor)
+{
+    nextCursor.clear();
+    if (count == 0)
+        return true;
+
+    std::string resumeAfter;
+    if (!cursor.empty()) {
+        if (!IsHex(cursor))
+            return error("%s: invalid cursor", __func__);
+        std::vector<unsigned char> vch = ParseHex(cursor);
+        resumeAfter.assign(vch.begin(), vch.end());
+    }
+
+    bool ret = ForEachAsset(filter, resumeAfter, [&assets, count](const CDatabasedAssetData& data) {
+        assets.push_back(data);
+        return assets.size() < count;
+    });
+
+    // A full page may have more behind it; the cursor is the last name returned
+    if (ret && assets.size() == count)
+        nextCursor = HexStr(assets.back().asset.strName);
+    return ret;
+}
+
+bool CAssetsDB::AssetDir(std::vector<CDatabasedAssetData>& assets, const std::string filter, const size_t count, const long start)
+{
+    size_t skip = 0;
+    if (start >= 0) {
+        skip = start;
+    }
+    else {
+        // compute table size for backwards offset
+        long table_size = 0;
+        if (!ForEachAsset(filter, std::string(), [&table_size](const CDatabasedAssetData&) { table_size += 1; return true; }))
+            return false;
+        skip = table_size + start > 0 ? table_size + start : 0;
+    }
+
+    if (count == 0)
+        return true;
+
+    size_t offset = 0;
+    size_t loaded = 0;
+    return ForEachAsset(filter, std::string(), [&](const CDatabasedAssetData& data) {
+        if (offset < skip) {
+            offset += 1;
+            return true;
+        }
+        assets.push_back(data);
+        loaded += 1;
+        return loaded < count;
+    });
+}
+
 bool CAssetsDB::AddressDir(std::vector<std::pair<std::string, CAmount> >& vecAssetAmount, int& totalEntries, const bool& fGetTotal, const std::string& address, const size_t count, const long start)
 {
     FlushStateToDisk();
@@ -351,26 +489,41 @@ bool CAssetsDB::AddressDir(std::vector<std::pair<std::string, CAmount> >& vecAss
     return true;
 }
 
-// Can get to total count of addresses that belong to a certain asset_name, or get you the list of all address that belong to a certain asset_name
-bool CAssetsDB::AssetAddressDir(std::vector<std::pair<std::string, CAmount> >& vecAddressAmount, int& totalEntries, const bool& fGetTotal, const std::string& assetName, const size_t count, const long start)
+bool CAssetsDB::ForEachAssetAddress(const std::string& assetName, const std::function<bool(const std::string&, const CAmount&)>& func)
 {
     FlushStateToDisk();
 
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->Seek(std::make_pair(ASSET_ADDRESS_QUANTITY_FLAG, std::make_pair(assetName, std::string())));
 
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+
+        std::pair<char, std::pair<std::string, std::string> > key;
+        if (!pcursor->GetKey(key) || key.first != ASSET_ADDRESS_QUANTITY_FLAG || key.second.first != assetName)
+            break;
+
+        CAmount amount;
+        if (!pcursor->GetValue(amount))
+            return error("%s: failed to read Asset Address Quantity", __func__);
+        if (!func(key.second.second, amount))
+            break;
+
+        pcursor->Next();
+    }
+
+    return true;
+}
+
+// Can get to total count of addresses that belong to a certain asset_name, or get you the list of all address that belong to a certain asset_name
+bool CAssetsDB::AssetAddressDir(std::vector<std::pair<std::string, CAmount> >& vecAddressAmount, int& totalEntries, const bool& fGetTotal, const std::string& assetName, const size_t count, const long start)
+{
     if (fGetTotal) {
         totalEntries = 0;
-        while (pcursor->Valid()) {
-            boost::this_thread::interruption_point();
-
-            std::pair<char, std::pair<std::string, std::string> > key;
-            if (pcursor->GetKey(key) && key.first == ASSET_ADDRESS_QUANTITY_FLAG && key.second.first == assetName) {
-                totalEntries += 1;
-            }
-            pcursor->Next();
-        }
-        return true;
+        return ForEachAssetAddress(assetName, [&totalEntries](const std::string&, const CAmount&) {
+            totalEntries += 1;
+            return true;
+        });
     }
 
     size_t skip = 0;
@@ -380,47 +533,25 @@ bool CAssetsDB::AssetAddressDir(std::vector<std::pair<std::string, CAmount> >& v
     else {
         // compute table size for backwards offset
         long table_size = 0;
-        while (pcursor->Valid()) {
-            boost::this_thread::interruption_point();
-
-            std::pair<char, std::pair<std::string, std::string> > key;
-            if (pcursor->GetKey(key) && key.first == ASSET_ADDRESS_QUANTITY_FLAG && key.second.first == assetName) {
-                table_size += 1;
-            }
-            pcursor->Next();
-        }
-        skip = table_size + start;
-        pcursor->SeekToFirst();
+        if (!ForEachAssetAddress(assetName, [&table_size](const std::string&, const CAmount&) { table_size += 1; return true; }))
+            return false;
+        skip = std::max(table_size + start, 0L);
     }
 
     size_t loaded = 0;
     size_t offset = 0;
 
-    // Load assets
-    while (pcursor->Valid() && loaded < count && loaded < MAX_DATABASE_RESULTS) {
-        boost::this_thread::interruption_point();
-
-        std::pair<char, std::pair<std::string, std::string> > key;
-        if (pcursor->GetKey(key) && key.first == ASSET_ADDRESS_QUANTITY_FLAG && key.second.first == assetName) {
-            if (offset < skip) {
-                offset += 1;
-            }
-            else {
-                CAmount amount;
-                if (pcursor->GetValue(amount)) {
-                    vecAddressAmount.emplace_back(std::make_pair(key.second.second, amount));
-                    loaded += 1;
-                } else {
-                    return error("%s: failed to Asset Address Quanity", __func__);
-                }
-            }
-            pcursor->Next();
-        } else {
-            break;
+    return ForEachAssetAddress(assetName, [&](const std::string& address, const CAmount& amount) {
+        if (loaded >= count || loaded >= MAX_DATABASE_RESULTS)
+            return false;
+        if (offset < skip) {
+            offset += 1;
+            return true;
         }
-    }
-
-    return true;
+        vecAddressAmount.emplace_back(address, amount);
+        loaded += 1;
+        return true;
+    });
 }
 
 bool CAssetsDB::AssetDir(std::vector<CDatabasedAssetData>& assets)
@@ -7,6 +7,7 @@
 #include "fs.h"
 #include "serialize.h"
 
+#include <functional>
 #include <string>
 #include <map>
 #include <dbwrapper.h>
@@ -101,9 +102,20 @@ public:
     bool LoadAssets();
     bool AssetDir(std::vector<CDatabasedAssetData>& assets, const std::string filter, const size_t count, const long start);
     bool AssetDir(std::vector<CDatabasedAssetData>& assets);
+    /** Page through assets matching filter. Pass an empty cursor for the first
+     *  page and the returned nextCursor for the following ones; nextCursor is
+     *  empty once the listing is exhausted. */
+    bool AssetDir(std::vector<CDatabasedAssetData>& assets, const std::string& filter, const size_t count, const std::string& cursor, std::string& nextCursor);
+    /** Visit assets matching filter (a name, or a prefix followed by '*') in
+     *  database order after resumeAfter, including changes not yet flushed from
+     *  passets. Only the key ranges that can match the filter are read. */
+    bool ForEachAsset(const std::string& filter, const std::string& resumeAfter, const std::function<bool(const CDatabasedAssetData&)>& func);
 
     bool AddressDir(std::vector<std::pair<std::string, CAmount> >& vecAssetAmount, int& totalEntries, const bool& fGetTotal, const std::string& address, const size_t count, const long start);
     bool AssetAddressDir(std::vector<std::pair<std::string, CAmount> >& vecAddressAmount, int& totalEntries, const bool& fGetTotal, const std::string& assetName, const size_t count, const long start);
+    /** Visit every (address, amount) holding of assetName in a single pass
+     *  over its key range, stopping early when func returns false. */
+    bool ForEachAssetAddress(const std::string& assetName, const std::function<bool(const std::string&, const CAmount&)>& func);
 };
 
 
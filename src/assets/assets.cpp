@@ -1,7 +1,8 @@
 // Copyright (c) 2017-2020 The Raven Core developers
 // Copyright (c) 2025-2026 The Soteria Core developers
 
-#include <regex>
+#include <array>
+#include <string_view>
 #include <script/script.h>
 #include <version.h>
 #include <streams.h>
@@ -45,191 +46,264 @@ std::map<std::string, uint256> mapReissuedAssets;
 static const auto MAX_NAME_LENGTH = 128; // default=31
 static const auto MAX_CHANNEL_NAME_LENGTH = 12;
 
-// min lengths are expressed by quantifiers
-static const std::regex ROOT_NAME_CHARACTERS("^([A-Z]|[A-Z][A-Z0-9-]{0,62}[A-Z0-9])$");
-static const std::regex SUB_NAME_CHARACTERS("^([A-Z0-9]|[A-Z0-9][A-Z0-9-]{0,61}[A-Z0-9])$");
-static const std::regex UNIQUE_TAG_CHARACTERS("^[-A-Za-z0-9@$%&*()[\\]{}_.?:]+$");
-static const std::regex MSG_CHANNEL_TAG_CHARACTERS("^[A-Za-z0-9_]+$");
-static const std::regex VOTE_TAG_CHARACTERS("^[A-Z0-9._]+$");
-
-// Restricted assets
-static const std::regex QUALIFIER_NAME_CHARACTERS("#[A-Z0-9._]{3,}$");
-static const std::regex SUB_QUALIFIER_NAME_CHARACTERS("#[A-Z0-9._]+$");
-static const std::regex RESTRICTED_NAME_CHARACTERS("\\$[A-Z0-9._]{3,}$");
-
-static const std::regex DOUBLE_PUNCTUATION("^.*[._]{2,}.*$");
-static const std::regex LEADING_PUNCTUATION("^[._].*$");
-static const std::regex TRAILING_PUNCTUATION("^.*[._]$");
-static const std::regex QUALIFIER_LEADING_PUNCTUATION("^[#\\$][._].*$"); // Used for qualifier assets, and restricted asset only
-
 static const std::string SUB_NAME_DELIMITER = "/";
 static const std::string UNIQUE_TAG_DELIMITER = "#";
 static const std::string MSG_CHANNEL_TAG_DELIMITER = "~";
 static const std::string VOTE_TAG_DELIMITER = "^";
 static const std::string RESTRICTED_TAG_DELIMITER = "$";
 
-static const std::regex UNIQUE_INDICATOR(R"(^[^^~#!]+#[^~#!\/]+$)");
-static const std::regex MSG_CHANNEL_INDICATOR(R"(^[^^~#!]+~[^~#!\/]+$)");
-static const std::regex OWNER_INDICATOR(R"(^[^^~#!]+!$)");
-static const std::regex VOTE_INDICATOR(R"(^[^^~#!]+\^[^~#!\/]+$)");
+// Character classes of the asset name grammar, looked up through a table indexed by byte
+static const uint8_t CHAR_UPPER = 1 << 0;       // A-Z
+static const uint8_t CHAR_LOWER = 1 << 1;       // a-z
+static const uint8_t CHAR_DIGIT = 1 << 2;       // 0-9
+static const uint8_t CHAR_DASH = 1 << 3;        // -
+static const uint8_t CHAR_DOT = 1 << 4;         // .
+static const uint8_t CHAR_UNDERSCORE = 1 << 5;  // _
+static const uint8_t CHAR_UNIQUE_EXTRA = 1 << 6; // @ $ % & * ( ) [ ] { } ? :
+
+static const uint8_t CHAR_PUNCTUATION = CHAR_DOT | CHAR_UNDERSCORE;
+static const uint8_t NAME_EDGE_CHARACTERS = CHAR_UPPER | CHAR_DIGIT;
+static const uint8_t NAME_CHARACTERS = NAME_EDGE_CHARACTERS | CHAR_DASH;
+static const uint8_t UNIQUE_TAG_CHARACTERS = CHAR_UPPER | CHAR_LOWER | CHAR_DIGIT | CHAR_DASH | CHAR_PUNCTUATION | CHAR_UNIQUE_EXTRA;
+static const uint8_t MSG_CHANNEL_TAG_CHARACTERS = CHAR_UPPER | CHAR_LOWER | CHAR_DIGIT | CHAR_UNDERSCORE;
+static const uint8_t QUALIFIER_CHARACTERS = CHAR_UPPER | CHAR_DIGIT | CHAR_PUNCTUATION; // Also vote tags and restricted names
+
+static const std::array<uint8_t, 256> ASSET_NAME_CHAR_CLASSES = [] {
+    std::array<uint8_t, 256> table{};
+    for (int c = 'A'; c <= 'Z'; c++) table[c] |= CHAR_UPPER;
+    for (int c = 'a'; c <= 'z'; c++) table[c] |= CHAR_LOWER;
+    for (int c = '0'; c <= '9'; c++) table[c] |= CHAR_DIGIT;
+    table['-'] |= CHAR_DASH;
+    table['.'] |= CHAR_DOT;
+    table['_'] |= CHAR_UNDERSCORE;
+    for (unsigned char c : std::string("@$%&*()[]{}?:")) table[c] |= CHAR_UNIQUE_EXTRA;
+    return table;
+}();
+
+static inline bool IsCharIn(char c, uint8_t classes)
+{
+    return ASSET_NAME_CHAR_CLASSES[static_cast<unsigned char>(c)] & classes;
+}
+
+//! True if every character of str in [begin, end) belongs to classes
+static bool AllCharsIn(std::string_view str, size_t begin, size_t end, uint8_t classes)
+{
+    for (size_t i = begin; i < end; i++) {
+        if (!IsCharIn(str[i], classes))
+            return false;
+    }
+    return true;
+}
+
+//! No leading or trailing '.' or '_', and never two of them in a row
+static bool IsPunctuationPlacementValid(std::string_view str, size_t begin)
+{
+    if (str.size() > begin && (IsCharIn(str[begin], CHAR_PUNCTUATION) || IsCharIn(str.back(), CHAR_PUNCTUATION)))
+        return false;
+    for (size_t i = begin + 1; i < str.size(); i++) {
+        if (IsCharIn(str[i], CHAR_PUNCTUATION) && IsCharIn(str[i - 1], CHAR_PUNCTUATION))
+            return false;
+    }
+    return true;
+}
+
+static bool IsReservedName(std::string_view name)
+{
+    return name == "RVN" || name == "SOTER" || name == "SOTERIA" || name == "#SOTER" || name == "#SOTERIA";
+}
 
-static const std::regex QUALIFIER_INDICATOR("^[#][A-Z0-9._]{3,}$"); // Starts with #
-static const std::regex SUB_QUALIFIER_INDICATOR("^#[A-Z0-9._]+\\/#[A-Z0-9._]+$"); // Starts with #
-static const std::regex RESTRICTED_INDICATOR("^[\\$][A-Z0-9._]{3,}$"); // Starts with $
+//! A-Z first, A-Z 0-9 last, A-Z 0-9 - in between
+static bool IsDnsLabel(std::string_view name, size_t maxLength, uint8_t firstClasses)
+{
+    return !name.empty() && name.size() <= maxLength
+        && IsCharIn(name.front(), firstClasses)
+        && IsCharIn(name.back(), NAME_EDGE_CHARACTERS)
+        && AllCharsIn(name, 1, name.size(), NAME_CHARACTERS);
+}
 
-static const std::regex SOTERIA_NAMES("^RVN$|^SOTER$|^SOTERIA$|^SOTERIA$|^#SOTER$|^#SOTERIA$|^#SOTERIA$");
+//! prefix + at least minLength characters that may appear in a qualifier
+static bool IsPrefixedQualifierName(std::string_view name, char prefix, size_t minLength)
+{
+    return name.size() >= minLength + 1 && name[0] == prefix && AllCharsIn(name, 1, name.size(), QUALIFIER_CHARACTERS);
+}
 
-bool IsRootNameValid(const std::string& name)
+bool IsRootNameValid(std::string_view name)
 {
-    return std::regex_match(name, ROOT_NAME_CHARACTERS)
-        && !std::regex_match(name, DOUBLE_PUNCTUATION)
-        && !std::regex_match(name, LEADING_PUNCTUATION)
-        && !std::regex_match(name, TRAILING_PUNCTUATION)
-        && !std::regex_match(name, SOTERIA_NAMES);
+    // Root names can't contain '.' or '_', so no punctuation placement check is needed
+    return IsDnsLabel(name, 64, CHAR_UPPER) && !IsReservedName(name);
 }
 
-bool IsQualifierNameValid(const std::string& name)
+bool IsQualifierNameValid(std::string_view name)
 {
-    return std::regex_match(name, QUALIFIER_NAME_CHARACTERS)
-           && !std::regex_match(name, DOUBLE_PUNCTUATION)
-           && !std::regex_match(name, QUALIFIER_LEADING_PUNCTUATION)
-           && !std::regex_match(name, TRAILING_PUNCTUATION)
-           && !std::regex_match(name, SOTERIA_NAMES);
+    return IsPrefixedQualifierName(name, '#', 3)
+           && IsPunctuationPlacementValid(name, 1)
+           && !IsReservedName(name);
 }
 
-bool IsRestrictedNameValid(const std::string& name)
+bool IsRestrictedNameValid(std::string_view name)
 {
-    return std::regex_match(name, RESTRICTED_NAME_CHARACTERS)
-           && !std::regex_match(name, DOUBLE_PUNCTUATION)
-           && !std::regex_match(name, LEADING_PUNCTUATION)
-           && !std::regex_match(name, TRAILING_PUNCTUATION)
-           && !std::regex_match(name, SOTERIA_NAMES);
+    // Leading punctuation is checked on the '$' itself, so a '.' or '_' right after it is accepted
+    return IsPrefixedQualifierName(name, '$', 3)
+           && IsPunctuationPlacementValid(name, 0)
+           && !IsReservedName(name);
 }
 
-bool IsSubQualifierNameValid(const std::string& name)
+bool IsSubQualifierNameValid(std::string_view name)
 {
-    return std::regex_match(name, SUB_QUALIFIER_NAME_CHARACTERS)
-           && !std::regex_match(name, DOUBLE_PUNCTUATION)
-           && !std::regex_match(name, LEADING_PUNCTUATION)
-           && !std::regex_match(name, TRAILING_PUNCTUATION);
+    return IsPrefixedQualifierName(name, '#', 1)
+           && IsPunctuationPlacementValid(name, 0);
 }
 
 // Helper function to check if a name is a valid uppercase Punycode
-bool IsValidUppercasePunycode(const std::string& name)
+bool IsValidUppercasePunycode(std::string_view name)
 {
     // Must start with "XN--" and have at least one character after the prefix
-    if (name.length() < 5 || name.substr(0, 4) != "XN--") {
+    if (name.length() < 5 || name.compare(0, 4, "XN--") != 0) {
         return false;
     }
 
-    // Check the part after "XN--" follows valid format
-    std::string afterPrefix = name.substr(4);
-    static const std::regex PUNYCODE_SUFFIX("^[A-Z0-9]+(-[A-Z0-9]+)*$");
-    return std::regex_match(afterPrefix, PUNYCODE_SUFFIX);
-}
-bool IsSubNameValid(const std::string& name)
-{
-    return std::regex_match(name, SUB_NAME_CHARACTERS)
-        && !std::regex_match(name, DOUBLE_PUNCTUATION)
-        && !std::regex_match(name, LEADING_PUNCTUATION)
-        && !std::regex_match(name, TRAILING_PUNCTUATION);
-        
-   // DNS RFC compliant validation - position restrictions are built into the regex
-    bool basicValid = std::regex_match(name, SUB_NAME_CHARACTERS);
-
-    if (!basicValid) {
+    // The part after "XN--" is runs of A-Z 0-9 separated by single hyphens
+    if (name[4] == '-' || name.back() == '-' || !AllCharsIn(name, 4, name.size(), NAME_CHARACTERS))
         return false;
-    }
+    return name.find("--", 4) == std::string_view::npos;
+}
 
-    // Special handling for Punycode: XN-- is allowed to have double hyphens
-    if (IsValidUppercasePunycode(name)) {
-        return true;
-    }
+bool IsSubNameValid(std::string_view name)
+{
+    // Sub names can't contain '.' or '_', so no punctuation placement check is needed
+    return IsDnsLabel(name, 63, NAME_EDGE_CHARACTERS);
+}
 
-    // For non-Punycode names, apply standard hyphen restrictions
-    return !std::regex_match(name, DOUBLE_PUNCTUATION)
-           && !std::regex_match(name, LEADING_PUNCTUATION)
-           && !std::regex_match(name, TRAILING_PUNCTUATION);        
+static bool IsUniqueTagValid(std::string_view tag)
+{
+    return !tag.empty() && AllCharsIn(tag, 0, tag.size(), UNIQUE_TAG_CHARACTERS);
 }
 
 bool IsUniqueTagValid(const std::string& tag)
 {
-    return std::regex_match(tag, UNIQUE_TAG_CHARACTERS);
+    return IsUniqueTagValid(std::string_view(tag));
 }
 
-bool IsVoteTagValid(const std::string& tag)
+bool IsVoteTagValid(std::string_view tag)
 {
-    return std::regex_match(tag, VOTE_TAG_CHARACTERS);
+    return !tag.empty() && AllCharsIn(tag, 0, tag.size(), QUALIFIER_CHARACTERS);
 }
 
-bool IsMsgChannelTagValid(const std::string &tag)
+bool IsMsgChannelTagValid(std::string_view tag)
 {
-    return std::regex_match(tag, MSG_CHANNEL_TAG_CHARACTERS)
-        && !std::regex_match(tag, DOUBLE_PUNCTUATION)
-        && !std::regex_match(tag, LEADING_PUNCTUATION)
-        && !std::regex_match(tag, TRAILING_PUNCTUATION);
+    return !tag.empty() && AllCharsIn(tag, 0, tag.size(), MSG_CHANNEL_TAG_CHARACTERS)
+        && IsPunctuationPlacementValid(tag, 0);
 }
 
-bool IsNameValidBeforeTag(const std::string& name)
+/**
+ * Positions of the tag delimiters in an asset name, gathered in a single pass.
+ * The Is*Indicator functions below decide from it which kind of name this is,
+ * with the same result as the indicator patterns:
+ *   unique       ^[^^~#!]+#[^~#!/]+$
+ *   msg channel  ^[^^~#!]+~[^~#!/]+$
+ *   owner        ^[^^~#!]+!$
+ *   vote         ^[^^~#!]+\^[^~#!/]+$
+ *   qualifier    ^#[A-Z0-9._]{3,}$
+ *   sub qualifier ^#[A-Z0-9._]+/#[A-Z0-9._]+$
+ *   restricted   ^\$[A-Z0-9._]{3,}$
+ */
+struct CAssetNameShape
 {
-    std::vector<std::string> parts;
-    boost::split(parts, name, boost::is_any_of(SUB_NAME_DELIMITER));
+    const std::string& name;
+    size_t nHash = 0, nTilde = 0, nBang = 0, nSlash = 0;
+    size_t nFirstHash = std::string::npos, nFirstTilde = std::string::npos, nFirstCaret = std::string::npos;
+    size_t nFirstSlash = std::string::npos, nLastSlash = std::string::npos;
 
-    if (!IsRootNameValid(parts.front())) return false;
-
-    if (parts.size() > 1)
+    explicit CAssetNameShape(const std::string& nameIn) : name(nameIn)
     {
-        for (unsigned long i = 1; i < parts.size(); i++)
-        {
-            if (!IsSubNameValid(parts[i])) return false;
+        for (size_t i = 0; i < name.size(); i++) {
+            switch (name[i]) {
+                case '#': if (nHash++ == 0) nFirstHash = i; break;
+                case '~': if (nTilde++ == 0) nFirstTilde = i; break;
+                case '!': nBang++; break;
+                case '^': if (nFirstCaret == std::string::npos) nFirstCaret = i; break;
+                case '/': if (nSlash++ == 0) nFirstSlash = i; nLastSlash = i; break;
+            }
         }
     }
 
-    return true;
-}
-
-bool IsQualifierNameValidBeforeTag(const std::string& name)
-{
-    std::vector<std::string> parts;
-    boost::split(parts, name, boost::is_any_of(SUB_NAME_DELIMITER));
+    //! prefix [^^~#!]+, the delimiter at pos, then [^~#!/]+ with no other '#', '~' or '!' in the name
+    bool IsTagged(size_t pos) const
+    {
+        return pos != std::string::npos && pos > 0 && pos + 1 < name.size()
+            && (nFirstCaret == std::string::npos || nFirstCaret >= pos)
+            && (nLastSlash == std::string::npos || nLastSlash < pos);
+    }
 
-    if (!IsQualifierNameValid(parts.front())) return false;
+    bool IsUniqueIndicator() const { return nHash == 1 && nTilde == 0 && nBang == 0 && IsTagged(nFirstHash); }
+    bool IsMsgChannelIndicator() const { return nTilde == 1 && nHash == 0 && nBang == 0 && IsTagged(nFirstTilde); }
+    bool IsVoteIndicator() const { return nHash == 0 && nTilde == 0 && nBang == 0 && IsTagged(nFirstCaret); }
 
-    // Qualifiers can only have one sub qualifier under it
-    if (parts.size() > 2) {
-        return false;
+    bool IsOwnerIndicator() const
+    {
+        return nBang == 1 && name.size() > 1 && name.back() == '!'
+            && nHash == 0 && nTilde == 0 && nFirstCaret == std::string::npos;
     }
 
-    if (parts.size() > 1)
+    bool IsQualifierIndicator() const { return IsPrefixedQualifierName(name, '#', 3); }
+    bool IsRestrictedIndicator() const { return IsPrefixedQualifierName(name, '$', 3); }
+
+    bool IsSubQualifierIndicator() const
     {
+        if (nSlash != 1 || nHash != 2 || name[0] != '#' || nFirstSlash + 2 >= name.size() || name[nFirstSlash + 1] != '#')
+            return false;
+        return nFirstSlash > 1 && AllCharsIn(name, 1, nFirstSlash, QUALIFIER_CHARACTERS)
+            && AllCharsIn(name, nFirstSlash + 2, name.size(), QUALIFIER_CHARACTERS);
+    }
+};
 
-        for (unsigned long i = 1; i < parts.size(); i++)
-        {
-            if (!IsSubQualifierNameValid(parts[i])) return false;
-        }
+//! The part of name before the first '/', and whether there is anything after it
+static std::string_view FirstNamePart(std::string_view name, bool& fHasMoreParts)
+{
+    size_t pos = name.find(SUB_NAME_DELIMITER[0]);
+    fHasMoreParts = pos != std::string_view::npos;
+    return name.substr(0, pos);
+}
+
+bool IsNameValidBeforeTag(std::string_view name)
+{
+    bool fHasMoreParts;
+    if (!IsRootNameValid(FirstNamePart(name, fHasMoreParts))) return false;
+
+    while (fHasMoreParts) {
+        name = name.substr(name.find(SUB_NAME_DELIMITER[0]) + 1);
+        if (!IsSubNameValid(FirstNamePart(name, fHasMoreParts))) return false;
     }
 
     return true;
 }
 
-bool IsAssetNameASubasset(const std::string& name)
+bool IsQualifierNameValidBeforeTag(std::string_view name)
 {
-    std::vector<std::string> parts;
-    boost::split(parts, name, boost::is_any_of(SUB_NAME_DELIMITER));
+    bool fHasMoreParts;
+    if (!IsQualifierNameValid(FirstNamePart(name, fHasMoreParts))) return false;
 
-    if (!IsRootNameValid(parts.front())) return false;
+    if (fHasMoreParts) {
+        name = name.substr(name.find(SUB_NAME_DELIMITER[0]) + 1);
+        if (!IsSubQualifierNameValid(FirstNamePart(name, fHasMoreParts))) return false;
 
-    return parts.size() > 1;
+        // Qualifiers can only have one sub qualifier under it
+        if (fHasMoreParts) return false;
+    }
+
+    return true;
 }
 
-bool IsAssetNameASubQualifier(const std::string& name)
+bool IsAssetNameASubasset(const std::string& name)
 {
-    std::vector<std::string> parts;
-    boost::split(parts, name, boost::is_any_of(SUB_NAME_DELIMITER));
-
-    if (!IsQualifierNameValid(parts.front())) return false;
+    bool fHasMoreParts;
+    return IsRootNameValid(FirstNamePart(name, fHasMoreParts)) && fHasMoreParts;
+}
 
-    return parts.size() > 1;
+bool IsAssetNameASubQualifier(const std::string& name)
+{
+    bool fHasMoreParts;
+    return IsQualifierNameValid(FirstNamePart(name, fHasMoreParts)) && fHasMoreParts;
 }
 
 
@@ -241,7 +315,8 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
         return false;
 
     assetType = AssetType::INVALID;
-    if (std::regex_match(name, UNIQUE_INDICATOR))
+    CAssetNameShape shape(name);
+    if (shape.IsUniqueIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::UNIQUE, name, error);
         if (ret)
@@ -249,7 +324,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, MSG_CHANNEL_INDICATOR))
+    else if (shape.IsMsgChannelIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::MSGCHANNEL, name, error);
         if (ret)
@@ -257,7 +332,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, OWNER_INDICATOR))
+    else if (shape.IsOwnerIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::OWNER, name, error);
         if (ret)
@@ -265,7 +340,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, VOTE_INDICATOR))
+    else if (shape.IsVoteIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::VOTE, name, error);
         if (ret)
@@ -273,7 +348,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, QUALIFIER_INDICATOR))
+    else if (shape.IsQualifierIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::QUALIFIER, name, error);
         if (ret) {
@@ -285,7 +360,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, SUB_QUALIFIER_INDICATOR))
+    else if (shape.IsSubQualifierIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::SUB_QUALIFIER, name, error);
         if (ret) {
@@ -295,7 +370,7 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 
         return ret;
     }
-    else if (std::regex_match(name, RESTRICTED_INDICATOR))
+    else if (shape.IsRestrictedIndicator())
     {
         bool ret = IsTypeCheckNameValid(AssetType::RESTRICTED, name, error);
         if (ret)
@@ -335,26 +410,35 @@ bool IsAssetNameARoot(const std::string& name)
 
 bool IsAssetNameAnOwner(const std::string& name)
 {
-    return IsAssetNameValid(name) && std::regex_match(name, OWNER_INDICATOR);
+    return IsAssetNameValid(name) && CAssetNameShape(name).IsOwnerIndicator();
 }
 
 bool IsAssetNameAnRestricted(const std::string& name)
 {
-    return IsAssetNameValid(name) && std::regex_match(name, RESTRICTED_INDICATOR);
+    return IsAssetNameValid(name) && CAssetNameShape(name).IsRestrictedIndicator();
 }
 
 bool IsAssetNameAQualifier(const std::string& name, bool fOnlyQualifiers)
 {
     if (fOnlyQualifiers) {
-        return IsAssetNameValid(name) && std::regex_match(name, QUALIFIER_INDICATOR);
+        return IsAssetNameValid(name) && CAssetNameShape(name).IsQualifierIndicator();
     }
 
-    return IsAssetNameValid(name) && (std::regex_match(name, QUALIFIER_INDICATOR) || std::regex_match(name, SUB_QUALIFIER_INDICATOR));
+    CAssetNameShape shape(name);
+    return IsAssetNameValid(name) && (shape.IsQualifierIndicator() || shape.IsSubQualifierIndicator());
 }
 
 bool IsAssetNameAnMsgChannel(const std::string& name)
 {
-    return IsAssetNameValid(name) && std::regex_match(name, MSG_CHANNEL_INDICATOR);
+    return IsAssetNameValid(name) && CAssetNameShape(name).IsMsgChannelIndicator();
+}
+
+//! The name before the first tag delimiter and the tag after the last one (both the whole name if there is none)
+static void SplitAtTag(std::string_view name, char delimiter, std::string_view& front, std::string_view& back)
+{
+    front = name.substr(0, name.find(delimiter));
+    size_t last = name.rfind(delimiter);
+    back = last == std::string_view::npos ? name : name.substr(last + 1);
 }
 
 // TODO get the string translated below
@@ -362,29 +446,29 @@ bool IsTypeCheckNameValid(const AssetType type, const std::string& name, std::st
 {
     if (type == AssetType::UNIQUE) {
         if (name.size() > MAX_NAME_LENGTH) { error = "Name is greater than max length of " + std::to_string(MAX_NAME_LENGTH); return false; }
-        std::vector<std::string> parts;
-        boost::split(parts, name, boost::is_any_of(UNIQUE_TAG_DELIMITER));
-        bool valid = IsNameValidBeforeTag(parts.front()) && IsUniqueTagValid(parts.back());
+        std::string_view front, back;
+        SplitAtTag(name, UNIQUE_TAG_DELIMITER[0], front, back);
+        bool valid = IsNameValidBeforeTag(front) && IsUniqueTagValid(back);
         if (!valid) { error = "Unique name contains invalid characters (Valid characters are: A-Z a-z 0-9 @ $ % & * ( ) [ ] { } _ . ? : -)";  return false; }
         return true;
     } else if (type == AssetType::MSGCHANNEL) {
         if (name.size() > MAX_NAME_LENGTH) { error = "Name is greater than max length of " + std::to_string(MAX_NAME_LENGTH); return false; }
-        std::vector<std::string> parts;
-        boost::split(parts, name, boost::is_any_of(MSG_CHANNEL_TAG_DELIMITER));
-        bool valid = IsNameValidBeforeTag(parts.front()) && IsMsgChannelTagValid(parts.back());
-        if (parts.back().size() > MAX_CHANNEL_NAME_LENGTH) { error = "Channel name is greater than max length of " + std::to_string(MAX_CHANNEL_NAME_LENGTH); return false; }
+        std::string_view front, back;
+        SplitAtTag(name, MSG_CHANNEL_TAG_DELIMITER[0], front, back);
+        bool valid = IsNameValidBeforeTag(front) && IsMsgChannelTagValid(back);
+        if (back.size() > MAX_CHANNEL_NAME_LENGTH) { error = "Channel name is greater than max length of " + std::to_string(MAX_CHANNEL_NAME_LENGTH); return false; }
         if (!valid) { error = "Message Channel name contains invalid characters (Valid characters are: A-Z 0-9 _ .) (special characters can't be the first or last characters)";  return false; }
         return true;
     } else if (type == AssetType::OWNER) {
         if (name.size() > MAX_NAME_LENGTH) { error = "Name is greater than max length of " + std::to_string(MAX_NAME_LENGTH); return false; }
-        bool valid = IsNameValidBeforeTag(name.substr(0, name.size() - 1));
+        bool valid = IsNameValidBeforeTag(std::string_view(name).substr(0, name.size() - 1));
         if (!valid) { error = "Owner name contains invalid characters (Valid characters are: A-Z 0-9 _ .) (special characters can't be the first or last characters)";  return false; }
         return true;
     } else if (type == AssetType::VOTE) {
         if (name.size() > MAX_NAME_LENGTH) { error = "Name is greater than max length of " + std::to_string(MAX_NAME_LENGTH); return false; }
-        std::vector<std::string> parts;
-        boost::split(parts, name, boost::is_any_of(VOTE_TAG_DELIMITER));
-        bool valid = IsNameValidBeforeTag(parts.front()) && IsVoteTagValid(parts.back());
+        std::string_view front, back;
+        SplitAtTag(name, VOTE_TAG_DELIMITER[0], front, back);
+        bool valid = IsNameValidBeforeTag(front) && IsVoteTagValid(back);
         if (!valid) { error = "Vote name contains invalid characters (Valid characters are: A-Z 0-9 _ .) (special characters can't be the first or last characters)";  return false; }
         return true;
     } else if (type == AssetType::QUALIFIER || type == AssetType::SUB_QUALIFIER) {
@@ -3754,7 +3838,7 @@ bool GetMyAssetBalance(const std::string& name, CAmount& balance, const int& con
 
     // Get the map of assetnames to outputs
     std::map<std::string, std::vector<COutput> > outputs;
-    vpwallets[0]->AvailableAssets(outputs, true, nullptr, 1, MAX_MONEY, MAX_MONEY, 0, confirmations);
+    vpwallets[0]->AvailableAssets(std::set<std::string>{name}, outputs, true, nullptr, 1, MAX_MONEY, MAX_MONEY, 0, confirmations);
 
     // Loop through all pairs of Asset Name -> vector<COutput>
     if (outputs.count(name)) {
@@ -4324,7 +4408,7 @@ bool VerifyWalletHasAsset(const std::string& asset_name, std::pair<int, std::str
 
     std::vector<COutput> vCoins;
     std::map<std::string, std::vector<COutput> > mapAssetCoins;
-    pwallet->AvailableAssets(mapAssetCoins);
+    pwallet->AvailableAssets(std::set<std::string>{asset_name}, mapAssetCoins);
 
     if (mapAssetCoins.count(asset_name))
         return true;
@@ -4794,15 +4878,18 @@ bool CAssetsCache::CheckForGlobalRestriction(const std::string &restricted_name,
 
 void ExtractVerifierStringQualifiers(const std::string& verifier, std::set<std::string>& qualifiers)
 {
-    std::string s(verifier);
-
-    std::regex regexSearch = std::regex(R"([A-Z0-9_.]+)");
-    std::smatch match;
-
-    while (std::regex_search(s,match,regexSearch)) {
-        for (auto str : match)
-            qualifiers.insert(str);
-        s = match.suffix().str();
+    // Every maximal run of [A-Z0-9_.] is a qualifier
+    size_t start = 0;
+    while (start < verifier.size()) {
+        if (!IsCharIn(verifier[start], QUALIFIER_CHARACTERS)) {
+            start++;
+            continue;
+        }
+        size_t end = start;
+        while (end < verifier.size() && IsCharIn(verifier[end], QUALIFIER_CHARACTERS))
+            end++;
+        qualifiers.insert(verifier.substr(start, end - start));
+        start = end;
     }
 }
 
@@ -5084,6 +5171,46 @@ bool ContextualCheckVerifierAssetTxOut(const CTxOut& txout, CAssetsCache* assetC
     return true;
 }
 
+/** A verifier string that passed CheckVerifierString, with its qualifiers and compiled formula */
+struct CCompiledVerifierString
+{
+    //! Qualifier names without the leading '#', in the order CheckVerifierString found them. Qualifier i is bit i of the valuation.
+    std::vector<std::string> vecQualifiers;
+    LibBoolEE::Program program;
+    //! False if the formula exceeds the compiler limits, in which case it is resolved from the string
+    bool fCompiled = false;
+};
+
+static CCriticalSection cs_compiledVerifiers;
+static CLRUCache<std::string, std::shared_ptr<const CCompiledVerifierString>> compiledVerifiers(MAX_CACHE_ASSETS_SIZE);
+
+/** Run the non contextual checks on a verifier string once and cache the result. Only verifier strings that pass are cached. */
+static std::shared_ptr<const CCompiledVerifierString> GetCompiledVerifierString(const std::string& verifier, std::string& strError, ErrorReport* errorReport)
+{
+    {
+        LOCK(cs_compiledVerifiers);
+        if (compiledVerifiers.Exists(verifier))
+            return compiledVerifiers.Get(verifier);
+    }
+
+    std::set<std::string> setFoundQualifiers;
+    if (!CheckVerifierString(verifier, setFoundQualifiers, strError, errorReport))
+        return nullptr;
+
+    auto compiled = std::make_shared<CCompiledVerifierString>();
+    compiled->vecQualifiers.assign(setFoundQualifiers.begin(), setFoundQualifiers.end());
+    try {
+        compiled->program = LibBoolEE::compile(verifier, compiled->vecQualifiers);
+        compiled->fCompiled = true;
+    } catch (const std::runtime_error&) {
+        // Over the compiler limits, fall back to resolving the string
+    }
+
+    LOCK(cs_compiledVerifiers);
+    compiledVerifiers.Put(verifier, compiled);
+    return compiled;
+}
+
 bool ContextualCheckVerifierString(CAssetsCache* cache, const std::string& verifier, const std::string& check_address, std::string& strError, ErrorReport* errorReport)
 {
     // If verifier is set to true, return true
@@ -5091,12 +5218,12 @@ bool ContextualCheckVerifierString(CAssetsCache* cache, const std::string& verif
         return true;
 
     // Check against the non contextual changes first
-    std::set<std::string> setFoundQualifiers;
-    if (!CheckVerifierString(verifier, setFoundQualifiers, strError, errorReport))
+    std::shared_ptr<const CCompiledVerifierString> compiled = GetCompiledVerifierString(verifier, strError, errorReport);
+    if (!compiled)
         return false;
 
     // Loop through each qualifier and make sure that the asset exists
-    for(auto qualifier : setFoundQualifiers) {
+    for(auto qualifier : compiled->vecQualifiers) {
         std::string search = QUALIFIER_CHAR + qualifier;
         if (!cache->CheckIfAssetExists(search, true)) {
             if (errorReport) {
@@ -5116,20 +5243,26 @@ bool ContextualCheckVerifierString(CAssetsCache* cache, const std::string& verif
 
     // Create an object that stores if an address contains a qualifier
     LibBoolEE::Vals vals;
+    uint64_t nQualifierBits = 0;
 
     // Add the qualifiers into the vals object
-    for (auto qualifier : setFoundQualifiers) {
-        std::string search = QUALIFIER_CHAR + qualifier;
+    for (size_t i = 0; i < compiled->vecQualifiers.size(); i++) {
+        std::string search = QUALIFIER_CHAR + compiled->vecQualifiers[i];
 
         // Check to see if the address contains the qualifier
         bool has_qualifier = cache->CheckForAddressQualifier(search, check_address, true);
 
         // Add the true or false value into the vals
-        vals.insert(std::make_pair(qualifier, has_qualifier));
+        if (compiled->fCompiled) {
+            if (has_qualifier)
+                nQualifierBits |= uint64_t(1) << i;
+        } else {
+            vals.insert(std::make_pair(compiled->vecQualifiers[i], has_qualifier));
+        }
     }
 
     try {
-        bool ret = LibBoolEE::resolve(verifier, vals, errorReport);
+        bool ret = compiled->fCompiled ? compiled->program.evaluate(nQualifierBits) : LibBoolEE::resolve(verifier, vals, errorReport);
         if (!ret) {
             if (errorReport) {
                 if (errorReport->type == ErrorReport::ErrorType::NotSetError) {
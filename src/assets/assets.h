@@ -10,6 +10,7 @@
 #include "assettypes.h"
 
 #include <string>
+#include <string_view>
 #include <set>
 #include <map>
 #include <unordered_map>
@@ -407,6 +408,16 @@ bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string
 //! Check if an unique tagname is valid
 bool IsUniqueTagValid(const std::string& tag);
 
+//! Checks of the single parts of an asset name that IsAssetNameValid is built from
+bool IsRootNameValid(std::string_view name);
+bool IsSubNameValid(std::string_view name);
+bool IsQualifierNameValid(std::string_view name);
+bool IsSubQualifierNameValid(std::string_view name);
+bool IsRestrictedNameValid(std::string_view name);
+bool IsVoteTagValid(std::string_view tag);
+bool IsMsgChannelTagValid(std::string_view tag);
+bool IsValidUppercasePunycode(std::string_view name);
+
 //! Check if an asset is an owner
 bool IsAssetNameAnOwner(const std::string& name);
 
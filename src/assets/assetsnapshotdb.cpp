@@ -7,6 +7,8 @@
 #include "validation.h"
 #include "base58.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/thread.hpp>
 
@@ -19,16 +21,15 @@ CAssetSnapshotDBEntry::CAssetSnapshotDBEntry()
 
 CAssetSnapshotDBEntry::CAssetSnapshotDBEntry(
     const std::string & p_assetName, int p_snapshotHeight,
-    const std::set<std::pair<std::string, CAmount>> & p_ownersAndAmounts
+    std::vector<std::pair<std::string, CAmount>> && p_ownersAndAmounts
 )
 {
     SetNull();
 
     height = p_snapshotHeight;
     assetName = p_assetName;
-    for (auto const & currPair : p_ownersAndAmounts) {
-        ownersAndAmounts.insert(currPair);
-    }
+    ownersAndAmounts = std::move(p_ownersAndAmounts);
+    std::sort(ownersAndAmounts.begin(), ownersAndAmounts.end());
 
     heightAndName = std::to_string(height) + assetName;
 }
@@ -48,50 +49,22 @@ bool CAssetSnapshotDB::AddAssetOwnershipSnapshot(
         return false;
     }
 
-    std::set<std::pair<std::string, CAmount>> ownersAndAmounts;
-    std::vector<std::pair<std::string, CAmount>> tempOwnersAndAmounts;
-    int totalEntryCount;
-
-    if (!passetsdb->AssetAddressDir(tempOwnersAndAmounts, totalEntryCount, true, p_assetName, INT_MAX, 0)) {
-        LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Failed to retrieve assets directory for '%s'\n", p_assetName.c_str());
-        return false;
-    }
-
-    //  Retrieve all of the addresses/amounts in batches
-    const int MAX_RETRIEVAL_COUNT = 100;
-    bool errorsOccurred = false;
-
-    for (int retrievalOffset = 0; retrievalOffset < totalEntryCount; retrievalOffset += MAX_RETRIEVAL_COUNT) {
-        //  Retrieve the specified segment of addresses
-        if (!passetsdb->AssetAddressDir(tempOwnersAndAmounts, totalEntryCount, false, p_assetName, MAX_RETRIEVAL_COUNT, retrievalOffset)) {
-            LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Failed to retrieve assets directory for '%s'\n", p_assetName.c_str());
-            errorsOccurred = true;
-            break;
-        }
-
-        //  Verify that some addresses were returned
-        if (tempOwnersAndAmounts.size() == 0) {
-            LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: No addresses were retrieved.\n");
-            continue;
-        }
-
-        //  Move these into the main set
-        for (auto const & currPair : tempOwnersAndAmounts) {
+    //  Stream the address/amount range for the asset in a single pass
+    std::vector<std::pair<std::string, CAmount>> ownersAndAmounts;
+    bool succeeded = passetsdb->ForEachAssetAddress(p_assetName,
+        [&ownersAndAmounts](const std::string & p_address, const CAmount & p_amount) {
             //  Verify that the address is valid
-            CTxDestination dest = DecodeDestination(currPair.first);
-            if (IsValidDestination(dest)) {
-                ownersAndAmounts.insert(currPair);
+            if (IsValidDestination(DecodeDestination(p_address))) {
+                ownersAndAmounts.emplace_back(p_address, p_amount);
             }
             else {
-                LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Address '%s' is invalid.\n", currPair.first.c_str());
+                LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Address '%s' is invalid.\n", p_address.c_str());
             }
-        }
+            return true;
+        });
 
-        tempOwnersAndAmounts.clear();
-    }
-
-    if (errorsOccurred) {
-        LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Errors occurred while acquiring ownership info for asset '%s'.\n", p_assetName.c_str());
+    if (!succeeded) {
+        LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Failed to retrieve assets directory for '%s'\n", p_assetName.c_str());
         return false;
     }
     if (ownersAndAmounts.size() == 0) {
@@ -100,11 +73,11 @@ bool CAssetSnapshotDB::AddAssetOwnershipSnapshot(
     }
 
     //  Write the snapshot to the database. We don't care if we overwrite, because it should be identical.
-    CAssetSnapshotDBEntry snapshotEntry(p_assetName, p_height, ownersAndAmounts);
+    CAssetSnapshotDBEntry snapshotEntry(p_assetName, p_height, std::move(ownersAndAmounts));
 
     if (Write(std::make_pair(SNAPSHOTCHECK_FLAG, snapshotEntry.heightAndName), snapshotEntry)) {
         LogPrint(BCLog::REWARDS, "AddAssetOwnershipSnapshot: Successfully added snapshot for '%s' at height %d (ownerCount = %d).\n",
-            p_assetName.c_str(), p_height, ownersAndAmounts.size());
+            p_assetName.c_str(), p_height, snapshotEntry.ownersAndAmounts.size());
         return true;
     }
     return false;
@@ -6,7 +6,7 @@
 #ifndef ASSETSNAPSHOTDB_H
 #define ASSETSNAPSHOTDB_H
 
-#include <set>
+#include <vector>
 #include <dbwrapper.h>
 #include "amount.h"
 
@@ -15,7 +15,9 @@ class CAssetSnapshotDBEntry
 public:
     int height;
     std::string assetName;
-    std::set<std::pair<std::string, CAmount>> ownersAndAmounts;
+    //  Sorted by address. Serializes exactly like the std::set it replaced,
+    //      so snapshots written by older versions still load.
+    std::vector<std::pair<std::string, CAmount>> ownersAndAmounts;
 
     //  Used as the DB key for the snapshot
     std::string heightAndName;
@@ -23,7 +25,7 @@ public:
     CAssetSnapshotDBEntry();
     CAssetSnapshotDBEntry(
         const std::string & p_assetName, const int p_snapshotHeight,
-        const std::set<std::pair<std::string, CAmount>> & p_ownersAndAmounts
+        std::vector<std::pair<std::string, CAmount>> && p_ownersAndAmounts
     );
 
     void SetNull()
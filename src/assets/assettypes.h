@@ -9,6 +9,7 @@
 #include <string>
 #include <sstream>
 #include <list>
+#include <set>
 #include <unordered_map>
 #include "amount.h"
 #include "script/standard.h"
@@ -547,6 +548,29 @@ struct CAssetCacheRestrictedVerifiers
     }
 };
 
+/**
+ * What ConnectBlock() did to assets in one block, as it left it in the block's
+ * CAssetsCache. Passed to BlockAssetsConnected() listeners.
+ */
+struct CBlockAssetActivity
+{
+    std::set<CAssetCacheNewAsset> setNewAssets;
+    std::set<CAssetCacheNewOwner> setNewOwnerAssets;
+    std::set<CAssetCacheReissueAsset> setReissues;
+    std::set<CAssetCacheNewTransfer> setTransfers;
+    std::set<CAssetCacheQualifierAddress> setQualifierAddresses;
+    std::set<CAssetCacheRestrictedAddress> setRestrictedAddresses;
+    std::set<CAssetCacheRestrictedGlobal> setRestrictedGlobals;
+    std::set<CAssetCacheRestrictedVerifiers> setRestrictedVerifiers;
+
+    bool IsEmpty() const
+    {
+        return setNewAssets.empty() && setNewOwnerAssets.empty() && setReissues.empty() && setTransfers.empty() &&
+               setQualifierAddresses.empty() && setRestrictedAddresses.empty() && setRestrictedGlobals.empty() &&
+               setRestrictedVerifiers.empty();
+    }
+};
+
 // Least Recently Used Cache
 template<typename cache_key_t, typename cache_value_t>
 class CLRUCache
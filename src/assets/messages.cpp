@@ -11,6 +11,10 @@
 #include "messages.h"
 #include "myassetsdb.h"
 #include <primitives/block.h>
+#include <ui_interface.h>
+
+#include <atomic>
+#include <thread>
 
 
 std::set<COutPoint> setDirtyMessagesRemove;
@@ -188,83 +192,185 @@ void OrphanMessage(const CMessage& message)
 }
 
 #ifdef ENABLE_WALLET
-bool ScanForMessageChannels(std::string& strError)
+static const int MAX_MESSAGE_SCAN_THREADS = 8;
+
+//! Read a block and collect its asset outputs that are ours. Safe to call from several threads.
+static bool ParseBlockForMessageChannels(CWallet* pwallet, const uint256& hash, const CDiskBlockPos& pos, std::vector<CMessageChannelScanEntry>& vEntries)
+{
+    CBlock block;
+    if (!ReadBlockFromDisk(block, pos, Params().GetConsensus()) || block.GetHash() != hash)
+        return false;
+
+    for (const auto& tx : block.vtx) {
+        for (const auto& out : tx->vout) {
+            int nType = -1;
+            bool fOwner = false;
+            if (!out.scriptPubKey.IsAssetScript(nType, fOwner) || pwallet->IsMine(out) != ISMINE_SPENDABLE)
+                continue;
+
+            // Get the asset data from the script
+            CAssetOutputEntry assetData;
+            if (!GetAssetData(out.scriptPubKey, assetData)) {
+                LogPrintf("%s : Failed to get GetAssetData call\n", __func__);
+                continue;
+            }
+            vEntries.push_back({assetData.assetName, assetData.type, fOwner, EncodeDestination(assetData.destination)});
+        }
+    }
+    return true;
+}
+
+//! Subscribe to a channel found by the scan, returning whether it wasn't subscribed to already
+static bool AddScannedChannel(const std::string& name)
 {
-    LOCK2(cs_messaging, cs_main);
+    bool fNew = !IsChannelSubscribed(name);
+    AddChannel(name);
+    return fNew;
+}
 
-    LogPrintf("%s : Start Scanning For Message Channels\n", __func__);
+size_t ApplyMessageChannelScanEntry(const CMessageChannelScanEntry& entry)
+{
+    AssertLockHeld(cs_messaging);
+
+    size_t nAdded = 0;
+
+    AssetType type;
+    IsAssetNameValid(entry.assetName, type);
+
+    if (entry.nAssetTxType == TX_TRANSFER_ASSET) {
+        if (type == AssetType::MSGCHANNEL || type == AssetType::OWNER) { // Subscribe to any channels or owner tokens you own
+            nAdded += AddScannedChannel(entry.assetName);
+            AddAddressSeen(entry.address);
+        } else if (type == AssetType::ROOT || type == AssetType::SUB) { // Subscribe to any assets you are sent, if they are sent to a new address
+            if (!IsChannelSubscribed(entry.assetName + OWNER_TAG)) {
+                if (!IsAddressSeen(entry.address)) {
+                    nAdded += AddScannedChannel(entry.assetName + OWNER_TAG);
+                    AddAddressSeen(entry.address);
+                }
+            }
+        }
+    } else if (entry.nAssetTxType == TX_NEW_ASSET || entry.nAssetTxType == TX_REISSUE_ASSET) {
+        if (entry.fOwner || type == AssetType::MSGCHANNEL) {
+            nAdded += AddScannedChannel(entry.assetName);
+            AddAddressSeen(entry.address);
+        } else if (type == AssetType::ROOT || type == AssetType::SUB || type == AssetType::RESTRICTED) {
+            nAdded += AddScannedChannel(entry.assetName + "!");
+            AddAddressSeen(entry.address);
+        }
+    }
+    return nAdded;
+}
 
+bool ScanForMessageChannels(std::string& strError, size_t nBatchSize, size_t nMaxBatches, size_t* pnFound)
+{
     if (vpwallets.size() == 0) {
         strError = "Wallet isn't active on this client. Can't scan for MsgChannels";
         return false;
     }
+    CWallet* pwallet = vpwallets[0];
+
+    // Resume after the last block whose channels were written out
+    const CBlockIndex* pindexLast = nullptr;
+    const CBlockIndex* pindexStart = nullptr;
+    {
+        LOCK(cs_main);
+        CBlockLocator locator;
+        if (pmessagechanneldb->ReadScanProgress(locator) && !locator.IsNull())
+            pindexLast = FindForkInGlobalIndex(chainActive, locator);
+        pindexStart = pindexLast ? chainActive.Next(pindexLast) : chainActive[Params().GetAssetActivationHeight()];
+    }
 
-    CBlockIndex* blockIndex = chainActive[Params().GetAssetActivationHeight()];
+    LogPrintf("%s : Start Scanning For Message Channels from height %d\n", __func__, pindexStart ? pindexStart->nHeight : -1);
+
+    const int nThreads = std::max(1, std::min(GetNumCores(), MAX_MESSAGE_SCAN_THREADS));
+    size_t nFound = 0;
+    for (size_t nBatches = 0; nMaxBatches == 0 || nBatches < nMaxBatches; nBatches++) {
+        boost::this_thread::interruption_point();
+
+        // Only hold cs_main to copy out where the next batch of blocks is stored
+        std::vector<std::pair<uint256, CDiskBlockPos>> vBlocks;
+        CBlockLocator locator;
+        int nTipHeight;
+        {
+            LOCK(cs_main);
+            const CBlockIndex* pindex = pindexStart;
+            if (pindexLast) {
+                // The chain may have been reorganized since the previous batch
+                const CBlockIndex* pindexFork = chainActive.FindFork(pindexLast);
+                pindex = pindexFork ? chainActive.Next(pindexFork) : pindexStart;
+            }
+            for (; pindex && vBlocks.size() < nBatchSize; pindex = chainActive.Next(pindex)) {
+                if (!(pindex->nStatus & BLOCK_HAVE_DATA)) {
+                    strError = "Block not found on disk";
+                    return false;
+                }
+                vBlocks.emplace_back(pindex->GetBlockHash(), pindex->GetBlockPos());
+                pindexLast = pindex;
+            }
+            if (vBlocks.empty())
+                break;
+            locator = chainActive.GetLocator(pindexLast);
+            nTipHeight = chainActive.Height();
+        }
 
-    while (blockIndex) {
-        CBlock block;
-        if (!ReadBlockFromDisk(block, blockIndex, Params().GetConsensus())) {
+        // Read and parse the batch in parallel
+        std::vector<std::vector<CMessageChannelScanEntry>> vResults(vBlocks.size());
+        std::atomic<size_t> nNext(0);
+        std::atomic<bool> fFailed(false);
+        auto worker = [&]() {
+            for (size_t i = nNext++; i < vBlocks.size() && !fFailed; i = nNext++) {
+                if (!ParseBlockForMessageChannels(pwallet, vBlocks[i].first, vBlocks[i].second, vResults[i]))
+                    fFailed = true;
+            }
+        };
+        std::vector<std::thread> vWorkers;
+        for (int i = 1; i < nThreads; i++)
+            vWorkers.emplace_back(worker);
+        worker();
+        for (auto& thread : vWorkers)
+            thread.join();
+
+        if (fFailed) {
             strError = "Block not found on disk";
             return false;
         }
 
-        for (const auto& tx : block.vtx) {
-
-            auto ptx = tx.get();
-            if (!ptx) {
-                strError = "Failed to get transaction pointer";
-                return false;
+        // Apply in chain order, then persist the channels together with the point to resume from
+        {
+            LOCK(cs_messaging);
+            for (const auto& vEntries : vResults) {
+                for (const auto& entry : vEntries)
+                    nFound += ApplyMessageChannelScanEntry(entry);
             }
-
-            for (auto out : ptx->vout) {
-                int nType = -1;
-                bool fOwner = false;
-                if (vpwallets[0]->IsMine(out) == ISMINE_SPENDABLE) { // Is the out mine
-                    if (out.scriptPubKey.IsAssetScript(nType, fOwner)) {
-                        CAssetOutputEntry assetData;
-                        // Get the asset data from the script
-                        if (GetAssetData(out.scriptPubKey, assetData)) {
-                            AssetType type;
-                            IsAssetNameValid(assetData.assetName, type);
-
-                            if (assetData.type == TX_TRANSFER_ASSET) {
-                                if (type == AssetType::MSGCHANNEL || type == AssetType::OWNER) { // Subscribe to any channels or owner tokens you own
-                                    AddChannel(assetData.assetName);
-                                    AddAddressSeen(EncodeDestination(assetData.destination));
-                                } else if (type == AssetType::ROOT || type == AssetType::SUB) { // Subscribe to any assets you are sent, if they are sent to a new address
-                                    if (!IsChannelSubscribed(assetData.assetName + OWNER_TAG)) {
-                                        if (!IsAddressSeen(EncodeDestination(assetData.destination))) {
-                                            AddChannel(assetData.assetName + OWNER_TAG);
-                                            AddAddressSeen(EncodeDestination(assetData.destination));
-                                        }
-                                    }
-                                }
-                            } else if (assetData.type == TX_NEW_ASSET || assetData.type == TX_REISSUE_ASSET) {
-                                if (fOwner || type == AssetType::MSGCHANNEL) {
-                                    AddChannel(assetData.assetName);
-                                    AddAddressSeen(EncodeDestination(assetData.destination));
-                                } else if (type == AssetType::ROOT || type == AssetType::SUB || type == AssetType::RESTRICTED) {
-                                    AddChannel(assetData.assetName + "!");
-                                    AddAddressSeen(EncodeDestination(assetData.destination));
-                                }
-                            }
-                        } else {
-                            LogPrintf("%s : Failed to get GetAssetData call\n", __func__);
-                        }
-                    }
-                }
+            if (!pmessagechanneldb->Flush() || !pmessagechanneldb->WriteScanProgress(locator)) {
+                strError = "Failed to write message channel scan progress";
+                return false;
             }
         }
-        blockIndex = chainActive[blockIndex->nHeight + 1];
-    }
 
-    LogPrintf("%s : Finished Scanning For Message Channels. Subscribed Messages Channels Found: %u\n", __func__, setDirtyChannelsAdd.size());
-    for (auto item : setDirtyChannelsAdd) {
-        LogPrintf("%s, ",item);
+        LogPrintf("%s : Scanned for message channels up to height %d of %d\n", __func__, pindexLast->nHeight, nTipHeight);
     }
-    LogPrintf("\n");
+
+    LogPrintf("%s : Finished Scanning For Message Channels. Subscribed Messages Channels Found: %u\n", __func__, nFound);
+    if (pnFound)
+        *pnFound = nFound;
     return true;
 }
+
+void ThreadScanMessageChannels()
+{
+    RenameThread("soteria-msgscan");
+
+    std::string strError;
+    if (!ScanForMessageChannels(strError)) {
+        LogPrintf("%s : Failed to scan for message channels, %s\n", __func__, strError);
+        return;
+    }
+
+    pmessagechanneldb->WriteFlag("init", true);
+    pmessagechanneldb->EraseScanProgress();
+    uiInterface.InitMessage(_("Message channels initialized"));
+}
 #endif
 
 bool IsAddressSeen(const std::string &address)
@@ -48,7 +48,30 @@ void OrphanMessage(const CMessage &message);
 void OrphanMessage(const COutPoint &out);
 
 #ifdef ENABLE_WALLET
-bool ScanForMessageChannels(std::string& strError);
+/** An output that can subscribe the wallet to a message channel */
+struct CMessageChannelScanEntry
+{
+    std::string assetName;
+    int nAssetTxType;
+    bool fOwner;
+    std::string address;
+};
+
+/** Subscribe to the channel an output entitles us to, returning how many channels are new. Entries must be applied in chain order. */
+size_t ApplyMessageChannelScanEntry(const CMessageChannelScanEntry& entry);
+
+static const size_t MESSAGE_SCAN_BATCH_SIZE = 1000;
+
+/**
+ * Subscribe to the message channels of the assets this wallet holds, reading blocks from the asset
+ * activation height in parallel. Progress is saved after every batch of nBatchSize blocks, so an
+ * interrupted scan resumes, from the fork point if the chain was reorganized in between. The scan
+ * stops after nMaxBatches batches, as if interrupted, unless that is 0. pnFound, if given, is set
+ * to the number of channels the scan newly subscribed to.
+ */
+bool ScanForMessageChannels(std::string& strError, size_t nBatchSize = MESSAGE_SCAN_BATCH_SIZE, size_t nMaxBatches = 0, size_t* pnFound = nullptr);
+/** Run ScanForMessageChannels() and mark the channel database as initialized once it completes */
+void ThreadScanMessageChannels();
 #endif
 bool IsAddressSeen(const std::string &address); // Has this address already been sent an asset before
 void AddAddressSeen(const std::string &address);
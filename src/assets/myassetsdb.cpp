@@ -11,6 +11,7 @@ static const char MESSAGE_FLAG = 'Z'; // Message
 static const char MY_MESSAGE_CHANNEL = 'C'; // My followed Channels
 static const char MY_SEEN_ADDRESSES = 'S'; // Addresses that have been seen on the chain
 static const char DB_FLAG = 'D'; // Database Flags
+static const char DB_SCAN_PROGRESS = 'P'; // Last block the message channel scan finished
 
 static const char MY_TAGGED_ADDRESSES = 'T'; // Addresses that have been tagged
 static const char MY_RESTRICTED_ADDRESSES = 'R'; // Addresses that have been restricted
@@ -193,6 +194,21 @@ bool CMessageChannelDB::EraseUsedAddress(const std::string& address)
     return Erase(std::make_pair(MY_SEEN_ADDRESSES, address));
 }
 
+bool CMessageChannelDB::WriteScanProgress(const CBlockLocator& locator)
+{
+    return Write(DB_SCAN_PROGRESS, locator, true);
+}
+
+bool CMessageChannelDB::ReadScanProgress(CBlockLocator& locator)
+{
+    return Read(DB_SCAN_PROGRESS, locator);
+}
+
+bool CMessageChannelDB::EraseScanProgress()
+{
+    return Erase(DB_SCAN_PROGRESS, true);
+}
+
 bool CMessageChannelDB::WriteFlag(const std::string &name, bool fValue)
 {
     return Write(std::make_pair(DB_FLAG, name), fValue ? '1' : '0');
@@ -10,6 +10,7 @@
 
 class CMessage;
 class COutPoint;
+struct CBlockLocator;
 
 class CMessageDB  : public CDBWrapper {
 
@@ -50,6 +51,11 @@ public:
     bool ReadUsedAddress(const std::string& address);
     bool EraseUsedAddress(const std::string& address);
 
+    // Where an interrupted message channel scan resumes
+    bool WriteScanProgress(const CBlockLocator& locator);
+    bool ReadScanProgress(CBlockLocator& locator);
+    bool EraseScanProgress();
+
     // Write / Read Database flags
     bool WriteFlag(const std::string &name, bool fValue);
     bool ReadFlag(const std::string &name, bool &fValue);
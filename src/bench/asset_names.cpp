@@ -0,0 +1,92 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "assets/assets.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <cassert>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Names as they show up in asset scripts: mostly transfers of root, sub and
+// owner assets, with some unique, channel and restricted names in between.
+static const std::vector<std::string> BENCH_ASSET_NAMES = {
+    "SOTERIA_COIN", "MY.ASSET", "GOLD", "GOLD!", "GOLD/BAR", "GOLD/BAR/2026", "GOLD/BAR!", "GOLD#BAR-0001",
+    "ART/GALLERY#PIECE[12]", "NEWS~DAILY", "#KYC", "#KYC/#US", "$TOKEN", "XN--80AK6AA92E", "A/B/C/D/E/F",
+    "THIS.IS.A.LONG.ROOT.ASSET.NAME.FOR.BENCHMARKING", "invalid", "BAD..NAME", "ROOT/-SUB",
+};
+
+// The std::regex checks IsAssetNameValid used before it was table driven,
+// restricted to the indicator dispatch and the root/sub name checks that the
+// names above exercise.
+namespace regex_reference {
+static const std::regex ROOT_NAME_CHARACTERS("^([A-Z]|[A-Z][A-Z0-9-]{0,62}[A-Z0-9])$");
+static const std::regex SUB_NAME_CHARACTERS("^([A-Z0-9]|[A-Z0-9][A-Z0-9-]{0,61}[A-Z0-9])$");
+static const std::regex DOUBLE_PUNCTUATION("^.*[._]{2,}.*$");
+static const std::regex LEADING_PUNCTUATION("^[._].*$");
+static const std::regex TRAILING_PUNCTUATION("^.*[._]$");
+static const std::regex UNIQUE_INDICATOR(R"(^[^^~#!]+#[^~#!\/]+$)");
+static const std::regex MSG_CHANNEL_INDICATOR(R"(^[^^~#!]+~[^~#!\/]+$)");
+static const std::regex OWNER_INDICATOR(R"(^[^^~#!]+!$)");
+static const std::regex VOTE_INDICATOR(R"(^[^^~#!]+\^[^~#!\/]+$)");
+static const std::regex QUALIFIER_INDICATOR("^[#][A-Z0-9._]{3,}$");
+static const std::regex SUB_QUALIFIER_INDICATOR("^#[A-Z0-9._]+\\/#[A-Z0-9._]+$");
+static const std::regex RESTRICTED_INDICATOR("^[\\$][A-Z0-9._]{3,}$");
+static const std::regex SOTERIA_NAMES("^RVN$|^SOTER$|^SOTERIA$|^SOTERIA$|^#SOTER$|^#SOTERIA$|^#SOTERIA$");
+
+static bool IsNameValidBeforeTag(const std::string& name)
+{
+    std::vector<std::string> parts;
+    boost::split(parts, name, boost::is_any_of("/"));
+    const std::string& root = parts.front();
+    if (!std::regex_match(root, ROOT_NAME_CHARACTERS) || std::regex_match(root, DOUBLE_PUNCTUATION) ||
+        std::regex_match(root, LEADING_PUNCTUATION) || std::regex_match(root, TRAILING_PUNCTUATION) ||
+        std::regex_match(root, SOTERIA_NAMES))
+        return false;
+    for (size_t i = 1; i < parts.size(); i++) {
+        if (!std::regex_match(parts[i], SUB_NAME_CHARACTERS) || std::regex_match(parts[i], DOUBLE_PUNCTUATION) ||
+            std::regex_match(parts[i], LEADING_PUNCTUATION) || std::regex_match(parts[i], TRAILING_PUNCTUATION))
+            return false;
+    }
+    return true;
+}
+
+static bool IsAssetNameValid(const std::string& name)
+{
+    if (std::regex_match(name, UNIQUE_INDICATOR) || std::regex_match(name, MSG_CHANNEL_INDICATOR))
+        return IsNameValidBeforeTag(name.substr(0, name.find_first_of("#~")));
+    if (std::regex_match(name, OWNER_INDICATOR))
+        return IsNameValidBeforeTag(name.substr(0, name.size() - 1));
+    if (std::regex_match(name, VOTE_INDICATOR) || std::regex_match(name, QUALIFIER_INDICATOR) ||
+        std::regex_match(name, SUB_QUALIFIER_INDICATOR) || std::regex_match(name, RESTRICTED_INDICATOR))
+        return true;
+    return IsNameValidBeforeTag(name);
+}
+} // namespace regex_reference
+
+static void AssetNameValidate(benchmark::State& state)
+{
+    size_t nValid = 0;
+    while (state.KeepRunning()) {
+        for (const std::string& name : BENCH_ASSET_NAMES)
+            nValid += IsAssetNameValid(name);
+    }
+    assert(nValid > 0);
+}
+
+static void AssetNameValidateRegex(benchmark::State& state)
+{
+    size_t nValid = 0;
+    while (state.KeepRunning()) {
+        for (const std::string& name : BENCH_ASSET_NAMES)
+            nValid += regex_reference::IsAssetNameValid(name);
+    }
+    assert(nValid > 0);
+}
+
+BENCHMARK(AssetNameValidate);
+BENCHMARK(AssetNameValidateRegex);
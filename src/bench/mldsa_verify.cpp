@@ -0,0 +1,60 @@
+// Copyright (c) 2025-2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "crypto/mldsa.h"
+#include "random.h"
+#include "uint256.h"
+
+#include <cassert>
+#include <vector>
+
+// RIP-25: verify a block's worth of ML-DSA-44 witness v2 signatures, as a
+// script check thread does with its thread-local verifier context.
+static const size_t SIGNATURES_PER_BLOCK = 1000;
+// Distinct keys; real blocks reuse keys across inputs, so fewer keys than
+// signatures also keeps setup time reasonable.
+static const size_t KEYS_PER_BLOCK = 100;
+
+struct PQSignedMessage {
+    std::vector<unsigned char> pk;
+    uint256 msg;
+    std::vector<unsigned char> sig;
+};
+
+static std::vector<PQSignedMessage> MakeBlockSignatures()
+{
+    std::vector<std::vector<unsigned char>> vPubKeys(KEYS_PER_BLOCK, std::vector<unsigned char>(mldsa::PUBLICKEY_BYTES));
+    std::vector<std::vector<unsigned char>> vSecKeys(KEYS_PER_BLOCK, std::vector<unsigned char>(mldsa::SECRETKEY_BYTES));
+    for (size_t i = 0; i < KEYS_PER_BLOCK; ++i) {
+        uint256 seed = GetRandHash();
+        bool ok = mldsa::KeyGen(vPubKeys[i].data(), vSecKeys[i].data(), seed.begin());
+        assert(ok);
+    }
+
+    std::vector<PQSignedMessage> vSigned(SIGNATURES_PER_BLOCK);
+    for (size_t i = 0; i < SIGNATURES_PER_BLOCK; ++i) {
+        PQSignedMessage& entry = vSigned[i];
+        entry.pk = vPubKeys[i % KEYS_PER_BLOCK];
+        entry.msg = GetRandHash();
+        entry.sig.resize(mldsa::SIGNATURE_BYTES);
+        size_t siglen = 0;
+        bool ok = mldsa::Sign(entry.sig.data(), &siglen, entry.msg.begin(), 32, vSecKeys[i % KEYS_PER_BLOCK].data());
+        assert(ok && siglen == mldsa::SIGNATURE_BYTES);
+    }
+    return vSigned;
+}
+
+static void MLDSAVerifyBlock(benchmark::State& state)
+{
+    std::vector<PQSignedMessage> vSigned = MakeBlockSignatures();
+    while (state.KeepRunning()) {
+        for (const PQSignedMessage& entry : vSigned) {
+            bool ok = mldsa::Verify(entry.sig.data(), entry.sig.size(), entry.msg.begin(), 32, entry.pk.data());
+            assert(ok);
+        }
+    }
+}
+
+BENCHMARK(MLDSAVerifyBlock);
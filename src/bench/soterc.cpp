@@ -0,0 +1,37 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "algo/soterc/soterc.h"
+
+#include <cstring>
+
+// Soterc of a header with a context that stays around, as a miner or
+// validation thread has, against setting one up for every hash.
+static void SotercReusedContext(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    SotercContext context;
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        memcpy(header + 76, &nNonce, sizeof(nNonce));
+        Soterc(header, header + 80, context);
+        nNonce++;
+    }
+}
+
+static void SotercNewContext(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        memcpy(header + 76, &nNonce, sizeof(nNonce));
+        SotercContext context;
+        Soterc(header, header + 80, context);
+        nNonce++;
+    }
+}
+
+BENCHMARK(SotercReusedContext);
+BENCHMARK(SotercNewContext);
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "algo/soterg/soterg.h"
+
+#include <cstring>
+
+// A miner's inner loop: the same 80 byte header with only the nonce changing,
+// hashed from scratch and from a midstate of the 76 byte prefix.
+static const uint256 BENCH_HASH_SELECTION = uint256S("0x00000000000000000000000000000000a3b1c4d2e5f60718293a4b5c6d7e8f90");
+
+static void X12RFullHeader(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        memcpy(header + CX12Midstate::PREFIX_SIZE, &nNonce, sizeof(nNonce));
+        HashX12R(header, header + 80, BENCH_HASH_SELECTION);
+        nNonce++;
+    }
+}
+
+static void X12RMidstate(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    CX12Midstate midstate;
+    midstate.InitX12R(header, BENCH_HASH_SELECTION);
+    uint32_t nNonce = 0;
+    while (state.KeepRunning())
+        midstate.Hash(nNonce++);
+}
+
+static void X12STFullHeader(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        memcpy(header + CX12Midstate::PREFIX_SIZE, &nNonce, sizeof(nNonce));
+        HashX12ST(header, header + 80, BENCH_HASH_SELECTION);
+        nNonce++;
+    }
+}
+
+static void X12STMidstate(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    CX12Midstate midstate;
+    midstate.InitX12ST(header);
+    uint32_t nNonce = 0;
+    while (state.KeepRunning())
+        midstate.Hash(nNonce++);
+}
+
+BENCHMARK(X12RFullHeader);
+BENCHMARK(X12RMidstate);
+BENCHMARK(X12STFullHeader);
+BENCHMARK(X12STMidstate);
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "algo/soterg/soterg.h"
+
+#include <vector>
+
+// Scalar against multi-buffer hashing: the component functions on their own,
+// a miner's nonce batch and a header sync batch with mixed X12R chains.
+static const uint256 BENCH_HASH_SELECTION = uint256S("0x00000000000000000000000000000000a3b1c4d2e5f60718293a4b5c6d7e8f90");
+
+static void ScalarComponent(benchmark::State& state, SphAlgo512 algo)
+{
+    const SphFunctions512& functions = GetSphFunctions512(algo);
+    uint512 hashes[MULTIHASH_LANES];
+    while (state.KeepRunning()) {
+        for (size_t lane = 0; lane < MULTIHASH_LANES; lane++) {
+            SphContext512 ctx;
+            functions.init(&ctx);
+            functions.write(&ctx, hashes[lane].begin(), 64);
+            functions.close(&ctx, hashes[lane].begin());
+        }
+    }
+}
+
+static void MultiComponent(benchmark::State& state, MultiHash512Fn multi)
+{
+    uint512 hashes[MULTIHASH_LANES];
+    const unsigned char* in[MULTIHASH_LANES];
+    unsigned char* out[MULTIHASH_LANES];
+    for (size_t lane = 0; lane < MULTIHASH_LANES; lane++)
+        in[lane] = out[lane] = hashes[lane].begin();
+    while (state.KeepRunning())
+        multi(in, out);
+}
+
+static void Blake512Scalar(benchmark::State& state) { ScalarComponent(state, SphAlgo512::BLAKE); }
+static void Blake512Multi(benchmark::State& state) { MultiComponent(state, Blake512x4_64); }
+static void Keccak512Scalar(benchmark::State& state) { ScalarComponent(state, SphAlgo512::KECCAK); }
+static void Keccak512Multi(benchmark::State& state) { MultiComponent(state, Keccak512x4_64); }
+static void Skein512Scalar(benchmark::State& state) { ScalarComponent(state, SphAlgo512::SKEIN); }
+static void Skein512Multi(benchmark::State& state) { MultiComponent(state, Skein512x4_64); }
+static void CubeHash512Scalar(benchmark::State& state) { ScalarComponent(state, SphAlgo512::CUBEHASH); }
+static void CubeHash512Multi(benchmark::State& state) { MultiComponent(state, CubeHash512x4_64); }
+
+static const size_t BENCH_NONCE_BATCH = 8;
+
+static void X12RNoncesScalar(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    CX12Midstate midstate;
+    midstate.InitX12R(header, BENCH_HASH_SELECTION);
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < BENCH_NONCE_BATCH; i++)
+            midstate.Hash(nNonce++);
+    }
+}
+
+static void X12RNoncesBatched(benchmark::State& state)
+{
+    unsigned char header[80] = {0x04};
+    CX12Midstate midstate;
+    midstate.InitX12R(header, BENCH_HASH_SELECTION);
+    uint256 hashes[BENCH_NONCE_BATCH];
+    uint32_t nNonce = 0;
+    while (state.KeepRunning()) {
+        midstate.Hash(nNonce, hashes, BENCH_NONCE_BATCH);
+        nNonce += BENCH_NONCE_BATCH;
+    }
+}
+
+static const size_t BENCH_HEADER_BATCH = 16;
+
+//! Headers that each select their own X12R chain, as on a synced chain
+static std::vector<CX12Midstate> BenchHeaderMidstates()
+{
+    std::vector<CX12Midstate> vMidstates(BENCH_HEADER_BATCH);
+    for (size_t i = 0; i < BENCH_HEADER_BATCH; i++) {
+        unsigned char header[80] = {0x04, (unsigned char)i};
+        uint256 hashSelection = BENCH_HASH_SELECTION;
+        hashSelection.begin()[26] = i * 0x1f;
+        hashSelection.begin()[27] = i * 0x3b;
+        vMidstates[i].InitX12R(header, hashSelection);
+    }
+    return vMidstates;
+}
+
+static void X12RHeadersScalar(benchmark::State& state)
+{
+    std::vector<CX12Midstate> vMidstates = BenchHeaderMidstates();
+    while (state.KeepRunning()) {
+        for (const CX12Midstate& midstate : vMidstates)
+            midstate.Hash(0);
+    }
+}
+
+static void X12RHeadersBatched(benchmark::State& state)
+{
+    std::vector<CX12Midstate> vMidstates = BenchHeaderMidstates();
+    std::vector<const SphAlgo512*> vChains;
+    for (const CX12Midstate& midstate : vMidstates)
+        vChains.push_back(midstate.GetChain());
+    std::vector<uint512> vHashes(BENCH_HEADER_BATCH);
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < BENCH_HEADER_BATCH; i++)
+            vMidstates[i].HashFirstRound(0, vHashes[i]);
+        HashX12Rounds(vChains.data(), vHashes.data(), BENCH_HEADER_BATCH);
+    }
+}
+
+BENCHMARK(Blake512Scalar);
+BENCHMARK(Blake512Multi);
+BENCHMARK(Keccak512Scalar);
+BENCHMARK(Keccak512Multi);
+BENCHMARK(Skein512Scalar);
+BENCHMARK(Skein512Multi);
+BENCHMARK(CubeHash512Scalar);
+BENCHMARK(CubeHash512Multi);
+BENCHMARK(X12RNoncesScalar);
+BENCHMARK(X12RNoncesBatched);
+BENCHMARK(X12RHeadersScalar);
+BENCHMARK(X12RHeadersBatched);
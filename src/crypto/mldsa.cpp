@@ -11,6 +11,7 @@
 
 #include <array>
 #include <cstring>
+#include <memory>
 #include <mutex>
 
 // Compile-time checks: ensure our constants match liboqs.
@@ -47,6 +48,32 @@ void DeterministicRandomBytes(uint8_t* out, size_t bytes_to_read)
     g_deterministic_offset += bytes_to_read;
 }
 
+struct OQSSigDeleter {
+    void operator()(OQS_SIG* sig) const { OQS_SIG_free(sig); }
+};
+
+// Verification never consumes OQS randomness, so each thread can keep one
+// verifier context for its lifetime instead of allocating one per call.
+OQS_SIG* GetThreadVerifier()
+{
+    thread_local std::unique_ptr<OQS_SIG, OQSSigDeleter> verifier(OQS_SIG_new(OQS_SIG_alg_ml_dsa_44));
+    return verifier.get();
+}
+
+bool VerifyWith(OQS_SIG* verifier,
+                const unsigned char* sig, size_t siglen,
+                const unsigned char* msg, size_t msglen,
+                const unsigned char* pk)
+{
+    if (!verifier || !sig || !msg || !pk)
+        return false;
+
+    if (siglen != mldsa::SIGNATURE_BYTES)
+        return false;
+
+    return OQS_SIG_verify(verifier, msg, msglen, sig, siglen, pk) == OQS_SUCCESS;
+}
+
 bool RestoreSystemRng()
 {
     const bool restored = OQS_randombytes_switch_algorithm(OQS_RAND_alg_system) == OQS_SUCCESS;
@@ -130,20 +157,7 @@ bool Verify(const unsigned char* sig, size_t siglen,
             const unsigned char* msg, size_t msglen,
             const unsigned char* pk)
 {
-    if (!sig || !msg || !pk)
-        return false;
-
-    if (siglen != SIGNATURE_BYTES)
-        return false;
-
-    OQS_SIG* verifier = OQS_SIG_new(OQS_SIG_alg_ml_dsa_44);
-    if (!verifier)
-        return false;
-
-    const OQS_STATUS rc = OQS_SIG_verify(verifier, msg, msglen, sig, siglen, pk);
-    OQS_SIG_free(verifier);
-
-    return rc == OQS_SUCCESS;
+    return VerifyWith(GetThreadVerifier(), sig, siglen, msg, msglen, pk);
 }
 
 } // namespace mldsa
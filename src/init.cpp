@@ -39,6 +39,8 @@
 #include <script/standard.h>
 #include <script/sigcache.h>
 #include <scheduler.h>
+#include <smartcontracts/contractexecutor.h>
+#include <smartcontracts/smartcontracts.h>
 #include <timedata.h>
 #include <txdb.h>
 #include <txmempool.h>
@@ -222,6 +224,7 @@ void Interrupt(boost::thread_group& threadGroup)
     InterruptRPC();
     InterruptREST();
     InterruptTorControl();
+    InterruptSmartContractExecutor();
     if (g_connman)
         g_connman->Interrupt();
     threadGroup.interrupt_all();
@@ -247,6 +250,8 @@ void PrepareShutdown()
     StopREST();
     StopRPC();
     StopHTTPServer();
+    StopSmartContractExecutor();
+    g_blockTemplateCache.reset();
 #ifdef ENABLE_WALLET
     FlushWallets();
 #endif
@@ -269,8 +274,7 @@ void PrepareShutdown()
     GetMainSignals().FlushBackgroundCallbacks();
 
     if (!fRPCInWarmup) {
-        CFlatDB<CPowCache> flatdb7("powcache.dat", "powCache");
-        flatdb7.Dump(CPowCache::Instance());
+        CPowCache::Instance().Flush();
     }
 
     // After the threads that potentially access these pointers have been stopped,
@@ -500,6 +504,7 @@ std::string HelpMessage(HelpMessageMode mode)
     if (showDebug)
         strUsage += HelpMessageOpt("-blocksonly", strprintf(_("Whether to operate in a blocks only mode (default: %u)"), DEFAULT_BLOCKSONLY));
     strUsage += HelpMessageOpt("-assumevalid=<hex>", strprintf(_("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet: %s)"), defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex()));
+    strUsage += HelpMessageOpt("-auditblockindexpow", strprintf(_("Re-verify the proof of work of the block index loaded from disk in a low priority background thread, see getblockindexaudit (default: %u)"), DEFAULT_AUDIT_BLOCKINDEX_POW));
     strUsage += HelpMessageOpt("-conf=<file>", strprintf(_("Specify configuration file (default: %s)"), SOTERIA_CONF_FILENAME));
     if (mode == HMM_SOTERIAD) {
 #if HAVE_DECL_DAEMON
@@ -600,6 +605,13 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-zmqpubrawblock=<address>", _("Enable publish raw block in <address>"));
     strUsage += HelpMessageOpt("-zmqpubrawtx=<address>", _("Enable publish raw transaction in <address>"));
     strUsage += HelpMessageOpt("-zmqpubrawmessage=<address>", _("Enable publish raw asset messages in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubcontractresult=<address>", _("Enable publish results of submitted smart contract calls in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassettransfer=<address>", _("Enable publish asset transfers of connected blocks in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassetissue=<address>", _("Enable publish asset issuances of connected blocks in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassetreissue=<address>", _("Enable publish asset reissuances of connected blocks in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassettag=<address>", _("Enable publish qualifier tag changes of connected blocks in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassetfreeze=<address>", _("Enable publish restricted asset freezes of connected blocks in <address>"));
+    strUsage += HelpMessageOpt("-zmqpubassetverifier=<address>", _("Enable publish restricted asset verifier changes of connected blocks in <address>"));
 #endif
 
     strUsage += HelpMessageGroup(_("Debugging/Testing options:"));
@@ -616,6 +628,7 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-dropmessagestest=<n>", "Randomly drop 1 of every <n> network messages");
         strUsage += HelpMessageOpt("-fuzzmessagestest=<n>", "Randomly fuzz 1 of every <n> network messages");
         strUsage += HelpMessageOpt("-stopafterblockimport", strprintf("Stop running after importing blocks from disk (default: %u)", DEFAULT_STOPAFTERBLOCKIMPORT));
+        strUsage += HelpMessageOpt("-rebuildaddressbalanceindex", "Sum up the address balance index again from the address index on startup (default: 0)");
         strUsage += HelpMessageOpt("-stopatheight", strprintf("Stop running after reaching the given height in the main chain (default: %u)", DEFAULT_STOPATHEIGHT));
 
         strUsage += HelpMessageOpt("-limitancestorcount=<n>", strprintf("Do not accept transactions if number of in-mempool ancestors is <n> or more (default: %u)", DEFAULT_ANCESTOR_LIMIT));
@@ -634,6 +647,7 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS));
         strUsage += HelpMessageOpt("-mocktime=<n>", "Replace actual time with <n> seconds since epoch (default: 0)");
         strUsage += HelpMessageOpt("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE));
+        strUsage += HelpMessageOpt("-maxpqsigcachesize=<n>", strprintf("Limit the post-quantum (ML-DSA-44) signature cache size to <n> MiB (default: %u)", DEFAULT_MAX_PQ_SIG_CACHE_SIZE));
         strUsage += HelpMessageOpt("-maxtipage=<n>", strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)", DEFAULT_MAX_TIP_AGE));
     }
     strUsage += HelpMessageOpt("-maxtxfee=<amt>", strprintf(_("Maximum total fees (in %s) to use in a single wallet transaction or raw transaction; setting this too low may abort large transactions (default: %s)"),
@@ -691,6 +705,11 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-powcachevalidate", _("Enable/disable PoW cache validation (default: disabled)"));
     // Smartplan: Show how to enable smartcontracts
     strUsage += HelpMessageOpt("-smartcontracts", strprintf(_("Enable Soteria Smartcontracts for use via JSON-RPC")));
+    strUsage += HelpMessageOpt("-smartcontractgaslimit=<n>", strprintf(_("Maximum number of Lua instructions a smart contract call may execute, 0 for no limit (default: %u)"), DEFAULT_SMARTCONTRACT_GAS_LIMIT));
+    strUsage += HelpMessageOpt("-smartcontractmaxmemory=<n>", strprintf(_("Maximum memory a smart contract call may allocate in megabytes, 0 for no limit (default: %u)"), DEFAULT_SMARTCONTRACT_MAX_MEMORY));
+    strUsage += HelpMessageOpt("-smartcontractthreads=<n>", strprintf(_("Number of threads running submitted smart contract calls (default: %d)"), DEFAULT_SMARTCONTRACT_THREADS));
+    strUsage += HelpMessageOpt("-smartcontractqueue=<n>", strprintf(_("Maximum number of submitted smart contract calls waiting to run (default: %d)"), DEFAULT_SMARTCONTRACT_QUEUE));
+    strUsage += HelpMessageOpt("-smartcontracttimeout=<n>", strprintf(_("Maximum time a smart contract call may run in milliseconds, 0 for no limit (default: %u)"), DEFAULT_SMARTCONTRACT_TIMEOUT));
     return strUsage;
 }
 
@@ -1210,6 +1229,12 @@ if (!fs::is_directory(GetDataDir(false))) {
     int64_t nMempoolSizeMin = gArgs.GetArg("-limitdescendantsize", DEFAULT_DESCENDANT_SIZE_LIMIT) * 1000 * 40;
     if (nMempoolSizeMax < 0 || nMempoolSizeMax < nMempoolSizeMin)
         return InitError(strprintf(_("-maxmempool must be at least %d MB"), std::ceil(nMempoolSizeMin / 1000000.0)));
+    // smart contract call limits, where 0 lifts the limit
+    for (const char* strArg : {"-smartcontractgaslimit", "-smartcontractmaxmemory", "-smartcontracttimeout"}) {
+        if (gArgs.GetArg(strArg, 0) < 0)
+            return InitError(strprintf(_("%s must not be negative"), strArg));
+    }
+
     // incremental relay fee sets the minimum feerate increase necessary for BIP 125 replacement in the mempool
     // and the amount the mempool min fee increases above the feerate of txs evicted due to mempool limiting.
     if (gArgs.IsArgSet("-incrementalrelayfee")) {
@@ -1454,10 +1479,12 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
     InitSignatureCache();
     InitScriptExecutionCache();
 
-    LogPrintf("Using %u threads for script verification\n", nScriptCheckThreads);
+    LogPrintf("Using %u threads for script verification and header PoW pre-validation\n", nScriptCheckThreads);
     if (nScriptCheckThreads) {
-        for (int i = 0; i < nScriptCheckThreads - 1; i++)
+        for (int i = 0; i < nScriptCheckThreads - 1; i++) {
             threadGroup.create_thread(&ThreadScriptCheck);
+            threadGroup.create_thread(&ThreadHeaderPoWCheck);
+        }
     }
 
     // Start the lightweight task scheduler thread
@@ -1493,18 +1520,22 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
     // ********************************************************* Step 6: Load cache data
 
     fs::path pathDB = GetDataDir();
-    std::string strDBName = "powcache.dat";
+    std::string strDBName = "powcache.bin";
 
     // Always load the powcache if available:
     uiInterface.InitMessage(_("Loading POW cache..."));
-    fs::path powCacheFile = pathDB / strDBName;
-    if (!fs::exists(powCacheFile)) {
-        uiInterface.InitMessage("Loading POW cache for the first time. This could take a minute...");
+    if (!CPowCache::Instance().Open(pathDB / strDBName)) {
+        return InitError(_("Failed to load POW cache from") + "\n" + (pathDB / strDBName).string() + "\n\n" + "Delete this file and it will be recreated.");
     }
 
-    CFlatDB<CPowCache> flatdb7(strDBName, "powCache");
-    if (!flatdb7.Load(CPowCache::Instance())) {
-        return InitError(_("Failed to load POW cache from") + "\n" + (pathDB / strDBName).string() + "\n\n" + "Delete this file and it will be recreated.");
+    // Import a flat powcache.dat written by older versions once, then drop it
+    std::string strLegacyDBName = "powcache.dat";
+    if (fs::exists(pathDB / strLegacyDBName)) {
+        uiInterface.InitMessage(_("Importing legacy POW cache..."));
+        CFlatDB<CPowCache> flatdb7(strLegacyDBName, "powCache");
+        if (flatdb7.Load(CPowCache::Instance()) && CPowCache::Instance().Flush()) {
+            fs::remove(pathDB / strLegacyDBName);
+        }
     }
 
     // ********************************************************* Step 7: network initialization
@@ -2012,6 +2043,9 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
         genesisWaitConn.disconnect();
     }
 
+    if (gArgs.GetBoolArg("-auditblockindexpow", DEFAULT_AUDIT_BLOCKINDEX_POW))
+        threadGroup.create_thread(boost::bind(&TraceThread<void (*)()>, "powaudit", &ThreadAuditBlockIndexPoW));
+
     // ********************************************************* Step 13: start node
 
     int chain_active_height;
@@ -2024,6 +2058,11 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
     }
     LogPrintf("nBestHeight = %d\n", chain_active_height);
 
+    if (gArgs.IsArgSet("-smartcontracts"))
+        StartSmartContractExecutor();
+
+    g_blockTemplateCache.reset(new CBlockTemplateCache(mempool));
+
     if (gArgs.GetBoolArg("-listenonion", DEFAULT_LISTEN_ONION))
         StartTorControl(threadGroup, scheduler);
 
@@ -2099,13 +2138,7 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
         bool found;
         if (!pmessagechanneldb->ReadFlag("init", found)) {
             uiInterface.InitMessage(_("Scanning message channels..."));
-            std::string strLoadError;
-            if (!ScanForMessageChannels(strLoadError)) {
-                LogPrintf("%s : Failed to scan for message channels, %s\n", __func__, strLoadError);
-            } else {
-                pmessagechanneldb->WriteFlag("init", true);
-                uiInterface.InitMessage(_("Message channels initialized"));
-            }
+            threadGroup.create_thread(boost::bind(&TraceThread<void (*)()>, "msgscan", &ThreadScanMessageChannels));
         }
     }
 #endif
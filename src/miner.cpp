@@ -31,6 +31,7 @@
 #include <validationinterface.h>
 #include <boost/thread.hpp>
 #include <algorithm>
+#include <atomic>
 #include <queue>
 #include <utility>
 #include <sync.h>
@@ -59,9 +60,35 @@ extern std::vector<CWalletRef> vpwallets;
 // its ancestors.
 uint64_t nLastBlockTx = 0;
 uint64_t nLastBlockWeight = 0;
-uint64_t nMiningTimeStart = 0;
-uint64_t nHashesPerSec = 0;
-uint64_t nHashesDone = 0;
+
+/** Hash counters of the internal miner threads, one per thread */
+struct CMinerHashrate
+{
+    int64_t nStartTime;
+    std::vector<std::atomic<uint64_t>> vHashesDone;
+
+    explicit CMinerHashrate(int nThreads) : nStartTime(GetTimeMicros()), vHashesDone(nThreads) {}
+};
+
+static CCriticalSection cs_minerHashrate;
+static std::shared_ptr<CMinerHashrate> minerHashrate;
+
+std::vector<uint64_t> GetMinerThreadHashesPerSec()
+{
+    std::shared_ptr<CMinerHashrate> hashrate;
+    {
+        LOCK(cs_minerHashrate);
+        hashrate = minerHashrate;
+    }
+
+    std::vector<uint64_t> vHashesPerSec;
+    if (!hashrate)
+        return vHashesPerSec;
+    int64_t nElapsed = GetTimeMicros() - hashrate->nStartTime;
+    for (const std::atomic<uint64_t>& nHashes : hashrate->vHashesDone)
+        vHashesPerSec.push_back(nHashes.load() * 1000000 / (nElapsed + 1));
+    return vHashesPerSec;
+}
 
 
 int64_t UpdateTime(CBlockHeader* pblock, const Consensus::ConsensusParams& consensusParams, const CBlockIndex* pindexPrev, const POW_TYPE powType)
@@ -537,6 +564,110 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
     }
 }
 
+std::unique_ptr<CBlockTemplateCache> g_blockTemplateCache;
+
+CBlockTemplateCache::CBlockTemplateCache(CTxMemPool& poolIn) :
+    pool(poolIn), pindexPrev(nullptr), powType(NUM_BLOCK_TYPES), fSupportsSegwit(false), nCreated(0),
+    nWeightLeft(0), fTxRemoved(false), fTxAdded(false), nChanges(0)
+{
+    pool.NotifyEntryAdded.connect(boost::bind(&CBlockTemplateCache::TransactionAdded, this, boost::placeholders::_1));
+    pool.NotifyEntryRemoved.connect(boost::bind(&CBlockTemplateCache::TransactionRemoved, this, boost::placeholders::_1, boost::placeholders::_2));
+}
+
+CBlockTemplateCache::~CBlockTemplateCache()
+{
+    pool.NotifyEntryAdded.disconnect(boost::bind(&CBlockTemplateCache::TransactionAdded, this, boost::placeholders::_1));
+    pool.NotifyEntryRemoved.disconnect(boost::bind(&CBlockTemplateCache::TransactionRemoved, this, boost::placeholders::_1, boost::placeholders::_2));
+}
+
+std::shared_ptr<const CBlockTemplate> CBlockTemplateCache::Get(const CBlockIndex* pindexPrevIn, POW_TYPE powTypeIn, bool fSupportsSegwitIn, int64_t nNow)
+{
+    LOCK(cs);
+    if (!pblocktemplate || pindexPrev != pindexPrevIn || powType != powTypeIn || fSupportsSegwit != fSupportsSegwitIn)
+        return nullptr;
+    if (fTxRemoved || (fTxAdded && nNow - nCreated > REFRESH_INTERVAL))
+        return nullptr;
+    return pblocktemplate;
+}
+
+void CBlockTemplateCache::Set(std::shared_ptr<const CBlockTemplate> pblocktemplateIn, const CBlockIndex* pindexPrevIn, POW_TYPE powTypeIn, bool fSupportsSegwitIn, int64_t nNow)
+{
+    std::unordered_set<uint256, SaltedTxidHasher> setTx;
+    int64_t nWeight = 0;
+    CFeeRate minRate;
+    const CBlock& block = pblocktemplateIn->block;
+    for (size_t i = 0; i < block.vtx.size(); i++) {
+        nWeight += GetTransactionWeight(*block.vtx[i]);
+        if (block.vtx[i]->IsCoinBase())
+            continue;
+        setTx.insert(block.vtx[i]->GetHash());
+        CFeeRate rate(pblocktemplateIn->vTxFees[i], GetVirtualTransactionSize(*block.vtx[i]));
+        if (setTx.size() == 1 || rate < minRate)
+            minRate = rate;
+    }
+
+    LOCK(cs);
+    pblocktemplate = pblocktemplateIn;
+    pindexPrev = pindexPrevIn;
+    powType = powTypeIn;
+    fSupportsSegwit = fSupportsSegwitIn;
+    nCreated = nNow;
+    // SaltedTxidHasher is not swappable, so the set is refilled in place
+    setTemplateTx.clear();
+    setTemplateTx.insert(setTx.begin(), setTx.end());
+    // Same reserve for the coinbase as BlockAssembler::CreateNewBlock()
+    nWeightLeft = (int64_t)GetMaxBlockWeightForPrev(pindexPrevIn, Params().GetConsensus()) - 4000 - nWeight;
+    minFeeRate = minRate;
+    fTxRemoved = false;
+    fTxAdded = false;
+}
+
+void CBlockTemplateCache::Invalidate()
+{
+    LOCK(cs);
+    fTxRemoved = true;
+    ++nChanges;
+}
+
+uint64_t CBlockTemplateCache::GetChangeCount() const
+{
+    LOCK(cs);
+    return nChanges;
+}
+
+void CBlockTemplateCache::TransactionAdded(const CTxMemPoolEntry& entry)
+{
+    // pool.cs first, as the mempool holds it when it notifies
+    LOCK2(pool.cs, cs);
+    if (!pblocktemplate || fTxAdded)
+        return;
+
+    bool fRelevant = (int64_t)entry.GetTxWeight() <= nWeightLeft ||
+                     CFeeRate(entry.GetModifiedFee(), entry.GetTxSize()) > minFeeRate;
+    for (const CTxIn& txin : entry.GetTx().vin) {
+        if (fRelevant)
+            break;
+        fRelevant = !setTemplateTx.count(txin.prevout.hash) && pool.exists(txin.prevout.hash);
+    }
+    if (fRelevant) {
+        fTxAdded = true;
+        ++nChanges;
+    }
+}
+
+void CBlockTemplateCache::TransactionRemoved(CTransactionRef ptx, MemPoolRemovalReason reason)
+{
+    // Transactions mined into a block go along with a new tip anyway
+    if (reason == MemPoolRemovalReason::BLOCK)
+        return;
+
+    LOCK2(pool.cs, cs);
+    if (!pblocktemplate || fTxRemoved || !setTemplateTx.count(ptx->GetHash()))
+        return;
+    fTxRemoved = true;
+    ++nChanges;
+}
+
 void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce)
 {
     // Update nExtraNonce
@@ -595,13 +726,36 @@ CWallet *GetFirstWallet() {
     return(NULL);
 }
 
-void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType)
+std::pair<uint32_t, uint32_t> GetMinerNonceRange(int nThread, int nThreads)
+{
+    return {(uint64_t)MAX_MINER_NONCE * nThread / nThreads, (uint64_t)MAX_MINER_NONCE * (nThread + 1) / nThreads};
+}
+
+size_t GetMinerHashBatch(uint32_t nNonce, uint32_t nNonceEnd)
+{
+    if (nNonce >= nNonceEnd)
+        return 0;
+    return std::min<uint64_t>({MINER_HASH_BATCH, 0x100 - (nNonce & 0xFF), (uint64_t)nNonceEnd - nNonce});
+}
+
+/** Scan the nonces GetMinerNonceRange() gives the thread in every template */
+void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType, int nThread, int nThreads,
+                         std::shared_ptr<CMinerHashrate> hashrate)
 {
-    LogPrintf("SoteriaMiner -- started\n");
+    LogPrintf("SoteriaMiner -- started thread %d of %d\n", nThread + 1, nThreads);
     SetThreadPriority(THREAD_PRIORITY_LOWEST);
     RenameThread("soteria-miner");
 
     unsigned int nExtraNonce = 0;
+    // Every thread mines the same coinbase, so threads are kept apart by their nonce range
+    const std::pair<uint32_t, uint32_t> nonceRange = GetMinerNonceRange(nThread, nThreads);
+    const uint32_t nNonceBegin = nonceRange.first;
+    const uint32_t nNonceEnd = nonceRange.second;
+
+    // Set up before the first template, so the yespower memory is in place when hashing starts
+    std::shared_ptr<SotercContext> sotercContext = MakeSotercContext();
+    CPoWHasher hasher(sotercContext.get());
+    std::atomic<uint64_t>& nHashesDone = hashrate->vHashesDone[nThread];
 
 
     CWallet * pWallet = NULL;
@@ -678,6 +832,8 @@ void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType
             }
             CBlock *pblock = &pblocktemplate->block;
             IncrementExtraNonce(pblock, pindexPrev, nExtraNonce);
+            pblock->nNonce = nNonceBegin;
+            hasher.Reset(*pblock);
 
             LogPrintf("SoteriaMiner -- Running miner with %u transactions in block (%u bytes)\n", pblock->vtx.size(),
                 ::GetSerializeSize(*pblock, SER_NETWORK, PROTOCOL_VERSION));
@@ -690,12 +846,21 @@ void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType
             while (true)
             {
 
-                uint256 hash;
+                uint256 hashes[MINER_HASH_BATCH];
+                uint64_t nHashes = 0;
                 while (true)
                 {
-                    hash = pblock->ComputePoWHash();
-                    if (UintToArith256(hash) <= hashTarget)
+                    // Batches end on multiples of 0x100 nonces, so the checks below run as often as before
+                    size_t nBatch = GetMinerHashBatch(pblock->nNonce, nNonceEnd);
+                    hasher.Hash(*pblock, hashes, nBatch);
+                    nHashes += nBatch;
+                    size_t nFound = 0;
+                    while (nFound < nBatch && UintToArith256(hashes[nFound]) > hashTarget)
+                        nFound++;
+                    if (nFound < nBatch)
                     {
+                        pblock->nNonce += nFound;
+                        const uint256& hash = hashes[nFound];
                         // Found a solution
                         SetThreadPriority(THREAD_PRIORITY_NORMAL);
                         LogPrintf("SoteriaMiner:\n  proof-of-work found\n  hash: %s\n  target: %s\n", hash.GetHex(), hashTarget.GetHex());
@@ -710,21 +875,18 @@ void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType
 
                         break;
                     }
-                    pblock->nNonce += 1;
-                    nHashesDone += 1;
-                    if (nHashesDone % 500000 == 0) {   //Calculate hashing speed
-                        nHashesPerSec = nHashesDone / (((GetTimeMicros() - nMiningTimeStart) / 1000000) + 1);
-                    } 
-                    if ((pblock->nNonce & 0xFF) == 0)
+                    pblock->nNonce += nBatch;
+                    if ((pblock->nNonce & 0xFF) == 0 || pblock->nNonce >= nNonceEnd)
                         break;
                 }
+                nHashesDone += nHashes;
 
                 // Check for stop or if block needs to be rebuilt
                 boost::this_thread::interruption_point();
                 // Regtest mode doesn't require peers
                 //if (vNodes.empty() && chainparams.MiningRequiresPeers())
                 //    break;
-                if (pblock->nNonce >= 0xffff0000)
+                if (pblock->nNonce >= nNonceEnd)
                     break;
                 if (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > 60)
                     break;
@@ -735,6 +897,7 @@ void static SoteriaMiner(const CChainParams& chainparams, const POW_TYPE powType
                 if (UpdateTime(pblock, chainparams.GetConsensus(), pindexPrev, powType) < 0)
                     break; // Recreate the block if the clock has run backwards,
                            // so that we can use the correct time.
+                hasher.Reset(*pblock);
                 if (chainparams.GetConsensus().fPowAllowMinDifficultyBlocks)
                 {
                     // Changing pblock->nTime can change work required on testnet:
@@ -770,6 +933,10 @@ int GenerateSoterias(bool fGenerate, int nThreads, const CChainParams& chainpara
         delete minerThreads;
         minerThreads = NULL;
     }
+    {
+        LOCK(cs_minerHashrate);
+        minerHashrate.reset();
+    }
 
     if (nThreads == 0 || !fGenerate)
         return numCores;
@@ -777,9 +944,11 @@ int GenerateSoterias(bool fGenerate, int nThreads, const CChainParams& chainpara
     minerThreads = new boost::thread_group();
 
     //Reset metrics
-    nMiningTimeStart = GetTimeMicros();
-    nHashesDone = 0;
-    nHashesPerSec = 0;
+    std::shared_ptr<CMinerHashrate> hashrate = std::make_shared<CMinerHashrate>(nThreads);
+    {
+        LOCK(cs_minerHashrate);
+        minerHashrate = hashrate;
+    }
 
     std::string strAlgo = gArgs.GetArg("-powalgo", DEFAULT_POW_TYPE);
 
@@ -796,7 +965,7 @@ int GenerateSoterias(bool fGenerate, int nThreads, const CChainParams& chainpara
         LogPrintf("SoteriaMiner -- Invalid pow algorithm requested");
 
     for (int i = 0; i < nThreads; i++){
-        minerThreads->create_thread(boost::bind(&SoteriaMiner, boost::cref(chainparams), boost::cref(powType)));
+        minerThreads->create_thread(boost::bind(&SoteriaMiner, boost::cref(chainparams), powType, i, nThreads, hashrate));
     }
 
     return(numCores);
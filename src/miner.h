@@ -13,6 +13,7 @@
 #include <vector>
 #include <stdint.h>
 #include <memory>
+#include <unordered_set>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <validation.h>
@@ -23,6 +24,10 @@ class CScript;
 namespace Consensus { struct ConsensusParams; };
 
 static constexpr bool DEFAULT_PRINTPRIORITY = false;
+/** Nonces the internal miner tries per template, split evenly between its threads */
+static constexpr uint32_t MAX_MINER_NONCE = 0xffff0000;
+/** Nonces the internal miner hashes at once, see CPoWHasher::Hash */
+static constexpr size_t MINER_HASH_BATCH = 8;
 
 struct CBlockTemplate
 {
@@ -202,9 +207,74 @@ private:
     int UpdatePackagesForAdded(const CTxMemPool::setEntries& alreadyAdded, indexed_modified_transaction_set &mapModifiedTx) EXCLUSIVE_LOCKS_REQUIRED(mempool.cs);
 };
 
+/**
+ * The last block template handed out by getblocktemplate.
+ *
+ * Building a template selects packages from the whole mempool and then runs
+ * TestBlockValidity() over the result, so pools polling from many front-ends
+ * should not pay for it on every call. A cached template is reused until the
+ * tip changes or the mempool changes in a way that could alter it:
+ * - one of its transactions leaves the mempool (other than by being mined), or
+ * - a transaction arrives that could be selected, because it fits in the room
+ *   left in the block, pays a higher feerate than the cheapest transaction the
+ *   template holds, or spends an unconfirmed output outside the template and
+ *   so might raise the feerate of its parent.
+ * Arrivals only retire a template once it is REFRESH_INTERVAL seconds old.
+ */
+class CBlockTemplateCache
+{
+public:
+    //! Seconds a template is kept after transactions it could include arrived
+    static const int64_t REFRESH_INTERVAL = 5;
+
+    explicit CBlockTemplateCache(CTxMemPool& poolIn);
+    ~CBlockTemplateCache();
+
+    /** The cached template if it was built on pindexPrev with these options and is still current, else null */
+    std::shared_ptr<const CBlockTemplate> Get(const CBlockIndex* pindexPrev, POW_TYPE powType, bool fSupportsSegwit, int64_t nNow);
+
+    /** Cache a template just built on pindexPrev */
+    void Set(std::shared_ptr<const CBlockTemplate> pblocktemplate, const CBlockIndex* pindexPrev, POW_TYPE powType, bool fSupportsSegwit, int64_t nNow);
+
+    /** Retire the cached template, e.g. after fee deltas changed package scores */
+    void Invalidate();
+
+    /** Number of mempool changes relevant to the cached templates seen so far */
+    uint64_t GetChangeCount() const;
+
+private:
+    void TransactionAdded(const CTxMemPoolEntry& entry);
+    void TransactionRemoved(CTransactionRef ptx, MemPoolRemovalReason reason);
+
+    CTxMemPool& pool;
+    mutable CCriticalSection cs;
+
+    std::shared_ptr<const CBlockTemplate> pblocktemplate;
+    const CBlockIndex* pindexPrev;
+    POW_TYPE powType;
+    bool fSupportsSegwit;
+    int64_t nCreated;
+
+    std::unordered_set<uint256, SaltedTxidHasher> setTemplateTx;
+    int64_t nWeightLeft;
+    CFeeRate minFeeRate;
+
+    bool fTxRemoved;
+    bool fTxAdded;
+    uint64_t nChanges;
+};
+
+extern std::unique_ptr<CBlockTemplateCache> g_blockTemplateCache;
+
 /** Modify the extranonce in a block */
 void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce);
 int64_t UpdateTime(CBlockHeader* pblock, const Consensus::ConsensusParams& consensusParams, const CBlockIndex* pindexPrev, const POW_TYPE powType);
+/** The nonces [first, second) internal miner thread nThread of nThreads tries in every template. Together the threads cover [0, MAX_MINER_NONCE) once. */
+std::pair<uint32_t, uint32_t> GetMinerNonceRange(int nThread, int nThreads);
+/** How many nonces from nNonce on the internal miner hashes at once: up to MINER_HASH_BATCH, stopping at the next multiple of 0x100 and at nNonceEnd */
+size_t GetMinerHashBatch(uint32_t nNonce, uint32_t nNonceEnd);
 
 int GenerateSoterias(bool fGenerate, int nThreads, const CChainParams& chainparams);
+/** Average hashes per second of each internal miner thread, empty when not mining */
+std::vector<uint64_t> GetMinerThreadHashesPerSec();
 #endif // SOTERIA_MINER_H
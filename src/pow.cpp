@@ -744,15 +744,13 @@ bool CheckProofOfWork(uint256 hash, unsigned int nBits, const Consensus::Consens
 
 bool CheckProofOfWork(const CBlockHeader& blockheader, const Consensus::ConsensusParams& params, bool cache)
 {
-    if (blockheader.GetBlockTime() > params.lwma1Timestamp) {
-        if (cache)
-            return CheckProofOfWorkSoterC(blockheader.GetHash(), blockheader.nBits, params, blockheader.GetPoWType());
-        else
-            return CheckProofOfWorkSoterC(blockheader.GetHash(false), blockheader.nBits, params, blockheader.GetPoWType());
-    } else {
-        if (cache)
-            return CheckProofOfWork(blockheader.GetHash(), blockheader.nBits, params);
-        else
-            return CheckProofOfWork(blockheader.GetHash(false), blockheader.nBits, params);
-    }
+    return CheckProofOfWork(blockheader, blockheader.GetHash(cache), params);
+}
+
+bool CheckProofOfWork(const CBlockHeader& blockheader, const uint256& powHash, const Consensus::ConsensusParams& params)
+{
+    if (blockheader.GetBlockTime() > params.lwma1Timestamp)
+        return CheckProofOfWorkSoterC(powHash, blockheader.nBits, params, blockheader.GetPoWType());
+    else
+        return CheckProofOfWork(powHash, blockheader.nBits, params);
 }
@@ -29,5 +29,7 @@ unsigned int CalculateNextWorkRequired(const CBlockIndex* pindexLast, int64_t nF
 
 /** Check whether a block hash satisfies the proof-of-work requirement */
 bool CheckProofOfWork(const CBlockHeader& blockheader, const Consensus::ConsensusParams& params, bool cache = true);
+/** Same, for a PoW hash of blockheader that was already computed */
+bool CheckProofOfWork(const CBlockHeader& blockheader, const uint256& powHash, const Consensus::ConsensusParams& params);
 
 #endif
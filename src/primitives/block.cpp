@@ -5,6 +5,7 @@
 
 #include <chainparams.h>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <algo/soterc/soterc.h>
 #include <algo/soterg/soterg.h>
@@ -33,67 +34,154 @@ uint256 CBlockHeader::GetSHA256Hash() const
 
 uint256 CBlockHeader::ComputePoWHash() const
 {
-    uint256 thash;
-    unsigned int profile = 0x0;
-
-    uint32_t nSoterGTimestamp = Params().GetConsensus().vUpgrades[Consensus::SOTERG_SWITCH].nTimestamp;
-    uint32_t nSoterHASHTimestamp = Params().GetConsensus().vUpgrades[Consensus::SOTERHASH_SWITCH].nTimestamp;
-    uint32_t nSoterCTimestamp = Params().GetConsensus().vUpgrades[Consensus::SOTERC_SWITCH].nTimestamp;
-    uint32_t nX8STimestamp = Params().GetConsensus().vUpgrades[Consensus::X8S_SWITCH].nTimestamp;
-    if (nTime > nSoterGTimestamp) {
-        if(nTime > nSoterHASHTimestamp) 
-           if(nTime > nSoterCTimestamp)
-              if(nTime > nX8STimestamp)
-        {
-            switch (GetPoWType()) {
-            case POW_TYPE_SOTERG: {
-                int32_t nTimeSoterG = nTime & TIME_MASK;
-                uint256 hashTime = Hash(BEGIN(nTimeSoterG), END(nTimeSoterG));
-                thash = HashX12R(BEGIN(nVersion), END(nNonce), hashTime);
-                break;
-            }
-            case POW_TYPE_SOTERHASH: {
-                int32_t nTimeSoterHASH = nTime & TIME_MASK;
-                uint256 hashTime = Hash(BEGIN(nTimeSoterHASH), END(nTimeSoterHASH));
-                thash = HashX12ST(BEGIN(nVersion), END(nNonce), hashTime);
-                break;
-            }   
-            case POW_TYPE_X8S: {
-                int32_t nTimeX8S = nTime;
-                uint256 hashTime = Hash(BEGIN(nTimeX8S), END(nTimeX8S));
-                thash = HashX8S(BEGIN(nVersion), END(nNonce), hashTime);
-                break;
-            }    
-            case POW_TYPE_SOTERC: {
-                return Soterc(BEGIN(nVersion), END(nNonce), true);
-                break;
-            }
-            default: // Don't crash the client on invalid blockType, just return a bad hash
-                return HIGH_HASH;
-            }
-        } else {
-               int32_t nTimeSoterG = nTime & TIME_MASK;
-            uint256 hashTime = Hash(BEGIN(nTimeSoterG), END(nTimeSoterG));
-            thash = HashX12R(BEGIN(nVersion), END(nNonce), hashTime);
+    // Reused so that X12 headers don't allocate a midstate on every call
+    static thread_local CPoWHasher hasher;
+    hasher.Reset(*this);
+    return hasher.Hash(*this);
+}
+
+std::shared_ptr<SotercContext> MakeSotercContext()
+{
+    return std::make_shared<SotercContext>();
+}
+
+CPoWHasher::CPoWHasher(SotercContext* sotercContextIn) : algo(ALGO_INVALID), sotercContext(sotercContextIn)
+{
+}
+
+CPoWHasher::~CPoWHasher()
+{
+}
+
+void CPoWHasher::Reset(const CBlockHeader& header)
+{
+    const Consensus::ConsensusParams& consensus = Params().GetConsensus();
+    uint32_t nTime = header.nTime;
+
+    if (nTime <= consensus.vUpgrades[Consensus::SOTERG_SWITCH].nTimestamp) {
+        // we keep it for testing only.
+        algo = ALGO_X12R_PREV_BLOCK;
+    } else if (nTime <= consensus.vUpgrades[Consensus::SOTERHASH_SWITCH].nTimestamp) {
+        // Between the SoterG and SoterHASH switches no algorithm applies, the hash stays null
+        algo = ALGO_NONE;
+    } else if (nTime <= consensus.vUpgrades[Consensus::SOTERC_SWITCH].nTimestamp) {
+        algo = ALGO_X12ST;
+    } else if (nTime <= consensus.vUpgrades[Consensus::X8S_SWITCH].nTimestamp) {
+        algo = ALGO_X12R;
+    } else {
+        switch (header.GetPoWType()) {
+        case POW_TYPE_SOTERG:
+            algo = ALGO_X12R;
+            break;
+        case POW_TYPE_SOTERHASH:
+            algo = ALGO_X12ST;
+            break;
+        case POW_TYPE_X8S:
+            algo = ALGO_X8S;
+            break;
+        case POW_TYPE_SOTERC:
+            algo = ALGO_SOTERC;
+            break;
+        default: // Don't crash the client on invalid blockType, just return a bad hash
+            algo = ALGO_INVALID;
         }
-        else {
-            
-            int32_t nTimeSoterHASH = nTime & TIME_MASK;
-            uint256 hashTime = Hash(BEGIN(nTimeSoterHASH), END(nTimeSoterHASH));
-            thash = HashX12ST(BEGIN(nVersion), END(nNonce), hashTime);
-        }   
     }
-    else {
-        // we keep it for testing only.
-        thash = HashX12R(BEGIN(nVersion), END(nNonce), hashPrevBlock);
+
+    if (algo == ALGO_X12R || algo == ALGO_X12ST) {
+        int32_t nTimeMasked = nTime & TIME_MASK;
+        hashTime = ::Hash(BEGIN(nTimeMasked), END(nTimeMasked));
+    } else if (algo == ALGO_X8S) {
+        int32_t nTimeX8S = nTime;
+        hashTime = ::Hash(BEGIN(nTimeX8S), END(nTimeX8S));
     }
 
-    return thash;
+    // The header is hashed as it is laid out in memory, nNonce being its last 4 bytes
+    static_assert(offsetof(CBlockHeader, nNonce) == CX12Midstate::PREFIX_SIZE, "nNonce must follow the midstate prefix");
+    const unsigned char* prefix = (const unsigned char*)BEGIN(header.nVersion);
+    // Only X12R and X12ST need the midstate, so the other algorithms don't pay for allocating it
+    if ((algo == ALGO_X12R_PREV_BLOCK || algo == ALGO_X12R || algo == ALGO_X12ST) && !midstate)
+        midstate.reset(new CX12Midstate());
+    if (algo == ALGO_X12R_PREV_BLOCK)
+        midstate->InitX12R(prefix, header.hashPrevBlock);
+    else if (algo == ALGO_X12R)
+        midstate->InitX12R(prefix, hashTime);
+    else if (algo == ALGO_X12ST)
+        midstate->InitX12ST(prefix);
+}
+
+uint256 CPoWHasher::Hash(const CBlockHeader& header) const
+{
+    switch (algo) {
+    case ALGO_X12R_PREV_BLOCK:
+    case ALGO_X12R:
+    case ALGO_X12ST:
+        return midstate->Hash(header.nNonce);
+    case ALGO_X8S:
+        return HashX8S(BEGIN(header.nVersion), END(header.nNonce), hashTime);
+    case ALGO_SOTERC:
+        return Soterc(BEGIN(header.nVersion), END(header.nNonce), sotercContext ? *sotercContext : GetThreadSotercContext());
+    case ALGO_NONE:
+        return uint256();
+    default:
+        return HIGH_HASH;
+    }
+}
+
+void CPoWHasher::Hash(const CBlockHeader& header, uint256 hashes[], size_t n) const
+{
+    if (algo == ALGO_X12R_PREV_BLOCK || algo == ALGO_X12R || algo == ALGO_X12ST) {
+        midstate->Hash(header.nNonce, hashes, n);
+        return;
+    }
+    CBlockHeader next = header;
+    for (size_t i = 0; i < n; i++, next.nNonce++)
+        hashes[i] = Hash(next);
+}
+
+std::vector<uint256> ComputePoWHashes(const std::vector<const CBlockHeader*>& vHeaders)
+{
+    std::vector<uint256> vHashes(vHeaders.size());
+
+    CPoWHasher hasher;
+    std::vector<std::array<SphAlgo512, X12_ROUNDS>> vChains;
+    std::vector<uint512> vRounds;
+    std::vector<size_t> vX12;
+    for (size_t i = 0; i < vHeaders.size(); i++) {
+        hasher.Reset(*vHeaders[i]);
+        // Only chains with a multi-buffer round are worth batching; X12ST never has one
+        if ((hasher.algo != CPoWHasher::ALGO_X12R_PREV_BLOCK && hasher.algo != CPoWHasher::ALGO_X12R && hasher.algo != CPoWHasher::ALGO_X12ST) ||
+            !HasMultiHashRounds(hasher.midstate->GetChain())) {
+            vHashes[i] = hasher.Hash(*vHeaders[i]);
+            continue;
+        }
+        vRounds.emplace_back();
+        hasher.midstate->HashFirstRound(vHeaders[i]->nNonce, vRounds.back());
+        vChains.emplace_back();
+        std::copy(hasher.midstate->GetChain(), hasher.midstate->GetChain() + X12_ROUNDS, vChains.back().begin());
+        vX12.push_back(i);
+    }
+
+    std::vector<const SphAlgo512*> vChainPtrs;
+    for (const auto& chain : vChains)
+        vChainPtrs.push_back(chain.data());
+    HashX12Rounds(vChainPtrs.data(), vRounds.data(), vRounds.size());
+    for (size_t k = 0; k < vX12.size(); k++)
+        vHashes[vX12[k]] = vRounds[k].trim256();
+    return vHashes;
+}
+
+std::vector<std::string> CPoWHasher::GetHashChain() const
+{
+    std::vector<std::string> vChain;
+    if (algo == ALGO_X12R_PREV_BLOCK || algo == ALGO_X12R || algo == ALGO_X12ST) {
+        for (int i = 0; i < X12_ROUNDS; i++)
+            vChain.push_back(GetSphFunctions512(midstate->GetChain()[i]).name);
+    }
+    return vChain;
 }
 
 uint256 CBlockHeader::GetHash(bool readCache) const
 {
-    LOCK(cs_pow);
     CPowCache& cache(CPowCache::Instance());
 
     uint256 headerHash = GetSHA256Hash();
@@ -105,17 +193,48 @@ uint256 CBlockHeader::GetHash(bool readCache) const
     }
 
     if (!found || cache.IsValidate()) {
+        // Computed without holding any cache lock, so other threads keep
+        // hitting the cache while this (potentially slow) hash runs.
         uint256 powHash2 = ComputePoWHash();
         if (found && powHash2 != powHash) {
            LogPrintf("PowCache failure: headerHash: %s, from cache: %s, computed: %s, correcting\n", headerHash.ToString(), powHash.ToString(), powHash2.ToString());
         }
         powHash = powHash2;
-        cache.erase(headerHash); // If it exists, replace it.
-        cache.insert(headerHash, powHash2);
+        cache.insert(headerHash, powHash2); // If it exists, replace it.
     }
     return powHash;
 }
 
+std::vector<uint256> GetPoWHashes(const std::vector<const CBlockHeader*>& vHeaders)
+{
+    CPowCache& cache(CPowCache::Instance());
+
+    std::vector<uint256> vHashes(vHeaders.size());
+    std::vector<uint256> vHeaderHashes(vHeaders.size());
+    std::vector<bool> vFound(vHeaders.size());
+    std::vector<const CBlockHeader*> vMissing;
+    std::vector<size_t> vMissingPos;
+    for (size_t i = 0; i < vHeaders.size(); i++) {
+        vHeaderHashes[i] = vHeaders[i]->GetSHA256Hash();
+        vFound[i] = cache.get(vHeaderHashes[i], vHashes[i]);
+        if (!vFound[i] || cache.IsValidate()) {
+            vMissing.push_back(vHeaders[i]);
+            vMissingPos.push_back(i);
+        }
+    }
+
+    std::vector<uint256> vComputed = ComputePoWHashes(vMissing);
+    for (size_t k = 0; k < vMissing.size(); k++) {
+        size_t i = vMissingPos[k];
+        if (vFound[i] && vComputed[k] != vHashes[i]) {
+            LogPrintf("PowCache failure: headerHash: %s, from cache: %s, computed: %s, correcting\n", vHeaderHashes[i].ToString(), vHashes[i].ToString(), vComputed[k].ToString());
+        }
+        vHashes[i] = vComputed[k];
+        cache.insert(vHeaderHashes[i], vComputed[k]);
+    }
+    return vHashes;
+}
+
 // Soterc algo
 uint256 CBlockHeader::SoterCHashArbitrary(const char* data) {
     return Soterc(data, data + strlen(data), true);
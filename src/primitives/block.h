@@ -14,6 +14,7 @@
 #include <string>
 #include <unordered_lru_cache.h>
 #include <util/system.h>
+#include <memory>
 #include <vector>
 
 // Dual algo: An impossible pow hash (can't meet any target)
@@ -37,6 +38,9 @@ enum POW_TYPE {
     NUM_BLOCK_TYPES
 };
 
+class CX12Midstate;
+class SotercContext;
+
 class CBlockHeader
 {
 public:
@@ -117,6 +121,70 @@ public:
 };
 
 
+/**
+ * PoW hashing of headers that only differ in their nonce, as when mining.
+ *
+ * The algorithm to use and the time hash mixed into it only depend on nTime and
+ * nVersion, so Reset() works them out once and Hash() is then left with the
+ * hash of a single nonce. For X12R and X12ST, Reset() also absorbs the header
+ * bytes before nNonce into the first round (see CX12Midstate). Soterc hashes
+ * with the garden and yespower memory of a SotercContext.
+ */
+class CPoWHasher
+{
+public:
+    //! sotercContextIn: what to compute Soterc hashes with, or null for the SotercContext of the calling thread
+    explicit CPoWHasher(SotercContext* sotercContextIn = nullptr);
+    ~CPoWHasher();
+
+    /** Prepare for headers that only differ from header in nNonce */
+    void Reset(const CBlockHeader& header);
+
+    /** The PoW hash of header, which must only differ in nNonce from the header given to Reset() */
+    uint256 Hash(const CBlockHeader& header) const;
+
+    /** The PoW hashes of header with the n nonces header.nNonce, header.nNonce + 1, ... */
+    void Hash(const CBlockHeader& header, uint256 hashes[], size_t n) const;
+
+    /** Names of the hash functions chained for the header given to Reset(), in order. Empty unless it uses X12R or X12ST */
+    std::vector<std::string> GetHashChain() const;
+
+private:
+    friend std::vector<uint256> ComputePoWHashes(const std::vector<const CBlockHeader*>& vHeaders);
+
+    enum Algo {
+        ALGO_X12R_PREV_BLOCK,
+        ALGO_X12R,
+        ALGO_X12ST,
+        ALGO_X8S,
+        ALGO_SOTERC,
+        ALGO_NONE,
+        ALGO_INVALID
+    };
+
+    Algo algo;
+    uint256 hashTime;
+    std::unique_ptr<CX12Midstate> midstate;
+    SotercContext* sotercContext;
+};
+
+/**
+ * A new SotercContext (see algo/soterc/soterc.h) for CPoWHasher. Unlike the
+ * one of GetThreadSotercContext() it is set up right away rather than on the
+ * first Soterc hash, and freed with its last reference rather than at thread exit.
+ */
+std::shared_ptr<SotercContext> MakeSotercContext();
+
+/**
+ * ComputePoWHash() of a batch of headers. The X12R headers whose chain has a
+ * function with a multi-buffer kernel have their later rounds hashed side by
+ * side through HashX12Rounds; the others are hashed one by one.
+ */
+std::vector<uint256> ComputePoWHashes(const std::vector<const CBlockHeader*>& vHeaders);
+
+/** GetHash() of a batch of headers: what the PoW cache misses is computed by ComputePoWHashes() and cached */
+std::vector<uint256> GetPoWHashes(const std::vector<const CBlockHeader*>& vHeaders);
+
 class CBlock : public CBlockHeader
 {
 public:
@@ -7,47 +7,84 @@
 
 #include <primitives/powcache.h>
 #include <primitives/block.h>
-#include <flat-database.h>
 #include <sync.h>
-#include "../util/system.h"
+#include <algorithm>
 #include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <util/system.h>
 
-CCriticalSection cs_pow;
-
 CPowCache* CPowCache::instance = nullptr;
 
 CPowCache& CPowCache::Instance()
 {
-    if (CPowCache::instance == nullptr)
-    {
+    static std::once_flag initFlag;
+    std::call_once(initFlag, []() {
         int powCacheSize = gArgs.GetArg("-powhashcache", DEFAULT_POW_CACHE_SIZE);
         bool powCacheValidate = gArgs.GetArg("-powcachevalidate", 0) > 0 ? true : false;
         powCacheSize = powCacheSize == 0 ? DEFAULT_POW_CACHE_SIZE : powCacheSize;
 
         CPowCache::instance = new CPowCache(powCacheSize, powCacheValidate);
-    }
+    });
     return *instance;
 }
 
 void CPowCache::DoMaintenance()
 {
-    LOCK(cs_pow);
-    // If cache has grown enough, save it:
-    if (cacheMap.size() - nLoadedSize > 100)
-    {
-        CFlatDB<CPowCache> flatDb("powcache.dat", "powCache");
-        flatDb.Dump(*this);
+    Flush();
+}
+
+bool CPowCache::Open(const fs::path& path)
+{
+    LOCK(csStore);
+    pstore.reset(new CPowCacheStore(path));
+    size_t nLoaded = 0;
+    bool fOk = pstore->Load([this, &nLoaded](const uint256& headerHash, const uint256& powHash) {
+        insert(headerHash, powHash, false);
+        ++nLoaded;
+    });
+    if (!fOk) {
+        pstore.reset();
+        return false;
     }
+    fStoreOpen = true;
+    LogPrintf("PowCache: loaded %u entries from %s\n", nLoaded, path.string());
+    return true;
 }
 
-CPowCache::CPowCache(int maxSize, bool validate) : unordered_lru_cache<uint256, uint256, std::hash<uint256>>(maxSize),
+bool CPowCache::Flush()
+{
+    LOCK(csStore);
+    if (!pstore)
+        return false;
+
+    std::vector<std::pair<uint256, uint256>> vEntries;
+    for (auto& shard : vShards) {
+        LOCK(shard->cs);
+        vEntries.insert(vEntries.end(), shard->vPending.begin(), shard->vPending.end());
+        shard->vPending.clear();
+    }
+
+    // The store only ever grows; once superseded, evicted or corrupt records
+    // dominate it, compact it down to the live cache contents.
+    if (pstore->GetCorruptCount() || pstore->GetRecordCount() + vEntries.size() > 2 * nMaxSize) {
+        return pstore->Rewrite(Snapshot());
+    }
+    return pstore->Append(vEntries);
+}
+
+CPowCache::CPowCache(int maxSize, bool validate) :
    nVersion(CURRENT_VERSION),
-   nLoadedSize(0),
-   bValidate(validate)
+   bValidate(validate),
+   nMaxSize(std::max(maxSize, 1)),
+   fStoreOpen(false)
 {
+    size_t nShardSize = std::max<size_t>(1, nMaxSize / SHARD_COUNT);
+    vShards.reserve(SHARD_COUNT);
+    for (size_t i = 0; i < SHARD_COUNT; ++i)
+        vShards.emplace_back(new Shard(nShardSize));
+
     if (bValidate) LogPrintf("PowCache: Validation and auto correction enabled\n");
 }
 
@@ -55,9 +92,66 @@ CPowCache::~CPowCache()
 {
 }
 
+bool CPowCache::get(const uint256& headerHash, uint256& powHash)
+{
+    Shard& shard = GetShard(headerHash);
+    LOCK(shard.cs);
+    return shard.map.get(headerHash, powHash);
+}
+
+bool CPowCache::exists(const uint256& headerHash)
+{
+    Shard& shard = GetShard(headerHash);
+    LOCK(shard.cs);
+    return shard.map.exists(headerHash);
+}
+
+void CPowCache::insert(const uint256& headerHash, const uint256& powHash, bool fPersist)
+{
+    Shard& shard = GetShard(headerHash);
+    LOCK(shard.cs);
+    shard.map.insert(headerHash, powHash);
+    if (fPersist && fStoreOpen)
+        shard.vPending.emplace_back(headerHash, powHash);
+}
+
+void CPowCache::erase(const uint256& headerHash)
+{
+    Shard& shard = GetShard(headerHash);
+    LOCK(shard.cs);
+    shard.map.erase(headerHash);
+}
+
+size_t CPowCache::size() const
+{
+    size_t nSize = 0;
+    for (const auto& shard : vShards) {
+        LOCK(shard->cs);
+        nSize += shard->map.size();
+    }
+    return nSize;
+}
+
+std::vector<std::pair<uint256, uint256>> CPowCache::Snapshot() const
+{
+    std::vector<std::pair<uint256, uint256>> vEntries;
+    vEntries.reserve(size());
+    for (const auto& shard : vShards) {
+        LOCK(shard->cs);
+        shard->map.for_each([&vEntries](const uint256& headerHash, const uint256& powHash) {
+            vEntries.emplace_back(headerHash, powHash);
+        });
+    }
+    return vEntries;
+}
+
 void CPowCache::Clear()
 {
-   cacheMap.clear();
+    for (auto& shard : vShards) {
+        LOCK(shard->cs);
+        shard->map.clear();
+        shard->vPending.clear();
+    }
 }
 
 void CPowCache::CheckAndRemove()
@@ -67,6 +161,6 @@ void CPowCache::CheckAndRemove()
 std::string CPowCache::ToString() const
 {
     std::ostringstream info;
-    info << "PowCache: elements: " << (int)cacheMap.size();
+    info << "PowCache: elements: " << size() << ", shards: " << SHARD_COUNT;
     return info.str();
 }
@@ -13,69 +13,121 @@
 #include <serialize.h>
 #include <unordered_lru_cache.h>
 #include <util/system.h>
+#include <fs.h>
+#include <primitives/powcachestore.h>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
-extern CCriticalSection cs_pow;
-
-class CPowCache : public unordered_lru_cache<uint256, uint256, std::hash<uint256>>
+/**
+ * Cache of header SHA256 hash -> PoW hash.
+ *
+ * The cache is split into independently locked shards selected by the header
+ * hash, so concurrent lookups only contend when they land on the same shard and
+ * a shard lock is never held while a PoW hash is being computed.
+ *
+ * Entries are persisted through an append-only CPowCacheStore: each shard
+ * remembers the entries inserted since the last Flush(), and only those are
+ * written out.
+ */
+class CPowCache
 {
     private:
+        typedef unordered_lru_cache<uint256, uint256, std::hash<uint256>> ShardMap;
+
+        struct Shard
+        {
+            CCriticalSection cs;
+            ShardMap map;
+            //! Entries not yet written to the store
+            std::vector<std::pair<uint256, uint256>> vPending;
+
+            explicit Shard(size_t maxSize) : map(maxSize) {}
+        };
+
         static CPowCache* instance;
         static const int CURRENT_VERSION = 1;
 
         int nVersion;
-        int nLoadedSize;
         bool bValidate;
-        CCriticalSection cs;
+        size_t nMaxSize;
+        std::vector<std::unique_ptr<Shard>> vShards;
+
+        CCriticalSection csStore;
+        std::unique_ptr<CPowCacheStore> pstore;
+        std::atomic<bool> fStoreOpen;
+
+        Shard& GetShard(const uint256& headerHash) const
+        {
+            return *vShards[headerHash.GetCheapHash() % SHARD_COUNT];
+        }
+
+        /** Copy out all entries, locking one shard at a time */
+        std::vector<std::pair<uint256, uint256>> Snapshot() const;
 
     public:
+        static const size_t SHARD_COUNT = 64;
+
         static CPowCache& Instance();
 
         CPowCache(int maxSize = DEFAULT_POW_CACHE_SIZE, bool validate = false);
         virtual ~CPowCache();
 
+        bool get(const uint256& headerHash, uint256& powHash);
+        bool exists(const uint256& headerHash);
+        void insert(const uint256& headerHash, const uint256& powHash, bool fPersist = true);
+        void erase(const uint256& headerHash);
+        size_t size() const;
+
         void Clear();
         void CheckAndRemove();
         bool IsValidate() const { return bValidate; }
         void DoMaintenance();
 
+        /** Load the persistent store at path into the cache and keep it open for appending */
+        bool Open(const fs::path& path);
+        /** Append entries inserted since the last flush to the persistent store */
+        bool Flush();
+
         std::string ToString() const;
 
+        // Flat (CFlatDB) format, only used to import a legacy powcache.dat
         ADD_SERIALIZE_METHODS
 
         template <typename Stream, typename Operation>
         inline void SerializationOp(Stream& s, Operation ser_action)
         {
-            LOCK(cs);
             READWRITE(nVersion);
 
-            uint64_t cacheSize = (uint64_t)cacheMap.size();
-            READWRITE(COMPACTSIZE(cacheSize));
-
             if (ser_action.ForRead())
             {
+                uint64_t cacheSize = 0;
+                READWRITE(COMPACTSIZE(cacheSize));
+
                 uint256 headerHash;
                 uint256 powHash;
-                for (int i = 0; i < cacheSize; ++i)
+                for (uint64_t i = 0; i < cacheSize; ++i)
                 {
                     READWRITE(headerHash);
                     READWRITE(powHash);
                     insert(headerHash, powHash);
                 }
                 nVersion = CURRENT_VERSION;
-                nLoadedSize = cacheMap.size();
             }
             else
             {
-                for (auto it = cacheMap.begin(); it != cacheMap.end(); ++it)
+                std::vector<std::pair<uint256, uint256>> vEntries = Snapshot();
+                uint64_t cacheSize = (uint64_t)vEntries.size();
+                READWRITE(COMPACTSIZE(cacheSize));
+
+                for (auto& entry : vEntries)
                 {
-                    uint256 headerHash = it->first;
-                    uint256 powHash    = it->second.first;
-                    READWRITE(headerHash);
-                    READWRITE(powHash);
-                };
-                nLoadedSize = cacheMap.size(); // The size on disk is current
+                    READWRITE(entry.first);
+                    READWRITE(entry.second);
+                }
             }
         }
 };
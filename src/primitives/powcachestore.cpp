@@ -0,0 +1,214 @@
+// Copyright (c) 2025-2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <primitives/powcachestore.h>
+
+#include <crypto/common.h>
+#include <hash.h>
+#include <util/system.h>
+
+#include <cstring>
+
+#ifdef WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const unsigned char STORE_MAGIC[8] = {'S', 'O', 'T', 'P', 'O', 'W', 'C', 'S'};
+
+// Fixed keys: the checksum guards against torn or corrupted writes, not
+// against an adversary who can already write to the data directory.
+static const uint64_t CHECKSUM_K0 = 0x536f746572696150ULL;
+static const uint64_t CHECKSUM_K1 = 0x6f57436163686531ULL;
+
+static uint64_t RecordChecksum(const unsigned char* record)
+{
+    return CSipHasher(CHECKSUM_K0, CHECKSUM_K1).Write(record, 64).Finalize();
+}
+
+static void SerializeRecord(unsigned char* record, const uint256& headerHash, const uint256& powHash)
+{
+    memcpy(record, headerHash.begin(), 32);
+    memcpy(record + 32, powHash.begin(), 32);
+    WriteLE64(record + 64, RecordChecksum(record));
+}
+
+static void SerializeStoreHeader(unsigned char* header)
+{
+    memcpy(header, STORE_MAGIC, sizeof(STORE_MAGIC));
+    WriteLE32(header + 8, CPowCacheStore::CURRENT_VERSION);
+    WriteLE32(header + 12, CPowCacheStore::RECORD_SIZE);
+}
+
+static bool WriteRecords(FILE* file, const std::vector<std::pair<uint256, uint256>>& vEntries)
+{
+    // Write in chunks to keep the number of fwrite calls low without
+    // buffering the whole cache a second time.
+    static const size_t CHUNK_RECORDS = 4096;
+    std::vector<unsigned char> vBuf;
+    vBuf.reserve(CHUNK_RECORDS * CPowCacheStore::RECORD_SIZE);
+    for (size_t i = 0; i < vEntries.size(); ++i) {
+        size_t nOffset = vBuf.size();
+        vBuf.resize(nOffset + CPowCacheStore::RECORD_SIZE);
+        SerializeRecord(vBuf.data() + nOffset, vEntries[i].first, vEntries[i].second);
+        if (vBuf.size() == CHUNK_RECORDS * CPowCacheStore::RECORD_SIZE || i + 1 == vEntries.size()) {
+            if (fwrite(vBuf.data(), 1, vBuf.size(), file) != vBuf.size())
+                return false;
+            vBuf.clear();
+        }
+    }
+    return true;
+}
+
+CPowCacheStore::CPowCacheStore(const fs::path& pathIn) : path(pathIn), file(nullptr), nRecords(0), nCorrupt(0)
+{
+}
+
+CPowCacheStore::~CPowCacheStore()
+{
+    Close();
+}
+
+void CPowCacheStore::Close()
+{
+    if (file) {
+        FileCommit(file);
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool CPowCacheStore::Load(const std::function<void(const uint256&, const uint256&)>& func)
+{
+    Close();
+    nRecords = 0;
+    nCorrupt = 0;
+
+    if (!fs::exists(path) || fs::file_size(path) == 0)
+        return Rewrite({});
+
+    size_t nFileSize = fs::file_size(path);
+    const unsigned char* pdata = nullptr;
+
+#ifdef WIN32
+    std::vector<unsigned char> vData(nFileSize);
+    {
+        std::ifstream stream(path.string(), std::ios::binary);
+        if (!stream.read((char*)vData.data(), nFileSize))
+            return error("%s: failed to read %s", __func__, path.string());
+    }
+    pdata = vData.data();
+#else
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd < 0)
+        return error("%s: failed to open %s", __func__, path.string());
+    void* pmap = mmap(nullptr, nFileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pmap == MAP_FAILED)
+        return error("%s: failed to map %s", __func__, path.string());
+#ifdef MADV_SEQUENTIAL
+    madvise(pmap, nFileSize, MADV_SEQUENTIAL);
+#endif
+    pdata = static_cast<const unsigned char*>(pmap);
+#endif
+
+    bool fValidHeader = nFileSize >= HEADER_SIZE &&
+                        memcmp(pdata, STORE_MAGIC, sizeof(STORE_MAGIC)) == 0 &&
+                        ReadLE32(pdata + 8) == CURRENT_VERSION &&
+                        ReadLE32(pdata + 12) == RECORD_SIZE;
+
+    size_t nFullRecords = 0;
+    if (fValidHeader) {
+        nFullRecords = (nFileSize - HEADER_SIZE) / RECORD_SIZE;
+        uint256 headerHash;
+        uint256 powHash;
+        for (size_t i = 0; i < nFullRecords; ++i) {
+            const unsigned char* record = pdata + HEADER_SIZE + i * RECORD_SIZE;
+            if (ReadLE64(record + 64) != RecordChecksum(record)) {
+                ++nCorrupt;
+                continue;
+            }
+            memcpy(headerHash.begin(), record, 32);
+            memcpy(powHash.begin(), record + 32, 32);
+            func(headerHash, powHash);
+        }
+    }
+
+#ifndef WIN32
+    munmap(pmap, nFileSize);
+#endif
+
+    if (!fValidHeader)
+        return error("%s: %s is not a PoW cache store", __func__, path.string());
+
+    if (nCorrupt)
+        LogPrintf("PowCache: skipped %u corrupt records in %s\n", nCorrupt, path.string());
+
+    // A partial record at the end (e.g. from a crash mid-append) is cut off
+    // so that new records stay aligned.
+    return OpenForAppend(nFullRecords);
+}
+
+bool CPowCacheStore::OpenForAppend(size_t nFullRecords)
+{
+    file = fsbridge::fopen(path, "rb+");
+    if (!file)
+        return error("%s: failed to open %s for appending", __func__, path.string());
+
+    size_t nLength = HEADER_SIZE + nFullRecords * RECORD_SIZE;
+    if (fs::file_size(path) != nLength && !TruncateFile(file, nLength)) {
+        Close();
+        return error("%s: failed to truncate %s", __func__, path.string());
+    }
+    if (fseek(file, nLength, SEEK_SET) != 0) {
+        Close();
+        return error("%s: failed to seek in %s", __func__, path.string());
+    }
+    nRecords = nFullRecords;
+    return true;
+}
+
+bool CPowCacheStore::Append(const std::vector<std::pair<uint256, uint256>>& vEntries)
+{
+    if (!file)
+        return false;
+    if (vEntries.empty())
+        return true;
+
+    if (!WriteRecords(file, vEntries))
+        return error("%s: failed to append to %s", __func__, path.string());
+    FileCommit(file);
+    nRecords += vEntries.size();
+    return true;
+}
+
+bool CPowCacheStore::Rewrite(const std::vector<std::pair<uint256, uint256>>& vEntries)
+{
+    Close();
+
+    fs::path pathTmp = path;
+    pathTmp += ".new";
+    FILE* fileTmp = fsbridge::fopen(pathTmp, "wb");
+    if (!fileTmp)
+        return error("%s: failed to create %s", __func__, pathTmp.string());
+
+    unsigned char header[HEADER_SIZE];
+    SerializeStoreHeader(header);
+    bool fOk = fwrite(header, 1, HEADER_SIZE, fileTmp) == HEADER_SIZE && WriteRecords(fileTmp, vEntries);
+    if (fOk)
+        FileCommit(fileTmp);
+    fclose(fileTmp);
+
+    if (!fOk || !RenameOver(pathTmp, path)) {
+        fs::remove(pathTmp);
+        return error("%s: failed to write %s", __func__, path.string());
+    }
+
+    nCorrupt = 0;
+    return OpenForAppend(vEntries.size());
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2025-2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SOTER_POWCACHESTORE_H
+#define SOTER_POWCACHESTORE_H
+
+#include <fs.h>
+#include <uint256.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Append-only on-disk store of (header hash, PoW hash) pairs backing CPowCache.
+ *
+ * The file is a 16 byte header followed by fixed size records, each carrying
+ * its own checksum. Loading maps the file read-only and walks the records in
+ * place; new entries are appended without touching the existing records, so
+ * persisting the cache costs O(new entries). Later records for the same header
+ * hash supersede earlier ones.
+ */
+class CPowCacheStore
+{
+public:
+    static const uint32_t CURRENT_VERSION = 1;
+    static const size_t HEADER_SIZE = 16;
+    static const size_t RECORD_SIZE = 72; // header hash, PoW hash, 64-bit checksum
+
+    explicit CPowCacheStore(const fs::path& pathIn);
+    ~CPowCacheStore();
+
+    /**
+     * Map the store and call func for every record with a valid checksum.
+     * A missing or empty file is created. Returns false if the file exists
+     * but is not a PoW cache store or cannot be opened for appending.
+     */
+    bool Load(const std::function<void(const uint256&, const uint256&)>& func);
+
+    /** Append entries to the end of the store and commit them to disk */
+    bool Append(const std::vector<std::pair<uint256, uint256>>& vEntries);
+
+    /** Atomically replace the store contents with the given entries */
+    bool Rewrite(const std::vector<std::pair<uint256, uint256>>& vEntries);
+
+    /** Number of records in the file, including superseded and corrupt ones */
+    size_t GetRecordCount() const { return nRecords; }
+    /** Number of records that failed their checksum during Load() */
+    size_t GetCorruptCount() const { return nCorrupt; }
+
+    void Close();
+
+private:
+    fs::path path;
+    FILE* file;
+    size_t nRecords;
+    size_t nCorrupt;
+
+    bool OpenForAppend(size_t nValidRecords);
+};
+
+#endif // SOTER_POWCACHESTORE_H
@@ -1440,7 +1440,7 @@ UniValue transferfromaddresses(const JSONRPCRequest& request)
 
     CCoinControl ctrl;
     std::map<std::string, std::vector<COutput>> mapAssetCoins;
-    pwallet->AvailableAssets(mapAssetCoins);
+    pwallet->AvailableAssets(std::set<std::string>{asset_name}, mapAssetCoins);
 
     // Set the change addresses
     ctrl.destChange = soter_change_dest;
@@ -1583,7 +1583,7 @@ UniValue transferfromaddress(const JSONRPCRequest& request)
 
     CCoinControl ctrl;
     std::map<std::string, std::vector<COutput>> mapAssetCoins;
-    pwallet->AvailableAssets(mapAssetCoins);
+    pwallet->AvailableAssets(std::set<std::string>{asset_name}, mapAssetCoins);
 
     // Set the change addresses
     ctrl.destChange = soter_change_dest;
@@ -1738,6 +1738,42 @@ UniValue reissue(const JSONRPCRequest& request)
 }
 #endif
 
+static UniValue AssetDirToJSON(const std::vector<CDatabasedAssetData>& assets, bool verbose)
+{
+    UniValue result;
+    result = verbose ? UniValue(UniValue::VOBJ) : UniValue(UniValue::VARR);
+
+    for (const auto& data : assets) {
+        const CNewAsset& asset = data.asset;
+        if (verbose) {
+            UniValue detail(UniValue::VOBJ);
+            detail.push_back(Pair("name", asset.strName));
+            detail.push_back(Pair("amount", UnitValueFromAmount(asset.nAmount, asset.strName)));
+            detail.push_back(Pair("units", asset.units));
+            detail.push_back(Pair("reissuable", asset.nReissuable));
+            detail.push_back(Pair("has_ipfs", asset.nHasIPFS));
+            detail.push_back(Pair("has_ans", asset.nHasANS));
+            detail.push_back(Pair("block_height", data.nHeight));
+            detail.push_back(Pair("blockhash", data.blockHash.GetHex()));
+            if (asset.nHasIPFS) {
+                if (asset.strIPFSHash.size() == 32) {
+                    detail.push_back(Pair("txid_hash", EncodeAssetData(asset.strIPFSHash)));
+                } else {
+                    detail.push_back(Pair("ipfs_hash", EncodeAssetData(asset.strIPFSHash)));
+                }
+            }
+            if (asset.nHasANS) {
+                detail.push_back(Pair("ans_id", asset.strANSID));
+            }
+            result.push_back(Pair(asset.strName, detail));
+        } else {
+            result.push_back(asset.strName);
+        }
+    }
+
+    return result;
+}
+
 UniValue listassets(const JSONRPCRequest& request)
 {
     if (request.fHelp || !AreAssetsDeployed() || request.params.size() > 4)
@@ -1808,37 +1844,71 @@ UniValue listassets(const JSONRPCRequest& request)
     if (!passetsdb->AssetDir(assets, filter, count, start))
         throw JSONRPCError(RPC_INTERNAL_ERROR, "couldn't retrieve asset directory.");
 
-    UniValue result;
-    result = verbose ? UniValue(UniValue::VOBJ) : UniValue(UniValue::VARR);
+    return AssetDirToJSON(assets, verbose);
+}
 
-    for (auto data : assets) {
-        CNewAsset asset = data.asset;
-        if (verbose) {
-            UniValue detail(UniValue::VOBJ);
-            detail.push_back(Pair("name", asset.strName));
-            detail.push_back(Pair("amount", UnitValueFromAmount(asset.nAmount, asset.strName)));
-            detail.push_back(Pair("units", asset.units));
-            detail.push_back(Pair("reissuable", asset.nReissuable));
-            detail.push_back(Pair("has_ipfs", asset.nHasIPFS));
-            detail.push_back(Pair("has_ans", asset.nHasANS));
-            detail.push_back(Pair("block_height", data.nHeight));
-            detail.push_back(Pair("blockhash", data.blockHash.GetHex()));
-            if (asset.nHasIPFS) {
-                if (asset.strIPFSHash.size() == 32) {
-                    detail.push_back(Pair("txid_hash", EncodeAssetData(asset.strIPFSHash)));
-                } else {
-                    detail.push_back(Pair("ipfs_hash", EncodeAssetData(asset.strIPFSHash)));
-                }
-            }
-            if (asset.nHasANS) {
-                detail.push_back(Pair("ans_id", asset.strANSID));
-            }
-            result.push_back(Pair(asset.strName, detail));
-        } else {
-            result.push_back(asset.strName);
-        }
+UniValue listassetspage(const JSONRPCRequest& request)
+{
+    if (request.fHelp || !AreAssetsDeployed() || request.params.size() > 4)
+        throw std::runtime_error(
+            "listassetspage \"( asset )\" ( verbose ) ( count ) ( \"cursor\" )\n"
+ + AssetActivationWarning() +
+            "\nReturns one page of the asset list and a cursor to resume from\n"
+            "\nOnly the database ranges that can match the filter are read, so each page costs O(count)\n"
+
+            "\nArguments:\n"
+            "1. \"asset\"                    (string, optional, default=\"*\") filters results -- must be an asset name or a partial asset name followed by '*' ('*' matches all trailing characters)\n"
+            "2. \"verbose\"                  (boolean, optional, default=false) when false assets is just a list of asset names -- when true assets maps asset names to metadata\n"
+            "3. \"count\"                    (integer, optional, default=1000) maximum number of assets to return\n"
+            "4. \"cursor\"                   (string, optional, default=\"\") the \"next\" value of the previous page, empty for the first page\n"
+
+            "\nResult:\n"
+            "{\n"
+            "  \"assets\": [...] or {...},     (array or object) same format as the listassets result\n"
+            "  \"next\": \"cursor\"             (string) pass as cursor to get the next page, empty when there are no more assets\n"
+            "}\n"
+
+            "\nExamples:\n" +
+            HelpExampleRpc("listassetspage", "\"ASSET*\", false, 100") + HelpExampleCli("listassetspage", "\"ASSET*\" true 100 \"4153534554\""));
+
+    ObserveSafeMode();
+
+    if (!passetsdb)
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "asset db unavailable.");
+
+    std::string filter = "*";
+    if (request.params.size() > 0)
+        filter = request.params[0].get_str();
+
+    if (filter == "")
+        filter = "*";
+
+    bool verbose = false;
+    if (request.params.size() > 1)
+        verbose = request.params[1].get_bool();
+
+    size_t count = 1000;
+    if (request.params.size() > 2) {
+        if (request.params[2].get_int() < 1)
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "count must be greater than 1.");
+        count = request.params[2].get_int();
+    }
+
+    std::string cursor;
+    if (request.params.size() > 3) {
+        cursor = request.params[3].get_str();
+        if (!IsHex(cursor) && !cursor.empty())
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid cursor.");
     }
 
+    std::vector<CDatabasedAssetData> assets;
+    std::string nextCursor;
+    if (!passetsdb->AssetDir(assets, filter, count, cursor, nextCursor))
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "couldn't retrieve asset directory.");
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("assets", AssetDirToJSON(assets, verbose)));
+    result.push_back(Pair("next", nextCursor));
     return result;
 }
 
@@ -3157,6 +3227,7 @@ static const CRPCCommand commands[] =
         {"assets", "reissue", &reissue, {"asset_name", "qty", "to_address", "change_address", "reissuable", "new_units", "new_ipfs"}},
 #endif
         {"assets", "listassets", &listassets, {"asset", "verbose", "count", "start"}},
+        {"assets", "listassetspage", &listassetspage, {"asset", "verbose", "count", "cursor"}},
         {"assets", "getcacheinfo", &getcacheinfo, {}},
 
 #ifdef ENABLE_WALLET
@@ -2176,6 +2176,49 @@ static UniValue savemempool(const JSONRPCRequest& request)
     return NullUniValue;
 }
 
+static UniValue getblockindexaudit(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0) {
+        throw std::runtime_error(
+            "getblockindexaudit\n"
+            "\nReturns the progress of the background PoW audit of the block index loaded from disk.\n"
+            "The audit only runs when the node was started with -auditblockindexpow.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"started\": true|false,    (boolean) whether the audit thread has started\n"
+            "  \"done\": true|false,       (boolean) whether every block index entry has been checked\n"
+            "  \"total\": xxxxx,           (numeric) number of block index entries to check\n"
+            "  \"checked\": xxxxx,         (numeric) number of block index entries checked so far\n"
+            "  \"progress\": xxxxx,        (numeric) fraction of the entries checked so far\n"
+            "  \"failed\": xxxxx,          (numeric) number of entries whose PoW did not check out\n"
+            "  \"failedhashes\": [         (array) the first failing block hashes\n"
+            "    \"hash\",                 (string) block hash\n"
+            "    ...\n"
+            "  ]\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getblockindexaudit", "")
+            + HelpExampleRpc("getblockindexaudit", "")
+        );
+    }
+
+    CBlockIndexAuditProgress progress = GetBlockIndexAuditProgress();
+
+    UniValue failed(UniValue::VARR);
+    for (const uint256& hash : progress.vFailed)
+        failed.push_back(hash.GetHex());
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("started", progress.fStarted));
+    ret.push_back(Pair("done", progress.fDone));
+    ret.push_back(Pair("total", (uint64_t)progress.nTotal));
+    ret.push_back(Pair("checked", (uint64_t)progress.nChecked));
+    ret.push_back(Pair("progress", progress.nTotal ? (double)progress.nChecked / progress.nTotal : 0.0));
+    ret.push_back(Pair("failed", (uint64_t)progress.nFailed));
+    ret.push_back(Pair("failedhashes", failed));
+    return ret;
+}
+
 static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
@@ -2187,6 +2230,7 @@ static const CRPCCommand commands[] =
     { "blockchain", "getblock", &getblock, {"blockhash","verbosity|verbose"} },
     { "blockchain", "getblockdeltas", &getblockdeltas,  {} },
     { "blockchain", "getblockhashes", &getblockhashes, {} },
+    { "blockchain", "getblockindexaudit", &getblockindexaudit, {} },
     { "blockchain", "getblockhash", &getblockhash, {"height"}},
     { "blockchain", "getblockheader", &getblockheader, {"blockhash","verbose"} },
     { "blockchain", "getchaintips", &getchaintips, {} },
@@ -65,6 +65,8 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "listassets", 1, "verbose" },
     { "listassets", 2, "count" },
     { "listassets", 3, "start" },
+    { "listassetspage", 1, "verbose" },
+    { "listassetspage", 2, "count" },
     { "setmocktime", 0, "timestamp" },
     { "generate", 0, "nblocks" },
     { "generate", 1, "maxtries" },
@@ -220,7 +222,9 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "getsnapshot", 1, "block_height"},
     { "purgesnapshot", 1, "block_height"},
     { "stop", 0, "wait"},
-    { "getkawpowhash", 3, "height"}
+    { "getkawpowhash", 3, "height"},
+    { "getsmartcontractjob", 0, "id"},
+    { "getsmartcontractresult", 0, "id"}
 };
 
 class CRPCConvertTable
@@ -269,20 +273,22 @@ UniValue ParseNonRFCJSONValue(const std::string& strVal)
     return jVal[0];
 }
 
+UniValue RPCConvertValue(const std::string& strMethod, int idx, const std::string& strVal)
+{
+    if (!rpcCvtTable.convert(strMethod, idx)) {
+        // insert string value directly
+        return UniValue(strVal);
+    }
+    // parse string as JSON, insert bool/number/object/etc. value
+    return ParseNonRFCJSONValue(strVal);
+}
+
 UniValue RPCConvertValues(const std::string& strMethod, const std::vector<std::string>& strParams)
 {
     UniValue params(UniValue::VARR);
 
     for (unsigned int idx = 0; idx < strParams.size(); idx++) {
-        const std::string& strVal = strParams[idx];
-
-        if (!rpcCvtTable.convert(strMethod, idx)) {
-            // insert string value directly
-            params.push_back(strVal);
-        } else {
-            // parse string as JSON, insert bool/number/object/etc. value
-            params.push_back(ParseNonRFCJSONValue(strVal));
-        }
+        params.push_back(RPCConvertValue(strMethod, idx, strParams[idx]));
     }
 
     return params;
@@ -11,6 +11,9 @@
 #include <vector>
 #include <univalue.h>
 
+/** Convert one positional argument to command-specific RPC representation */
+UniValue RPCConvertValue(const std::string& strMethod, int idx, const std::string& strVal);
+
 /** Convert positional arguments to command-specific RPC representation */
 UniValue RPCConvertValues(const std::string& strMethod, const std::vector<std::string>& strParams);
 
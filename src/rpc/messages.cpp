@@ -368,7 +368,7 @@ UniValue sendmessage(const JSONRPCRequest& request) {
     std::vector< std::pair<CAssetTransfer, std::string> >vTransfers;
 
     std::map<std::string, std::vector<COutput> > mapAssetCoins;
-    pwallet->AvailableAssets(mapAssetCoins);
+    pwallet->AvailableAssets(std::set<std::string>{asset_name}, mapAssetCoins);
 
     if (!mapAssetCoins.count(asset_name)) {
         throw JSONRPCError(RPC_INVALID_PARAMETER, std::string("Wallet doesn't own the asset_name: " + asset_name));
@@ -37,8 +37,6 @@
 #include <consensus/merkle.h>
 #include <crypto/ethash/include/ethash/progpow.hpp>
 
-extern uint64_t nHashesPerSec;
-
 unsigned int ParseConfirmTarget(const UniValue& value)
 {
     int target = value.get_int();
@@ -174,7 +172,11 @@ UniValue generateBlocks(std::shared_ptr<CReserveScript> coinbaseScript, int nGen
             LOCK(cs_main);
             IncrementExtraNonce(pblock, chainActive.Tip(), nExtraNonce);
         }
-        while (nMaxTries > 0 && pblock->nNonce < nInnerLoopCount && !CheckProofOfWork(pblock->GetBlockHeader(), Params().GetConsensus())) {
+        // Hash candidates directly rather than through GetHash(), which would
+        // put every rejected nonce into the PoW cache
+        CPoWHasher hasher;
+        hasher.Reset(*pblock);
+        while (nMaxTries > 0 && pblock->nNonce < nInnerLoopCount && !CheckProofOfWork(*pblock, hasher.Hash(*pblock), Params().GetConsensus())) {
             ++pblock->nNonce;
             --nMaxTries;
         }
@@ -263,6 +265,7 @@ static UniValue getmininginfo(const JSONRPCRequest& request)
             "  \"difficulty_algorithm\": x.x (numeric) the current difficulty for Dual_Algo once activated per algorithm\n"
             "  \"networkhashps\": nnn,      (numeric) The network hashes per second\n"
             "  \"hashespersec\": nnn,       (numeric) The hashes per second of built-in miner\n"
+            "  \"threadhashespersec\": [nnn,...], (array) The hashes per second of each built-in miner thread\n"
             "  \"pooledtx\": n              (numeric) The size of the mempool\n"
             "  \"chain\": \"xxxx\",           (string) current network name as defined in BIP70 (main, test, regtest)\n"
             "  \"warnings\": \"...\"          (string) any network and blockchain warnings\n"
@@ -301,7 +304,14 @@ static UniValue getmininginfo(const JSONRPCRequest& request)
     if (IsDualAlgoEnabled(chainActive.Tip(), Params().GetConsensus())) {
         obj.push_back(Pair("networkhashps_soterg", GetNetworkHashPS(5, -1, POW_TYPE_SOTERG)));
     }
-    obj.push_back(Pair("hashespersec",     (uint64_t)nHashesPerSec));
+    uint64_t nHashesPerSec = 0;
+    UniValue threadHashesPerSec(UniValue::VARR);
+    for (uint64_t nThreadHashesPerSec : GetMinerThreadHashesPerSec()) {
+        nHashesPerSec += nThreadHashesPerSec;
+        threadHashesPerSec.push_back(nThreadHashesPerSec);
+    }
+    obj.push_back(Pair("hashespersec",     nHashesPerSec));
+    obj.push_back(Pair("threadhashespersec", threadHashesPerSec));
     obj.push_back(Pair("pooledtx",         (uint64_t)mempool.size()));
     obj.push_back(Pair("chain", Params().NetworkIDString()));
     if (IsDeprecatedRPCEnabled("getmininginfo")) {
@@ -345,6 +355,8 @@ static UniValue prioritisetransaction(const JSONRPCRequest& request)
     }
 
     mempool.PrioritiseTransaction(hash, nAmount);
+    if (g_blockTemplateCache)
+        g_blockTemplateCache->Invalidate();
     return true;
 }
 
@@ -377,6 +389,69 @@ static std::string gbt_vb_name(const Consensus::DeploymentPos pos) {
     return s;
 }
 
+static uint64_t GetTemplateChangeCount()
+{
+    return g_blockTemplateCache ? g_blockTemplateCache->GetChangeCount() : mempool.GetTransactionsUpdated();
+}
+
+/** The "transactions" of a getblocktemplate result, encoded once per template. Valid while cs_main is held. */
+static const UniValue& TemplateTransactionsToJSON(const std::shared_ptr<const CBlockTemplate>& pblocktemplate)
+{
+    static std::shared_ptr<const CBlockTemplate> pblocktemplateCached;
+    static UniValue transactionsCached;
+    AssertLockHeld(cs_main);
+    if (pblocktemplate == pblocktemplateCached)
+        return transactionsCached;
+
+    // Encode straight into the cache, which matches no template until it is complete
+    UniValue& transactions = transactionsCached;
+    pblocktemplateCached.reset();
+
+    // NOTE: If at some point we support pre-segwit miners post-segwit-activation, this needs to take segwit support into consideration
+    const bool fPreSegWit = false; //(THRESHOLD_ACTIVE != VersionBitsState(pindexPrev, consensusParams, Consensus::DEPLOYMENT_SEGWIT, versionbitscache));
+
+    transactions.setArray();
+    std::map<uint256, int64_t> setTxIndex;
+    int i = 0;
+    for (const auto& it : pblocktemplate->block.vtx) {
+        const CTransaction& tx = *it;
+        uint256 txHash = tx.GetHash();
+        setTxIndex[txHash] = i++;
+
+        if (tx.IsCoinBase())
+            continue;
+
+        UniValue entry(UniValue::VOBJ);
+
+        entry.push_back(Pair("data", EncodeHexTx(tx)));
+        entry.push_back(Pair("txid", txHash.GetHex()));
+        entry.push_back(Pair("hash", tx.GetWitnessHash().GetHex()));
+
+        UniValue deps(UniValue::VARR);
+        for (const CTxIn &in : tx.vin)
+        {
+            if (setTxIndex.count(in.prevout.hash))
+                deps.push_back(setTxIndex[in.prevout.hash]);
+        }
+        entry.push_back(Pair("depends", deps));
+
+        int index_in_template = i - 1;
+        entry.push_back(Pair("fee", pblocktemplate->vTxFees[index_in_template]));
+        int64_t nTxSigOps = pblocktemplate->vTxSigOpsCost[index_in_template];
+        if (fPreSegWit) {
+            assert(nTxSigOps % WITNESS_SCALE_FACTOR == 0);
+            nTxSigOps /= WITNESS_SCALE_FACTOR;
+        }
+        entry.push_back(Pair("sigops", nTxSigOps));
+        entry.push_back(Pair("weight", GetTransactionWeight(tx)));
+
+        transactions.push_back(entry);
+    }
+
+    pblocktemplateCached = pblocktemplate;
+    return transactions;
+}
+
 UniValue getblocktemplate(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() > 1)
@@ -451,7 +526,11 @@ UniValue getblocktemplate(const JSONRPCRequest& request)
             "  \"weightlimit\" : n,                (numeric) limit of block weight\n"
             "  \"curtime\" : ttt,                  (numeric) current timestamp in seconds since epoch (Jan 1 1970 GMT)\n"
             "  \"bits\" : \"xxxxxxxx\",              (string) compressed target of next block\n"
-            "  \"height\" : n                      (numeric) The height of the next block\n"
+            "  \"height\" : n,                     (numeric) The height of the next block\n"
+            "  \"powhashchain\" : [                 (array, X12R and X12ST only) The hash functions the PoW hash of a header with curtime chains, in order.\n"
+            "     \"name\"                           (string) The first one takes the whole header, so its state after the 76 bytes before the nonce can be kept per template\n"
+            "     ,...\n"
+            "  ]\n"
             "}\n"
 
             "\nExamples:\n"
@@ -553,28 +632,27 @@ UniValue getblocktemplate(const JSONRPCRequest& request)
     if (IsInitialBlockDownload())
         throw JSONRPCError(RPC_CLIENT_IN_INITIAL_DOWNLOAD, "Soteria is downloading blocks...");
 
-    static unsigned int nTransactionsUpdatedLast;
-
     if (!lpval.isNull())
     {
-        // Wait to respond until either the best block changes, OR a minute has passed and there are more transactions
+        // Wait to respond until either the best block changes, OR a minute has passed and the
+        // mempool changed in a way that could alter the template
         uint256 hashWatchedChain;
         boost::system_time checktxtime;
-        unsigned int nTransactionsUpdatedLastLP;
+        uint64_t nTemplateChangesLP;
 
         if (lpval.isStr())
         {
-            // Format: <hashBestChain><nTransactionsUpdatedLast>
+            // Format: <hashBestChain><template change count>
             std::string lpstr = lpval.get_str();
 
             hashWatchedChain.SetHex(lpstr.substr(0, 64));
-            nTransactionsUpdatedLastLP = atoi64(lpstr.substr(64));
+            nTemplateChangesLP = atoi64(lpstr.substr(64));
         }
         else
         {
             // NOTE: Spec does not specify behaviour for non-string longpollid, but this makes testing easier
             hashWatchedChain = chainActive.Tip()->GetBlockHash();
-            nTransactionsUpdatedLastLP = nTransactionsUpdatedLast;
+            nTemplateChangesLP = GetTemplateChangeCount();
         }
 
         // Release the wallet and main lock while waiting
@@ -588,7 +666,7 @@ UniValue getblocktemplate(const JSONRPCRequest& request)
                 if (!cvBlockChange.timed_wait(lock, checktxtime))
                 {
                     // Timeout: Check transactions for update
-                    if (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLastLP)
+                    if (GetTemplateChangeCount() != nTemplateChangesLP)
                         break;
                     checktxtime += boost::posix_time::seconds(10);
                 }
@@ -608,26 +686,14 @@ UniValue getblocktemplate(const JSONRPCRequest& request)
     bool fSupportsSegwit = Params().GetConsensus().nSegwitEnabled;
 
     // Update block
-    static CBlockIndex* pindexPrev;
-    static int64_t nStart;
-    static std::unique_ptr<CBlockTemplate> pblocktemplate;
-    // Cache whether the last invocation was with segwit support, to avoid returning
-    // a segwit-block to a non-segwit caller.
-    static bool fLastTemplateSupportsSegwit = true;
-    static POW_TYPE lastPowType = NUM_BLOCK_TYPES;
-    if (pindexPrev != chainActive.Tip() ||
-        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > 5) ||
-        fLastTemplateSupportsSegwit != fSupportsSegwit ||
-        lastPowType != powType) // Dual algo: Include powType check in cache refresh condition
+    CBlockIndex* pindexPrev = chainActive.Tip();
+    uint64_t nTemplateChanges = GetTemplateChangeCount();
+    std::shared_ptr<const CBlockTemplate> pblocktemplate;
+    if (g_blockTemplateCache)
+        pblocktemplate = g_blockTemplateCache->Get(pindexPrev, powType, fSupportsSegwit, GetTime());
+    if (!pblocktemplate)
     {
-        // Clear pindexPrev so future calls make a new block, despite any failures from here on
-        pindexPrev = nullptr;
-
-        // Store the pindexBest used before CreateNewBlock, to avoid races
-        nTransactionsUpdatedLast = mempool.GetTransactionsUpdated();
-        CBlockIndex* pindexPrevNew = chainActive.Tip();
-        nStart = GetTime();
-        fLastTemplateSupportsSegwit = fSupportsSegwit;
+        nTemplateChanges = GetTemplateChangeCount();
 
 // Create new block, Get mining address if it is set
 // CScript scriptDummy = CScript() << OP_TRUE;
@@ -654,69 +720,35 @@ if (!address.empty()) {
 }
 
 pblocktemplate = BlockAssembler(Params()).CreateNewBlock(script, fSupportsSegwit, powType); // Dual algo: Include powType       
-lastPowType = powType;   // Dual algo: Cache pow type just requested        
         
         if (!pblocktemplate)
             throw JSONRPCError(RPC_OUT_OF_MEMORY, "Out of memory");
 
-        // Need to update only after we know CreateNewBlock succeeded
-        pindexPrev = pindexPrevNew;
+        if (g_blockTemplateCache)
+            g_blockTemplateCache->Set(pblocktemplate, pindexPrev, powType, fSupportsSegwit, GetTime());
     }
-    CBlock* pblock = &pblocktemplate->block; // pointer for convenience
+    // The template may be shared with other callers, so per call changes go to a copy of its header
+    CBlockHeader header = pblocktemplate->block.GetBlockHeader();
+    CBlockHeader* pblock = &header;
+    const CTransactionRef& coinbaseTx = pblocktemplate->block.vtx[0];
     const Consensus::ConsensusParams& consensusParams = Params().GetConsensus();
 
     // Update nTime
     UpdateTime(pblock, consensusParams, pindexPrev, powType);
     pblock->nNonce = 0;
 
-    // NOTE: If at some point we support pre-segwit miners post-segwit-activation, this needs to take segwit support into consideration
-    const bool fPreSegWit = false; //(THRESHOLD_ACTIVE != VersionBitsState(pindexPrev, consensusParams, Consensus::DEPLOYMENT_SEGWIT, versionbitscache));
-
     UniValue aCaps(UniValue::VARR); aCaps.push_back("proposal");
 
-    UniValue transactions(UniValue::VARR);
-    std::map<uint256, int64_t> setTxIndex;
-    int i = 0;
-    for (const auto& it : pblock->vtx) {
-        const CTransaction& tx = *it;
-        uint256 txHash = tx.GetHash();
-        setTxIndex[txHash] = i++;
-
-        if (tx.IsCoinBase())
-            continue;
-
-        UniValue entry(UniValue::VOBJ);
-
-        entry.push_back(Pair("data", EncodeHexTx(tx)));
-        entry.push_back(Pair("txid", txHash.GetHex()));
-        entry.push_back(Pair("hash", tx.GetWitnessHash().GetHex()));
-
-        UniValue deps(UniValue::VARR);
-        for (const CTxIn &in : tx.vin)
-        {
-            if (setTxIndex.count(in.prevout.hash))
-                deps.push_back(setTxIndex[in.prevout.hash]);
-        }
-        entry.push_back(Pair("depends", deps));
-
-        int index_in_template = i - 1;
-        entry.push_back(Pair("fee", pblocktemplate->vTxFees[index_in_template]));
-        int64_t nTxSigOps = pblocktemplate->vTxSigOpsCost[index_in_template];
-        if (fPreSegWit) {
-            assert(nTxSigOps % WITNESS_SCALE_FACTOR == 0);
-            nTxSigOps /= WITNESS_SCALE_FACTOR;
-        }
-        entry.push_back(Pair("sigops", nTxSigOps));
-        entry.push_back(Pair("weight", GetTransactionWeight(tx)));
-
-        transactions.push_back(entry);
-    }
+    const UniValue& transactions = TemplateTransactionsToJSON(pblocktemplate);
 
     UniValue aux(UniValue::VOBJ);
     aux.push_back(Pair("flags", HexStr(COINBASE_FLAGS.begin(), COINBASE_FLAGS.end())));
 
     arith_uint256 hashTarget = arith_uint256().SetCompact(pblock->nBits);
 
+    // NOTE: If at some point we support pre-segwit miners post-segwit-activation, this needs to take segwit support into consideration
+    const bool fPreSegWit = false;
+
     UniValue aMutable(UniValue::VARR);
     aMutable.push_back("time");
     aMutable.push_back("transactions");
@@ -794,12 +826,13 @@ lastPowType = powType;   // Dual algo: Cache pow type just requested
     }
 
     result.push_back(Pair("previousblockhash", pblock->hashPrevBlock.GetHex()));
-    result.push_back(Pair("transactions", transactions));
+    // The one copy of the cached transactions the result has to own
+    result.pushKV("transactions", transactions);
     result.push_back(Pair("coinbaseaux", aux));
-    result.push_back(Pair("coinbasevalue", (int64_t)pblock->vtx[0]->vout[0].nValue));
+    result.push_back(Pair("coinbasevalue", (int64_t)coinbaseTx->vout[0].nValue));
     result.push_back(Pair("FoundationReserveAddress", Params().FoundationReserveAddress()));
-    result.push_back(Pair("FoundationReserveValue", (int64_t)pblock->vtx[0]->vout[1].nValue) );
-    result.push_back(Pair("longpollid", chainActive.Tip()->GetBlockHash().GetHex() + i64tostr(nTransactionsUpdatedLast)));
+    result.push_back(Pair("FoundationReserveValue", (int64_t)coinbaseTx->vout[1].nValue) );
+    result.push_back(Pair("longpollid", chainActive.Tip()->GetBlockHash().GetHex() + i64tostr(nTemplateChanges)));
     result.push_back(Pair("target", hashTarget.GetHex()));
     result.push_back(Pair("mintime", (int64_t)pindexPrev->GetMedianTimePast()+1));
     result.push_back(Pair("mutable", aMutable));
@@ -826,6 +859,14 @@ lastPowType = powType;   // Dual algo: Cache pow type just requested
     result.push_back(Pair("bits", strprintf("%08x", pblock->nBits)));
     result.push_back(Pair("height", (int64_t)(pindexPrev->nHeight+1)));
 
+    CPoWHasher hasher;
+    hasher.Reset(*pblock);
+    UniValue powHashChain(UniValue::VARR);
+    for (const std::string& strName : hasher.GetHashChain())
+        powHashChain.push_back(strName);
+    if (!powHashChain.empty())
+        result.push_back(Pair("powhashchain", powHashChain));
+
     if (!pblocktemplate->vchCoinbaseCommitment.empty() && fSupportsSegwit) {
         result.push_back(Pair("default_witness_commitment", HexStr(pblocktemplate->vchCoinbaseCommitment.begin(), pblocktemplate->vchCoinbaseCommitment.end())));
     }
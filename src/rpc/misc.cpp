@@ -8,6 +8,7 @@
 #include <base58.h>
 #include <chain.h>
 #include <clientversion.h>
+#include <compat/byteswap.h>
 #include <core_io.h>
 #include <init.h>
 #include <validation.h>
@@ -19,6 +20,7 @@
 #include <netbase.h>
 #include <rpc/blockchain.h>
 #include <rpc/server.h>
+#include <script/sigcache.h>
 #include <string>
 #include <txmempool.h>
 #include <timedata.h>
@@ -515,6 +517,16 @@ static UniValue RPCLockedMemoryInfo()
     return obj;
 }
 
+static UniValue RPCPQSignatureCacheInfo()
+{
+    PQSignatureCacheStats stats = GetPQSignatureCacheStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("hits", stats.nHits));
+    obj.push_back(Pair("misses", stats.nMisses));
+    obj.push_back(Pair("max_elements", uint64_t(stats.nMaxElements)));
+    return obj;
+}
+
 #ifdef HAVE_MALLOC_INFO
 static std::string RPCMallocInfo()
 {
@@ -556,6 +568,11 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
             "    \"locked\": xxxxxx,       (numeric) Amount of bytes that succeeded locking. If this number is smaller than total, locking pages failed at some point and key data could be swapped to disk.\n"
             "    \"chunks_used\": xxxxx,   (numeric) Number allocated chunks\n"
             "    \"chunks_free\": xxxxx,   (numeric) Number unused chunks\n"
+            "  },\n"
+            "  \"pqsigcache\": {           (json object) Cache of verified ML-DSA-44 (witness v2) signatures\n"
+            "    \"hits\": xxxxx,          (numeric) Number of verifications answered from the cache\n"
+            "    \"misses\": xxxxx,        (numeric) Number of verifications that ran ML-DSA-44\n"
+            "    \"max_elements\": xxxxx,  (numeric) Number of entries the cache can hold\n"
             "  }\n"
             "}\n"
             "\nResult (mode \"mallocinfo\"):\n"
@@ -567,6 +584,7 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.push_back(Pair("locked", RPCLockedMemoryInfo()));
+        obj.push_back(Pair("pqsigcache", RPCPQSignatureCacheInfo()));
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
@@ -719,6 +737,87 @@ bool timestampSort(std::pair<CMempoolAddressDeltaKey, CMempoolAddressDelta> a,
     return a.second.time < b.second.time;
 }
 
+//! Page size of getaddressdeltas/getaddresstxids when a cursor is given without a limit
+static const int DEFAULT_ADDRESS_PAGE_SIZE = 1000;
+
+/** Where a page of getaddressdeltas/getaddresstxids stopped, handed out hex encoded as "next" */
+struct CAddressIndexPageToken
+{
+    uint32_t nAddress; //!< position in the addresses argument (getaddressdeltas only)
+    int nHeight;
+    uint32_t nTxIndex;
+    uint32_t nIndex;
+    bool fSpending;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(nAddress);
+        READWRITE(nHeight);
+        READWRITE(nTxIndex);
+        READWRITE(nIndex);
+        READWRITE(fSpending);
+    }
+
+    CAddressIndexPageToken(uint32_t nAddressIn, const CAddressIndexKey& key) :
+        nAddress(nAddressIn), nHeight(key.blockHeight), nTxIndex(key.txindex), nIndex(key.index), fSpending(key.spending) {}
+
+    CAddressIndexPageToken() : nAddress(0), nHeight(0), nTxIndex(0), nIndex(0), fSpending(false) {}
+
+    //! Whether an entry of the same address comes after this position in index order.
+    //! The index is ordered by serialized key, where the output or input index is little endian,
+    //! so it is compared byte swapped; height and position in the block are big endian.
+    bool IsBefore(const CAddressIndexKey& key) const {
+        return std::make_tuple(nHeight, nTxIndex, bswap_32(nIndex), fSpending) <
+               std::make_tuple(key.blockHeight, key.txindex, bswap_32((uint32_t)key.index), key.spending);
+    }
+
+    std::string ToString() const {
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << *this;
+        return HexStr(ss.begin(), ss.end());
+    }
+};
+
+//! Decode a "cursor" argument. Returns false for "", the first page.
+static bool ParseAddressIndexPageToken(const UniValue& value, CAddressIndexPageToken& token)
+{
+    const std::string& strCursor = value.get_str();
+    if (strCursor.empty())
+        return false;
+    if (!IsHex(strCursor))
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+    std::vector<unsigned char> vData = ParseHex(strCursor);
+    CDataStream ss(vData, SER_NETWORK, PROTOCOL_VERSION);
+    try {
+        ss >> token;
+    } catch (const std::exception&) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+    }
+    if (!ss.empty() || token.nHeight < 0)
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+    return true;
+}
+
+static UniValue AddressDeltaToJSON(const CAddressIndexKey& key, CAmount nValue)
+{
+    std::string address;
+    if (!getAddressFromIndex(key.type, key.hashBytes, address)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+    }
+
+    UniValue delta(UniValue::VOBJ);
+    delta.push_back(Pair("assetName", key.asset));
+    delta.push_back(Pair("soterios", nValue));
+    delta.push_back(Pair("txid", key.txhash.GetHex()));
+    delta.push_back(Pair("index", (int)key.index));
+    delta.push_back(Pair("blockindex", (int)key.txindex));
+    delta.push_back(Pair("height", key.blockHeight));
+    delta.push_back(Pair("address", address));
+    return delta;
+}
+
 UniValue getaddressmempool(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() > 2)
@@ -968,6 +1067,8 @@ UniValue getaddressdeltas(const JSONRPCRequest& request)
             "  \"assetName\"   (string, optional) Get deltas for a particular asset instead of SOTER.\n"
             "  \"limit\"       (number, optional, default 0) Maximum number of deltas to return (0 = no limit)\n"
             "  \"offset\"      (number, optional, default 0) Number of deltas to skip\n"
+            "  \"cursor\"      (string, optional) \"\" for the first page, or the \"next\" value of the previous page.\n"
+            "                  Pages hold up to \"limit\" deltas (default 1000) and are read without loading the whole history.\n"
             "}\n"
             "\nResult:\n"
             "[\n"
@@ -980,11 +1081,17 @@ UniValue getaddressdeltas(const JSONRPCRequest& request)
             "    \"address\"  (string) The base58check encoded address\n"
             "  }\n"
             "]\n"
+            "\nResult (with cursor):\n"
+            "{\n"
+            "  \"deltas\"  (array) The deltas as above\n"
+            "  \"next\"  (string or null) Cursor of the next page, null after the last page\n"
+            "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"]}'")
             + HelpExampleRpc("getaddressdeltas", "{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"]}")
             + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"],\"assetName\":\"MY_ASSET\"}'")
             + HelpExampleRpc("getaddressdeltas", "{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"],\"assetName\":\"MY_ASSET\"}")
+            + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"],\"cursor\":\"\"}'")
         );
 
 
@@ -1040,45 +1147,63 @@ UniValue getaddressdeltas(const JSONRPCRequest& request)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
     }
 
-    std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
-
-    for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
-        if (start > 0 && end > 0) {
-            if (!GetAddressIndex((*it).first, (*it).second, assetName, addressIndex, start, end)) {
+    UniValue cursorParam = find_value(request.params[0].get_obj(), "cursor");
+    if (!cursorParam.isNull()) {
+        CAddressIndexPageToken token;
+        bool fResume = ParseAddressIndexPageToken(cursorParam, token);
+        if (fResume && token.nAddress >= addresses.size())
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+        size_t nPageSize = limit > 0 ? limit : DEFAULT_ADDRESS_PAGE_SIZE;
+
+        UniValue deltas(UniValue::VARR);
+        UniValue next;
+        // The last entry returned and its address, which a page that fills up
+        // exactly at the end of an address still has to resume after
+        CAddressIndexKey last;
+        size_t nLastAddress = 0;
+        for (size_t i = fResume ? token.nAddress : 0; i < addresses.size() && next.isNull(); i++) {
+            bool fSameAddress = fResume && i == token.nAddress;
+            std::unique_ptr<CAddressIndexCursor> pcursor;
+            if (!GetAddressIndexCursor(addresses[i].first, addresses[i].second, assetName, pcursor, fSameAddress ? std::max(start, token.nHeight) : start, end)) {
                 throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
             }
-        } else {
-            if (!GetAddressIndex((*it).first, (*it).second, assetName, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+            for (; pcursor->Valid(); pcursor->Next()) {
+                if (fSameAddress && !token.IsBefore(pcursor->GetKey()))
+                    continue;
+                if (deltas.size() == nPageSize) {
+                    next = CAddressIndexPageToken(nLastAddress, last).ToString();
+                    break;
+                }
+                deltas.push_back(AddressDeltaToJSON(pcursor->GetKey(), pcursor->GetValue()));
+                last = pcursor->GetKey();
+                nLastAddress = i;
             }
         }
-    }
 
-    UniValue deltas(UniValue::VARR);
-
-    size_t startIdx = (size_t)offset;
-    size_t endIdx = (limit > 0) ? std::min((size_t)offset + limit, addressIndex.size()) : addressIndex.size();
-
-    if (startIdx > addressIndex.size()) {
-        startIdx = addressIndex.size();
+        UniValue result(UniValue::VOBJ);
+        result.push_back(Pair("deltas", deltas));
+        result.push_back(Pair("next", next));
+        return result;
     }
 
-    for (size_t idx = startIdx; idx < endIdx; idx++) {
-        std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = addressIndex.begin() + idx;
-        std::string address;
-        if (!getAddressFromIndex(it->first.type, it->first.hashBytes, address)) {
-            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+    // Stream the entries, keeping only the requested window. Past it they are only counted, and only if the total is returned.
+    const bool fCountTotal = includeChainInfo && start > 0 && end > 0;
+    UniValue deltas(UniValue::VARR);
+    size_t nTotal = 0;
+    for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
+        std::unique_ptr<CAddressIndexCursor> pcursor;
+        if (!GetAddressIndexCursor((*it).first, (*it).second, assetName, pcursor, start, end)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+        }
+        for (; pcursor->Valid(); pcursor->Next(), nTotal++) {
+            if (limit > 0 && deltas.size() >= (size_t)limit) {
+                if (!fCountTotal)
+                    break;
+                continue;
+            }
+            if (nTotal >= (size_t)offset)
+                deltas.push_back(AddressDeltaToJSON(pcursor->GetKey(), pcursor->GetValue()));
         }
-
-        UniValue delta(UniValue::VOBJ);
-        delta.push_back(Pair("assetName", it->first.asset));
-        delta.push_back(Pair("soterios", it->second));
-        delta.push_back(Pair("txid", it->first.txhash.GetHex()));
-        delta.push_back(Pair("index", (int)it->first.index));
-        delta.push_back(Pair("blockindex", (int)it->first.txindex));
-        delta.push_back(Pair("height", it->first.blockHeight));
-        delta.push_back(Pair("address", address));
-        deltas.push_back(delta);
     }
 
     UniValue result(UniValue::VOBJ);
@@ -1103,7 +1228,7 @@ UniValue getaddressdeltas(const JSONRPCRequest& request)
         endInfo.push_back(Pair("height", end));
 
         result.push_back(Pair("deltas", deltas));
-        result.push_back(Pair("total", (int)addressIndex.size()));
+        result.push_back(Pair("total", (int)nTotal));
         result.push_back(Pair("limit", limit));
         result.push_back(Pair("offset", offset));
         result.push_back(Pair("start", startInfo));
@@ -1166,27 +1291,18 @@ UniValue getaddressbalance(const JSONRPCRequest& request)
         if (!AreAssetsDeployed())
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Assets aren't active.  includeAssets can't be true.");
 
-        std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
-
-        for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        }
-
         // assetName -> (received, balance)
         std::map<std::string, std::pair<CAmount, CAmount>> balances;
 
-        for (std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = addressIndex.begin();
-            it != addressIndex.end(); it++) {
-            std::string assetName = it->first.asset;
-            if (balances.count(assetName) == 0) {
-                balances[assetName] = std::make_pair(0, 0);
+        for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
+            std::vector<std::pair<std::string, CAddressBalanceValue>> addressBalances;
+            if (!GetAddressBalance((*it).first, (*it).second, addressBalances)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
             }
-            if (it->second > 0) {
-                balances[assetName].first += it->second;
+            for (const auto& addressBalance : addressBalances) {
+                balances[addressBalance.first].first += addressBalance.second.received;
+                balances[addressBalance.first].second += addressBalance.second.balance;
             }
-            balances[assetName].second += it->second;
         }
 
         UniValue result(UniValue::VARR);
@@ -1203,23 +1319,16 @@ UniValue getaddressbalance(const JSONRPCRequest& request)
         return result;
 
     } else {
-        std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
-
-        for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
-            if (!GetAddressIndex((*it).first, (*it).second, SOTER, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        }
-
         CAmount balance = 0;
         uint64_t received = 0;
 
-        for (std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = addressIndex.begin();
-            it != addressIndex.end(); it++) {
-            if (it->second > 0) {
-                received += it->second;
+        for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
+            CAddressBalanceValue addressBalance;
+            if (!GetAddressBalance((*it).first, (*it).second, SOTER, addressBalance)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
             }
-            balance += it->second;
+            received += addressBalance.received;
+            balance += addressBalance.balance;
         }
 
         UniValue result(UniValue::VOBJ);
@@ -1247,6 +1356,9 @@ UniValue getaddresstxids(const JSONRPCRequest& request)
             "  \"end\" (number, optional) The end block height\n"
             "  \"limit\"       (number, optional, default 0) Maximum number of transactions to return (0 = no limit)\n"
             "  \"offset\"      (number, optional, default 0) Number of transactions to skip\n"
+            "  \"cursor\"      (string, optional) \"\" for the first page, or the \"next\" value of the previous page.\n"
+            "                  Pages hold up to \"limit\" txids (default 1000) in (height, block position) order\n"
+            "                  and are read without loading the whole history.\n"
             "},\n"
             "\"includeAssets\" (boolean, optional, default false)  If true this will return an expanded result which includes asset transactions\n"
             "\nResult:\n"
@@ -1254,6 +1366,11 @@ UniValue getaddresstxids(const JSONRPCRequest& request)
             "  \"transactionid\"  (string) The transaction id\n"
             "  ,...\n"
             "]\n"
+            "\nResult (with cursor):\n"
+            "{\n"
+            "  \"txids\"  (array) The transaction ids\n"
+            "  \"next\"  (string or null) Cursor of the next page, null after the last page\n"
+            "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddresstxids", "'{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"]}'")
             + HelpExampleRpc("getaddresstxids", "{\"addresses\": [\"SMy5NT6Qzfwsb6chSks284xugJfcWGhQU7\"]}")
@@ -1302,6 +1419,64 @@ UniValue getaddresstxids(const JSONRPCRequest& request)
         if (!AreAssetsDeployed())
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Assets aren't active.  includeAssets can't be true.");
 
+    UniValue cursorParam = request.params[0].isObject() ? find_value(request.params[0].get_obj(), "cursor") : NullUniValue;
+    if (!cursorParam.isNull()) {
+        CAddressIndexPageToken token;
+        bool fResume = ParseAddressIndexPageToken(cursorParam, token);
+        size_t nPageSize = limit > 0 ? limit : DEFAULT_ADDRESS_PAGE_SIZE;
+
+        // One cursor per address and asset, merged by position in the chain
+        std::vector<std::unique_ptr<CAddressIndexCursor>> vCursors;
+        for (const auto& address : addresses) {
+            std::vector<std::string> assetNames;
+            if (includeAssets) {
+                if (!GetAddressIndexAssets(address.first, address.second, assetNames))
+                    throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+            } else {
+                assetNames.push_back(SOTER);
+            }
+            for (const std::string& assetName : assetNames) {
+                std::unique_ptr<CAddressIndexCursor> pcursor;
+                if (!GetAddressIndexCursor(address.first, address.second, assetName, pcursor, fResume ? std::max(start, token.nHeight) : start, end))
+                    throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+                while (fResume && pcursor->Valid() && std::make_pair(pcursor->GetKey().blockHeight, pcursor->GetKey().txindex) <= std::make_pair(token.nHeight, token.nTxIndex))
+                    pcursor->Next();
+                vCursors.push_back(std::move(pcursor));
+            }
+        }
+
+        UniValue txids(UniValue::VARR);
+        UniValue next;
+        CAddressIndexKey last;
+        while (true) {
+            CAddressIndexCursor* pmin = nullptr;
+            for (const auto& pcursor : vCursors) {
+                if (pcursor->Valid() && (!pmin || std::make_pair(pcursor->GetKey().blockHeight, pcursor->GetKey().txindex) <
+                                                   std::make_pair(pmin->GetKey().blockHeight, pmin->GetKey().txindex)))
+                    pmin = pcursor.get();
+            }
+            if (!pmin)
+                break;
+            if (txids.size() == nPageSize) {
+                next = CAddressIndexPageToken(0, last).ToString();
+                break;
+            }
+            last = pmin->GetKey();
+            txids.push_back(last.txhash.GetHex());
+
+            // Every entry of this transaction, for any of the addresses and assets, has been covered
+            for (const auto& pcursor : vCursors) {
+                while (pcursor->Valid() && pcursor->GetKey().blockHeight == last.blockHeight && pcursor->GetKey().txindex == last.txindex)
+                    pcursor->Next();
+            }
+        }
+
+        UniValue result(UniValue::VOBJ);
+        result.push_back(Pair("txids", txids));
+        result.push_back(Pair("next", next));
+        return result;
+    }
+
     std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
 
     for (std::vector<std::pair<uint160, int>>::iterator it = addresses.begin(); it != addresses.end(); it++) {
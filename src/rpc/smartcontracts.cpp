@@ -5,6 +5,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "rpc/smartcontracts.h"
+#include "smartcontracts/contractexecutor.h"
 #include "smartcontracts/smartcontracts.h"
 #include "rpc/server.h"
 #include "validation.h"
@@ -19,6 +20,36 @@
 
 namespace fs = boost::filesystem;
 
+static const std::string SMART_CONTRACTS_DISABLED = "Smart Plans are experimental and prone to bugs. Please take precautions when using this feature. To enable, launch Soteria with the -smartcontracts flag.";
+
+/* Path of the contract named by the first parameter; the parameters after the function become args */
+static fs::path GetSmartContractPath(const JSONRPCRequest& request, std::vector<std::string>& args)
+{
+    for (size_t i = 2; i < request.params.size(); i++) {
+        args.push_back(request.params[i].get_str());
+    }
+
+    // Ensure the directory exists ——
+    fs::path smartDir = GetDataDir(false) / "smartcontracts";
+    if (!fs::exists(smartDir)) {
+        fs::create_directories(smartDir);
+    }
+    // Build the full path to <datadir>
+    fs::path path = smartDir / (request.params[0].get_str() + ".lua");
+    if (!fs::exists(path))
+        throw JSONRPCError(RPC_MISC_ERROR, "Smart plan does not exist.");
+    return path;
+}
+
+static UniValue SmartContractResultToJSON(const SmartContractResult& result)
+{
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("result", result.result);
+    ret.pushKV("gas", result.gas);
+    ret.pushKV("memory", (uint64_t)result.memory);
+    return ret;
+}
+
 UniValue call_smartcontract(const JSONRPCRequest& request)
 {
     if (!AreSmartContractsDeployed())
@@ -34,47 +65,143 @@ UniValue call_smartcontract(const JSONRPCRequest& request)
             "2. function           (string, required) Lua function.\n"
             "3. args               (string, not needed) Lua args.\n"
             "\nResult:\n"
-            "1.    (string) Result from called function\n"
+            "{\n"
+            "  \"result\" : \"result\",   (string) Result from called function\n"
+            "  \"gas\" : n,              (numeric) Lua instructions the call executed, counted in steps of 1000\n"
+            "  \"memory\" : n,           (numeric) Peak memory the call allocated, in bytes\n"
+            "}\n"
             "\nExamples:\n" +
             HelpExampleCli("call_smartcontract", "\"social\" \"getLikes\"") + HelpExampleRpc("call_smartcontract", "\"social\" \"getLikes\""));
 
-    LOCK(cs_main);
-    // Build args vector and filename
-    if (gArgs.IsArgSet("-smartcontracts")) {
-        std::vector<std::string> args = {};
-        std::string file = request.params[0].get_str() + ".lua";
+    // Contracts take the locks they need through the RPC calls they make
+    if (!gArgs.IsArgSet("-smartcontracts"))
+        throw JSONRPCError(RPC_MISC_ERROR, SMART_CONTRACTS_DISABLED);
 
-        for (size_t i = 0; i < request.params.size(); i++) {
-            args.push_back(request.params[i].get_str());
-        }
+    std::vector<std::string> args;
+    fs::path path = GetSmartContractPath(request, args);
 
-        // Remove first two entries (smartcontract_name & function)
-        args.erase(args.begin());
-        args.erase(args.begin());
-        
-        // Ensure the directory exists ——
-        fs::path smartDir = GetDataDir(false) / "smartcontracts";        
-        if (!fs::exists(smartDir)) {
-            fs::create_directories(smartDir);
-        }   
-        // Build the full path to <datadir>    
-        fs::path path = smartDir / file; // Would use std::string overload so no need to use const char* 
-
-        // Run the smart contract
-        SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), request.params[1].get_str().c_str(), args);
-        // Check if the file actually exists
-        if (fs::exists(path)) {
-            if (result.is_error) {
-                throw JSONRPCError(RPC_MISC_ERROR, result.result);
-            } else {
-                return result.result;
-            }
-        } else {
-            throw JSONRPCError(RPC_MISC_ERROR, "Smart plan does not exist.");
-        }
-    } else {
-        throw JSONRPCError(RPC_MISC_ERROR, "Smart Plans are experimental and prone to bugs. Please take precautions when using this feature. To enable, launch Soteria with the -smartcontracts flag.");
+    // Run the smart contract
+    SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), request.params[1].get_str().c_str(), args);
+    if (result.is_error)
+        throw JSONRPCError(RPC_MISC_ERROR, result.result);
+    return SmartContractResultToJSON(result);
+}
+
+UniValue submit_smartcontract(const JSONRPCRequest& request)
+{
+    if (!AreSmartContractsDeployed())
+        throw std::runtime_error(
+            "Coming soon: Soteria smart contract function will be available in a future release.\n");
+
+    if (request.fHelp || request.params.size() < 2)
+        throw std::runtime_error(
+            "submitsmartcontract\n"
+            "\nQueue a call of an Soteria smart contract function on the smart contract threads.\n"
+            "Poll it with getsmartcontractjob and fetch its result with getsmartcontractresult.\n"
+            "\nArguments:\n"
+            "1. smartcontract_name    (string, required) Lua file.\n"
+            "2. function           (string, required) Lua function.\n"
+            "3. args               (string, not needed) Lua args.\n"
+            "\nResult:\n"
+            "n    (numeric) The job id\n"
+            "\nExamples:\n" +
+            HelpExampleCli("submitsmartcontract", "\"social\" \"getLikes\"") + HelpExampleRpc("submitsmartcontract", "\"social\" \"getLikes\""));
+
+    if (!gArgs.IsArgSet("-smartcontracts") || !g_contractExecutor)
+        throw JSONRPCError(RPC_MISC_ERROR, SMART_CONTRACTS_DISABLED);
+
+    std::vector<std::string> args;
+    fs::path path = GetSmartContractPath(request, args);
+
+    uint64_t nId;
+    if (!g_contractExecutor->Submit(request.params[0].get_str(), path.string(), request.params[1].get_str(), args, nId))
+        throw JSONRPCError(RPC_OUT_OF_MEMORY, "Smart contract queue is full, try again later.");
+    return nId;
+}
+
+static CContractJob GetContractJob(const UniValue& param)
+{
+    if (!g_contractExecutor)
+        throw JSONRPCError(RPC_MISC_ERROR, SMART_CONTRACTS_DISABLED);
+
+    CContractJob job;
+    int64_t nId = param.get_int64();
+    if (nId <= 0 || !g_contractExecutor->GetJob(nId, job))
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Unknown smart contract job id.");
+    return job;
+}
+
+UniValue get_smartcontractjob(const JSONRPCRequest& request)
+{
+    if (!AreSmartContractsDeployed())
+        throw std::runtime_error(
+            "Coming soon: Soteria smart contract function will be available in a future release.\n");
+
+    if (request.fHelp || request.params.size() != 1)
+        throw std::runtime_error(
+            "getsmartcontractjob id\n"
+            "\nReturns the state of a smart contract call queued with submitsmartcontract.\n"
+            "\nArguments:\n"
+            "1. id                 (numeric, required) The job id\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"id\" : n,               (numeric) The job id\n"
+            "  \"contract\" : \"name\",    (string) The smart contract\n"
+            "  \"function\" : \"name\",    (string) The called function\n"
+            "  \"status\" : \"status\",    (string) \"queued\", \"running\" or \"done\"\n"
+            "  \"submitted\" : ttt,      (numeric) Time the call was submitted\n"
+            "  \"started\" : ttt,        (numeric, optional) Time the call started running\n"
+            "  \"finished\" : ttt,       (numeric, optional) Time the call finished\n"
+            "  \"error\" : true|false,   (boolean, optional) Whether the call failed, once done\n"
+            "}\n"
+            "\nExamples:\n" +
+            HelpExampleCli("getsmartcontractjob", "1") + HelpExampleRpc("getsmartcontractjob", "1"));
+
+    CContractJob job = GetContractJob(request.params[0]);
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("id", job.nId);
+    ret.pushKV("contract", job.strContract);
+    ret.pushKV("function", job.strFunction);
+    ret.pushKV("status", job.StatusString());
+    ret.pushKV("submitted", job.nSubmitTime);
+    if (job.status != CContractJob::QUEUED)
+        ret.pushKV("started", job.nStartTime);
+    if (job.status == CContractJob::DONE) {
+        ret.pushKV("finished", job.nFinishTime);
+        ret.pushKV("error", job.result.is_error);
     }
+    return ret;
+}
+
+UniValue get_smartcontractresult(const JSONRPCRequest& request)
+{
+    if (!AreSmartContractsDeployed())
+        throw std::runtime_error(
+            "Coming soon: Soteria smart contract function will be available in a future release.\n");
+
+    if (request.fHelp || request.params.size() != 1)
+        throw std::runtime_error(
+            "getsmartcontractresult id\n"
+            "\nReturns the result of a finished smart contract call queued with submitsmartcontract,\n"
+            "or raises the error the call failed with.\n"
+            "\nArguments:\n"
+            "1. id                 (numeric, required) The job id\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"result\" : \"result\",   (string) Result from called function\n"
+            "  \"gas\" : n,              (numeric) Lua instructions the call executed, counted in steps of 1000\n"
+            "  \"memory\" : n,           (numeric) Peak memory the call allocated, in bytes\n"
+            "}\n"
+            "\nExamples:\n" +
+            HelpExampleCli("getsmartcontractresult", "1") + HelpExampleRpc("getsmartcontractresult", "1"));
+
+    CContractJob job = GetContractJob(request.params[0]);
+    if (job.status != CContractJob::DONE)
+        throw JSONRPCError(RPC_MISC_ERROR, strprintf("Smart contract job is %s.", job.StatusString()));
+    if (job.result.is_error)
+        throw JSONRPCError(RPC_MISC_ERROR, job.result.result);
+    return SmartContractResultToJSON(job.result);
 }
 
 UniValue list_smartcontracts(const JSONRPCRequest& request)
@@ -92,8 +219,6 @@ UniValue list_smartcontracts(const JSONRPCRequest& request)
             "\nExamples:\n" +
             HelpExampleCli("list_smartcontracts", "") + HelpExampleRpc("list_smartcontracts", ""));
 
-    LOCK(cs_main);
-
     if (gArgs.IsArgSet("-smartcontracts")) {
         UniValue plans(UniValue::VARR);
         for (const std::string& plan : CSoteriaSmartContracts::GetPlans()) {
@@ -101,7 +226,7 @@ UniValue list_smartcontracts(const JSONRPCRequest& request)
         }
         return plans;
     } else {
-        throw JSONRPCError(RPC_MISC_ERROR, "Smart Plans are experimental and prone to bugs. Please take precautions when using this feature. To enable, launch Soteria with the -smartcontracts flag.");
+        throw JSONRPCError(RPC_MISC_ERROR, SMART_CONTRACTS_DISABLED);
     }
 }
 
@@ -109,6 +234,9 @@ static const CRPCCommand commands[] =
     { //  category              name                      actor (function)         argNames
       //  --------------------- ------------------------  -----------------------  ----------
         {"smartcontracts",         "callsmartcontract",        &call_smartcontract,        {"smartcontract_name", "function", "args"}},
+        {"smartcontracts",         "submitsmartcontract",      &submit_smartcontract,      {"smartcontract_name", "function", "args"}},
+        {"smartcontracts",         "getsmartcontractjob",      &get_smartcontractjob,      {"id"}},
+        {"smartcontracts",         "getsmartcontractresult",   &get_smartcontractresult,   {"id"}},
         {"smartcontracts",         "listsmartcontracts",       &list_smartcontracts,       {}}
     };
 
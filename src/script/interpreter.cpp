@@ -1408,6 +1408,13 @@ bool TransactionSignatureChecker::VerifySignature(const std::vector<unsigned cha
     return pubkey.Verify(sighash, vchSig);
 }
 
+bool TransactionSignatureChecker::VerifyPQSignature(const std::vector<unsigned char> &vchSig, const std::vector<unsigned char> &vchPubKey, const uint256 &sighash) const
+{
+    return mldsa::Verify(vchSig.data(), vchSig.size(),
+                         sighash.begin(), 32,
+                         vchPubKey.data());
+}
+
 bool TransactionSignatureChecker::CheckSig(const std::vector<unsigned char> &vchSigIn, const std::vector<unsigned char> &vchPubKey, const CScript &scriptCode, SigVersion sigversion) const
 {
     // RIP-25: ML-DSA-44 signature verification for witness v2
@@ -1424,9 +1431,7 @@ bool TransactionSignatureChecker::CheckSig(const std::vector<unsigned char> &vch
         uint256 sighash = SignatureHash(scriptCode, *txTo, nIn, SIGHASH_ALL, amount, SIGVERSION_WITNESS_V2_PQ, this->txdata);
 
         // Verify ML-DSA-44 signature
-        return mldsa::Verify(vchSigIn.data(), vchSigIn.size(),
-                             sighash.begin(), 32,
-                             vchPubKey.data());
+        return VerifyPQSignature(vchSigIn, vchPubKey, sighash);
     }
 
     CPubKey pubkey(vchPubKey);
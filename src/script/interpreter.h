@@ -174,6 +174,8 @@ private:
 
 protected:
     virtual bool VerifySignature(const std::vector<unsigned char> &vchSig, const CPubKey &vchPubKey, const uint256 &sighash) const;
+    // RIP-25: ML-DSA-44 verification of a witness v2 signature over sighash
+    virtual bool VerifyPQSignature(const std::vector<unsigned char> &vchSig, const std::vector<unsigned char> &vchPubKey, const uint256 &sighash) const;
 
 public:
     TransactionSignatureChecker(const CTransaction *txToIn, unsigned int nInIn, const CAmount &amountIn) : txTo(txToIn), nIn(nInIn), amount(amountIn), txdata(nullptr) {}
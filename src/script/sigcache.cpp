@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <vector>
 #include "cuckoocache.h"
+#include "crypto/sha256.h"
+#include <atomic>
 #include <boost/thread.hpp>
 
 namespace {
@@ -43,6 +45,17 @@ public:
         CSHA256().Write(nonce.begin(), 32).Write(hash.begin(), 32).Write(&pubkey[0], pubkey.size()).Write(&vchSig[0], vchSig.size()).Finalize(entry.begin());
     }
 
+    //! PQ entries are SHA256(nonce || signature hash || SHA256(public key) || SHA256(signature))
+    void
+    ComputePQEntry(uint256& entry, const uint256 &hash, const std::vector<unsigned char>& vchSig, const std::vector<unsigned char>& vchPubKey)
+    {
+        unsigned char pkHash[CSHA256::OUTPUT_SIZE];
+        unsigned char sigHash[CSHA256::OUTPUT_SIZE];
+        CSHA256().Write(vchPubKey.data(), vchPubKey.size()).Finalize(pkHash);
+        CSHA256().Write(vchSig.data(), vchSig.size()).Finalize(sigHash);
+        CSHA256().Write(nonce.begin(), 32).Write(hash.begin(), 32).Write(pkHash, sizeof(pkHash)).Write(sigHash, sizeof(sigHash)).Finalize(entry.begin());
+    }
+
     bool
     Get(const uint256& entry, const bool erase)
     {
@@ -68,6 +81,13 @@ public:
  * signatureCache could be made local to VerifySignature.
 */
 static CSignatureCache signatureCache;
+
+/* RIP-25: ML-DSA-44 verification is far more expensive than ECDSA, so witness
+ * v2 results get their own cache rather than competing with ECDSA entries. */
+static CSignatureCache pqSignatureCache;
+static std::atomic<uint64_t> nPQCacheHits{0};
+static std::atomic<uint64_t> nPQCacheMisses{0};
+static std::atomic<size_t> nPQCacheElements{0};
 } // namespace
 
 // To be called once in AppInitMain/BasicTestingSetup to initialize the
@@ -80,6 +100,22 @@ void InitSignatureCache()
     size_t nElems = signatureCache.setup_bytes(nMaxCacheSize);
     LogPrintf("Using %zu MiB out of %zu/2 requested for signature cache, able to store %zu elements\n",
             (nElems*sizeof(uint256)) >>20, (nMaxCacheSize*2)>>20, nElems);
+
+    // ML-DSA-44 results are sized by -maxpqsigcachesize, on top of the ECDSA cache
+    size_t nMaxPQCacheSize = std::min(std::max((int64_t)0, gArgs.GetArg("-maxpqsigcachesize", DEFAULT_MAX_PQ_SIG_CACHE_SIZE)), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+    size_t nPQElems = pqSignatureCache.setup_bytes(nMaxPQCacheSize);
+    nPQCacheElements = nPQElems;
+    LogPrintf("Using %zu MiB out of %zu requested for PQ signature cache, able to store %zu elements\n",
+            (nPQElems*sizeof(uint256)) >>20, nMaxPQCacheSize>>20, nPQElems);
+}
+
+PQSignatureCacheStats GetPQSignatureCacheStats()
+{
+    PQSignatureCacheStats stats;
+    stats.nHits = nPQCacheHits.load(std::memory_order_relaxed);
+    stats.nMisses = nPQCacheMisses.load(std::memory_order_relaxed);
+    stats.nMaxElements = nPQCacheElements.load(std::memory_order_relaxed);
+    return stats;
 }
 
 bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
@@ -94,3 +130,19 @@ bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsig
         signatureCache.Set(entry);
     return true;
 }
+
+bool CachingTransactionSignatureChecker::VerifyPQSignature(const std::vector<unsigned char>& vchSig, const std::vector<unsigned char>& vchPubKey, const uint256& sighash) const
+{
+    uint256 entry;
+    pqSignatureCache.ComputePQEntry(entry, sighash, vchSig, vchPubKey);
+    if (pqSignatureCache.Get(entry, !store)) {
+        nPQCacheHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    nPQCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    if (!TransactionSignatureChecker::VerifyPQSignature(vchSig, vchPubKey, sighash))
+        return false;
+    if (store)
+        pqSignatureCache.Set(entry);
+    return true;
+}
@@ -18,6 +18,8 @@
 static constexpr unsigned int DEFAULT_MAX_SIG_CACHE_SIZE = 64;
 // Maximum sig cache size allowed
 static constexpr int64_t MAX_MAX_SIG_CACHE_SIZE = 16384;
+// ML-DSA-44 (witness v2) signature cache size in MiB, kept apart from the one above
+static constexpr unsigned int DEFAULT_MAX_PQ_SIG_CACHE_SIZE = 16;
 
 class CPubKey;
 
@@ -51,8 +53,18 @@ public:
     CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, PrecomputedTransactionData& txdataIn) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn), store(storeIn) {}
 
     bool VerifySignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey, const uint256& sighash) const override;
+    bool VerifyPQSignature(const std::vector<unsigned char>& vchSig, const std::vector<unsigned char>& vchPubKey, const uint256& sighash) const override;
+};
+
+/** Hit/miss counters of the ML-DSA-44 (witness v2) signature cache */
+struct PQSignatureCacheStats
+{
+    uint64_t nHits;
+    uint64_t nMisses;
+    size_t nMaxElements;
 };
 
 void InitSignatureCache();
+PQSignatureCacheStats GetPQSignatureCacheStats();
 
 #endif // SOTERIA_SCRIPT_SIGCACHE_H
@@ -0,0 +1,149 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "smartcontracts/contractexecutor.h"
+
+#include "util/system.h"
+#include "util/time.h"
+#include "validationinterface.h"
+
+#include <algorithm>
+
+std::unique_ptr<CContractExecutor> g_contractExecutor;
+
+std::string CContractJob::StatusString() const
+{
+    switch (status) {
+    case QUEUED:
+        return "queued";
+    case RUNNING:
+        return "running";
+    case DONE:
+        return "done";
+    }
+    return "unknown";
+}
+
+CContractExecutor::CContractExecutor(int nThreads, size_t nMaxQueueIn) : nNextId(1), nMaxQueue(nMaxQueueIn), fInterrupted(false)
+{
+    for (int i = 0; i < nThreads; i++)
+        threads.emplace_back(&CContractExecutor::ThreadRun, this);
+}
+
+CContractExecutor::~CContractExecutor()
+{
+    Interrupt();
+    Stop();
+}
+
+void CContractExecutor::ThreadRun()
+{
+    RenameThread("soteria-contract");
+
+    while (true) {
+        CContractJob job;
+        {
+            std::unique_lock<std::mutex> lock(cs);
+            cond.wait(lock, [this] { return fInterrupted || !queue.empty(); });
+            if (fInterrupted)
+                return;
+
+            CContractJob& queued = mapJobs[queue.front()];
+            queue.pop_front();
+            queued.status = CContractJob::RUNNING;
+            queued.nStartTime = GetTime();
+            job = queued;
+        }
+
+        job.result = CSoteriaSmartContracts::RunFile(job.strPath.c_str(), job.strFunction.c_str(), job.vArgs, &fInterrupted);
+        job.status = CContractJob::DONE;
+        job.nFinishTime = GetTime();
+
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            mapJobs[job.nId] = job;
+            finished.push_back(job.nId);
+            while (finished.size() > MAX_FINISHED_CONTRACT_JOBS) {
+                mapJobs.erase(finished.front());
+                finished.pop_front();
+            }
+        }
+
+        GetMainSignals().SmartContractFinished(job);
+    }
+}
+
+bool CContractExecutor::Submit(const std::string& strContract, const std::string& strPath, const std::string& strFunction, const std::vector<std::string>& vArgs, uint64_t& nId)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (fInterrupted || queue.size() >= nMaxQueue)
+        return false;
+
+    CContractJob& job = mapJobs[nNextId];
+    job.nId = nNextId;
+    job.strContract = strContract;
+    job.strPath = strPath;
+    job.strFunction = strFunction;
+    job.vArgs = vArgs;
+    job.nSubmitTime = GetTime();
+
+    queue.push_back(nNextId);
+    nId = nNextId++;
+    cond.notify_one();
+    return true;
+}
+
+bool CContractExecutor::GetJob(uint64_t nId, CContractJob& job) const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    auto it = mapJobs.find(nId);
+    if (it == mapJobs.end())
+        return false;
+    job = it->second;
+    return true;
+}
+
+size_t CContractExecutor::QueueSize() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return queue.size();
+}
+
+void CContractExecutor::Interrupt()
+{
+    std::lock_guard<std::mutex> lock(cs);
+    fInterrupted = true;
+    cond.notify_all();
+}
+
+void CContractExecutor::Stop()
+{
+    for (std::thread& thread : threads) {
+        if (thread.joinable())
+            thread.join();
+    }
+    threads.clear();
+}
+
+void StartSmartContractExecutor()
+{
+    int nThreads = std::max<int64_t>(gArgs.GetArg("-smartcontractthreads", DEFAULT_SMARTCONTRACT_THREADS), 1);
+    size_t nMaxQueue = std::max<int64_t>(gArgs.GetArg("-smartcontractqueue", DEFAULT_SMARTCONTRACT_QUEUE), 1);
+    LogPrintf("Using %d threads and a queue of %u for smart contract calls\n", nThreads, nMaxQueue);
+    g_contractExecutor.reset(new CContractExecutor(nThreads, nMaxQueue));
+}
+
+void InterruptSmartContractExecutor()
+{
+    if (g_contractExecutor)
+        g_contractExecutor->Interrupt();
+}
+
+void StopSmartContractExecutor()
+{
+    if (g_contractExecutor) {
+        g_contractExecutor->Stop();
+        g_contractExecutor.reset();
+    }
+}
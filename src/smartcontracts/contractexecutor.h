@@ -0,0 +1,97 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SOTERIA_SMARTCONTRACTS_CONTRACTEXECUTOR_H
+#define SOTERIA_SMARTCONTRACTS_CONTRACTEXECUTOR_H
+
+#include "smartcontracts/smartcontracts.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! Default for -smartcontractthreads
+static const int DEFAULT_SMARTCONTRACT_THREADS = 2;
+//! Default for -smartcontractqueue, the number of submitted calls that may wait to run
+static const int DEFAULT_SMARTCONTRACT_QUEUE = 64;
+//! Finished calls kept for getsmartcontractresult, the oldest are dropped first
+static const size_t MAX_FINISHED_CONTRACT_JOBS = 1000;
+
+/* A smart contract call submitted to the executor */
+class CContractJob
+{
+public:
+    enum Status {
+        QUEUED,
+        RUNNING,
+        DONE
+    };
+
+    uint64_t nId = 0;
+    std::string strContract;
+    std::string strPath;
+    std::string strFunction;
+    std::vector<std::string> vArgs;
+
+    Status status = QUEUED;
+    SmartContractResult result;
+    int64_t nSubmitTime = 0;
+    int64_t nStartTime = 0;
+    int64_t nFinishTime = 0;
+
+    std::string StatusString() const;
+};
+
+/**
+ * Runs smart contract calls on its own worker threads, so long running
+ * contracts don't occupy the RPC work queue. Calls are queued by Submit and
+ * their state and result are looked up by job id.
+ */
+class CContractExecutor
+{
+private:
+    mutable std::mutex cs;
+    std::condition_variable cond;
+    std::deque<uint64_t> queue;
+    std::map<uint64_t, CContractJob> mapJobs;
+    //! Ids of finished jobs, oldest first
+    std::deque<uint64_t> finished;
+    uint64_t nNextId;
+    size_t nMaxQueue;
+    std::atomic<bool> fInterrupted;
+    std::vector<std::thread> threads;
+
+    void ThreadRun();
+
+public:
+    CContractExecutor(int nThreads, size_t nMaxQueueIn);
+    ~CContractExecutor();
+
+    /** Queue a call of strFunction in the contract at strPath. Returns false if the queue is full. */
+    bool Submit(const std::string& strContract, const std::string& strPath, const std::string& strFunction, const std::vector<std::string>& vArgs, uint64_t& nId);
+    /** Copy out the job with id nId, returns false if it is unknown or was dropped */
+    bool GetJob(uint64_t nId, CContractJob& job) const;
+    /** Number of calls waiting to run */
+    size_t QueueSize() const;
+
+    /** Stop taking jobs off the queue and abort the calls that are running */
+    void Interrupt();
+    /** Wait for the worker threads to exit */
+    void Stop();
+};
+
+extern std::unique_ptr<CContractExecutor> g_contractExecutor;
+
+void StartSmartContractExecutor();
+void InterruptSmartContractExecutor();
+void StopSmartContractExecutor();
+
+#endif // SOTERIA_SMARTCONTRACTS_CONTRACTEXECUTOR_H
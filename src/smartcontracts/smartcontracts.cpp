@@ -13,91 +13,509 @@ Please take precautions when using this feature.
 #include "soterialib.h"
 #include <util/system.h>
 #include "fs.h"
+#include "hash.h"
+#include "init.h"
+#include "sync.h"
+#include "util/time.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <string>
 #include <vector>
 
 #include "lua/lua.hpp"
 
-SmartContractResult CSoteriaSmartContracts::RunFile(const char* file, const char* func, std::vector<std::string> args)
+//! Idle Lua states kept around for the next call
+static const size_t MAX_IDLE_LUA_STATES = 8;
+
+//! Instructions run between two checks of the gas limit and deadline
+static const int METER_INTERVAL = 1000;
+
+/* Resource accounting of one Lua state, shared by its allocator and its count hook */
+struct CLuaMeter
 {
-    // Warn user
-    LogPrintf("smart contract; Soteria Smart Contracts are experimental and prone to bugs. Please take precautions when using this feature.\n");
+    size_t nUsed = 0;
+    size_t nPeak = 0;
+    //! Allocations that would grow the state beyond this many bytes fail, 0 for no limit
+    size_t nMemoryLimit = 0;
+    bool fMemoryLimitHit = false;
+    uint64_t nGas = 0;
+    //! 0 for no limit
+    uint64_t nGasLimit = 0;
+    //! 0 for no deadline
+    int64_t nDeadline = 0;
+    //! The call stops once this is set, null if only shutdown stops it
+    const std::atomic<bool>* pfInterrupt = nullptr;
+    //! Set once the gas limit or deadline is hit or the call is interrupted; the call is then unwound past any pcall
+    bool fAborted = false;
+};
 
-    // Result object
-    SmartContractResult result;
-    int status;
+static void* MeteredAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    CLuaMeter* meter = static_cast<CLuaMeter*>(ud);
+    // osize is a type tag rather than a size when ptr is null
+    size_t nOld = ptr ? osize : 0;
+
+    if (nsize == 0) {
+        free(ptr);
+        meter->nUsed -= nOld;
+        return nullptr;
+    }
+    if (meter->nMemoryLimit && nsize > nOld && meter->nUsed + (nsize - nOld) > meter->nMemoryLimit) {
+        meter->fMemoryLimitHit = true;
+        return nullptr;
+    }
+    void* p = realloc(ptr, nsize);
+    if (!p)
+        return nullptr;
+    meter->nUsed = meter->nUsed - nOld + nsize;
+    meter->nPeak = std::max(meter->nPeak, meter->nUsed);
+    return p;
+}
+
+static CLuaMeter* GetMeter(lua_State* L)
+{
+    void* ud;
+    lua_getallocf(L, &ud);
+    return static_cast<CLuaMeter*>(ud);
+}
+
+//! A call limit argument. 0 means no limit, as do negative values, which init rejects.
+static uint64_t GetLimitArg(const std::string& strArg, int64_t nDefault)
+{
+    return std::max<int64_t>(gArgs.GetArg(strArg, nDefault), 0);
+}
+
+static void MeterHook(lua_State* L, lua_Debug* ar)
+{
+    CLuaMeter* meter = GetMeter(L);
+    meter->nGas += METER_INTERVAL;
+    if (meter->nGasLimit && meter->nGas > meter->nGasLimit) {
+        meter->fAborted = true;
+        luaL_error(L, "Out of gas.");
+    }
+    if (meter->nDeadline && GetTimeMillis() > meter->nDeadline) {
+        meter->fAborted = true;
+        luaL_error(L, "Execution time limit exceeded.");
+    }
+    // Without a gas limit or timeout nothing else would stop the call from holding up shutdown
+    if ((meter->pfInterrupt && *meter->pfInterrupt) || ShutdownRequested()) {
+        meter->fAborted = true;
+        luaL_error(L, "Interrupted by shutdown.");
+    }
+}
+
+/* pcall and xpcall that don't let a contract catch the error ending a call that hit its limits */
+static int MeteredPcall(lua_State* L)
+{
+    luaL_checkany(L, 1);
+    int status = lua_pcall(L, lua_gettop(L) - 1, LUA_MULTRET, 0);
+    if (GetMeter(L)->fAborted)
+        return lua_error(L);
+    lua_pushboolean(L, status == LUA_OK);
+    lua_insert(L, 1);
+    return lua_gettop(L);
+}
+
+static int MeteredXpcall(lua_State* L)
+{
+    int n = lua_gettop(L);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_pushvalue(L, 1);
+    lua_rotate(L, 3, 1);
+    int status = lua_pcall(L, n - 2, LUA_MULTRET, 2);
+    if (GetMeter(L)->fAborted)
+        return lua_error(L);
+    lua_pushboolean(L, status == LUA_OK);
+    lua_replace(L, 2);
+    return lua_gettop(L) - 1;
+}
 
-    lua_State* L = luaL_newstate();
+/* setmetatable that refuses finalizers: Lua runs __gc with hooks off, so the meter could never stop one */
+static int MeteredSetmetatable(lua_State* L)
+{
+    int t = lua_type(L, 2);
+    luaL_checktype(L, 1, LUA_TTABLE);
+    luaL_argexpected(L, t == LUA_TNIL || t == LUA_TTABLE, 2, "nil or table");
+    if (luaL_getmetafield(L, 1, "__metatable") != LUA_TNIL)
+        return luaL_error(L, "cannot change a protected metatable");
+    if (t == LUA_TTABLE) {
+        lua_pushliteral(L, "__gc");
+        if (lua_rawget(L, 2) != LUA_TNIL)
+            return luaL_error(L, "__gc metamethods are not allowed in smart contracts");
+    }
+    lua_settop(L, 2);
+    lua_setmetatable(L, 1);
+    return 1;
+}
+
+//! Registry key of the snapshot taken of a fresh state's tables
+static const char SNAPSHOT_KEY = 0;
+
+/* Record the contents and metatable of the table at idx, and of the tables it holds down to depth more levels,
+ * in the snapshot table at the top of the stack */
+static void SnapshotTable(lua_State* L, int idx, int depth)
+{
+    idx = lua_absindex(L, idx);
+    lua_pushvalue(L, idx);
+    if (lua_rawget(L, -2) != LUA_TNIL) {
+        lua_pop(L, 1);
+        return;
+    }
+    lua_pop(L, 1);
+
+    // snapshot[t] = {contents, metatable or false}
+    lua_pushvalue(L, idx);
+    lua_createtable(L, 2, 0);
+    lua_newtable(L);
+    lua_pushnil(L);
+    while (lua_next(L, idx)) {
+        lua_pushvalue(L, -2);
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+    }
+    lua_rawseti(L, -2, 1);
+    if (!lua_getmetatable(L, idx))
+        lua_pushboolean(L, 0);
+    lua_rawseti(L, -2, 2);
+    lua_rawset(L, -3);
+
+    if (depth == 0)
+        return;
+    lua_pushnil(L);
+    while (lua_next(L, idx)) {
+        if (lua_istable(L, -1)) {
+            lua_pushvalue(L, -3);
+            SnapshotTable(L, -2, depth - 1);
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+}
+
+/* Put every table in the snapshot back the way it was, undoing whatever a call changed in the shared libraries */
+static int RestoreSnapshot(lua_State* L)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &SNAPSHOT_KEY);
+    lua_pushnil(L);
+    while (lua_next(L, -2)) {
+        // Clearing fields during a traversal is allowed
+        lua_pushnil(L);
+        while (lua_next(L, -3)) {
+            lua_pop(L, 1);
+            lua_pushvalue(L, -1);
+            lua_pushnil(L);
+            lua_rawset(L, -5);
+        }
+        lua_rawgeti(L, -1, 1);
+        lua_pushnil(L);
+        while (lua_next(L, -2)) {
+            lua_pushvalue(L, -2);
+            lua_insert(L, -2);
+            lua_rawset(L, -6);
+        }
+        lua_pop(L, 1);
+        if (lua_rawgeti(L, -1, 2) == LUA_TTABLE)
+            lua_setmetatable(L, -3);
+        else {
+            lua_pop(L, 1);
+            lua_pushnil(L);
+            lua_setmetatable(L, -3);
+        }
+        lua_pop(L, 1);
+    }
+    return 0;
+}
+
+static int ContractPanic(lua_State* L)
+{
+    const char* message = lua_tostring(L, -1);
+    LogPrintf("smart contract; unprotected error in call to Lua API (%s)\n", message ? message : "error object is not a string");
+    return 0;
+}
+
+/* Create a Lua state with the libraries every contract can use */
+static lua_State* NewContractState()
+{
+    CLuaMeter* meter = new CLuaMeter();
+    lua_State* L = lua_newstate(MeteredAlloc, meter);
+    if (!L) {
+        delete meter;
+        return nullptr;
+    }
+    lua_atpanic(L, ContractPanic);
 
     // Make standard libraries available in the Lua object
     luaopen_base(L);
     luaopen_table(L);
     luaopen_string(L);
     luaopen_math(L);
+    lua_register(L, "pcall", MeteredPcall);
+    lua_register(L, "xpcall", MeteredXpcall);
+    lua_register(L, "setmetatable", MeteredSetmetatable);
 
     // Register Soteria lib
     register_soterialib(L);
 
-    // Load the program
-    status = luaL_dofile(L, file);
+    // Remember the globals, the libraries they hold and the string metatable, so a pooled state can be reset
+    lua_newtable(L);
+    lua_pushglobaltable(L);
+    lua_pushvalue(L, -2);
+    SnapshotTable(L, -2, 2);
+    lua_pop(L, 2);
+    lua_pushliteral(L, "");
+    if (lua_getmetatable(L, -1)) {
+        lua_pushvalue(L, -3);
+        SnapshotTable(L, -2, 1);
+        lua_pop(L, 2);
+    }
+    lua_pop(L, 1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &SNAPSHOT_KEY);
+
+    lua_settop(L, 0);
+    return L;
+}
+
+static void CloseContractState(lua_State* L)
+{
+    CLuaMeter* meter = GetMeter(L);
+    lua_close(L);
+    delete meter;
+}
+
+/* Pool of initialized Lua states, so calls don't pay for creating one and registering soterialib */
+class CLuaStatePool
+{
+private:
+    CCriticalSection cs;
+    std::vector<lua_State*> vIdle;
+
+public:
+    ~CLuaStatePool()
+    {
+        for (lua_State* L : vIdle)
+            CloseContractState(L);
+    }
+
+    lua_State* Acquire()
+    {
+        {
+            LOCK(cs);
+            if (!vIdle.empty()) {
+                lua_State* L = vIdle.back();
+                vIdle.pop_back();
+                return L;
+            }
+        }
+        return NewContractState();
+    }
+
+    void Release(lua_State* L, bool fReuse)
+    {
+        lua_settop(L, 0);
+        // Undo what the call changed in the globals and libraries, then free what it left behind,
+        // so the next call starts from the libraries alone
+        if (fReuse) {
+            lua_pushcfunction(L, RestoreSnapshot);
+            fReuse = lua_pcall(L, 0, 0, 0) == LUA_OK;
+            lua_settop(L, 0);
+        }
+        if (fReuse) {
+            lua_gc(L, LUA_GCCOLLECT);
+            LOCK(cs);
+            if (vIdle.size() < MAX_IDLE_LUA_STATES) {
+                vIdle.push_back(L);
+                return;
+            }
+        }
+        CloseContractState(L);
+    }
+};
+
+static CLuaStatePool luaStatePool;
+
+/* Compiled contract file, valid while the file keeps the contents it was compiled from */
+struct CContractChunk
+{
+    uint256 hashSource;
+    std::string bytecode;
+};
+
+static CCriticalSection cs_contractChunks;
+static std::map<std::string, CContractChunk> mapContractChunks;
+
+static int WriteChunk(lua_State* L, const void* p, size_t sz, void* ud)
+{
+    static_cast<std::string*>(ud)->append(static_cast<const char*>(p), sz);
+    return 0;
+}
+
+/* Push the compiled main chunk of file, parsing the file only if its contents changed since it was last compiled */
+static int LoadContractChunk(lua_State* L, const std::string& file)
+{
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+        lua_pushfstring(L, "cannot open %s", file.c_str());
+        return LUA_ERRFILE;
+    }
+    std::string source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (stream.bad()) {
+        lua_pushfstring(L, "cannot read %s", file.c_str());
+        return LUA_ERRFILE;
+    }
+    uint256 hashSource = Hash(source.begin(), source.end());
+
+    {
+        LOCK(cs_contractChunks);
+        auto it = mapContractChunks.find(file);
+        if (it != mapContractChunks.end() && it->second.hashSource == hashSource)
+            return luaL_loadbufferx(L, it->second.bytecode.data(), it->second.bytecode.size(), file.c_str(), "b");
+    }
+
+    // Skip a UTF-8 byte order mark and a leading # line like luaL_loadfile does, keeping line numbers
+    size_t nStart = source.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    if (source.compare(nStart, 1, "#") == 0) {
+        nStart = source.find('\n', nStart);
+        if (nStart == std::string::npos)
+            nStart = source.size();
+    }
+    std::string chunkname = "@" + file;
+    int status = luaL_loadbufferx(L, source.data() + nStart, source.size() - nStart, chunkname.c_str(), "t");
+    if (status != LUA_OK)
+        return status;
 
+    // Keep debug information so errors still report line numbers
+    CContractChunk chunk{hashSource, std::string()};
+    if (lua_dump(L, WriteChunk, &chunk.bytecode, 0) == 0) {
+        LOCK(cs_contractChunks);
+        mapContractChunks[file] = std::move(chunk);
+    }
+    return status;
+}
+
+static std::string ErrorMessage(lua_State* L)
+{
+    const char* message = lua_tostring(L, -1);
+    return message ? message : "Error object is not a string.";
+}
+
+/* Load file into L and call func. Returns false if L must not be reused. */
+static bool RunInState(lua_State* L, const std::string& file, const char* func, const std::vector<std::string>& args, SmartContractResult& result)
+{
+    // Load the program
+    int status = LoadContractChunk(L, file);
     if (status != LUA_OK) {
-        const char* message = lua_tostring(L, -1);
-        result.result = message;
+        result.result = ErrorMessage(L);
         result.is_error = true;
+        return status != LUA_ERRMEM;
+    }
+
+    // Give the call its own global table so nothing it defines outlives it;
+    // lookups of names it doesn't define fall through to the libraries.
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushglobaltable(L);
+    lua_setfield(L, -2, "__index");
+    lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    if (!lua_setupvalue(L, -3, 1))
         lua_pop(L, 1);
-        return result;
+    lua_insert(L, -2);
+
+    status = lua_pcall(L, 0, 0, 0);
+    if (status != LUA_OK) {
+        result.result = ErrorMessage(L);
+        result.is_error = true;
+        return status != LUA_ERRMEM;
     }
 
     // The function name
-    lua_getglobal(L, func);
+    lua_getfield(L, -1, func);
 
-    if (lua_isfunction(L, -1)) {
-        int n = 0;
+    if (!lua_isfunction(L, -1)) {
+        result.result = "Function not found or invalid.";
+        result.is_error = true;
+        return true;
+    }
 
-        if (args.size() >= 1) {
-            n = args.size();
-            // Loop through each argument
-            for (int i = 0; i < n; i++) {
-                /* push argument */
-                lua_pushstring(L, args[i].c_str());
-            }
-        }
+    // Loop through each argument
+    for (const std::string& arg : args) {
+        /* push argument */
+        lua_pushstring(L, arg.c_str());
+    }
 
-        // Call the function with n arguments, return 1 result
-        status = lua_pcall(L, n, 1, 0);
+    // Call the function with n arguments, return 1 result
+    status = lua_pcall(L, args.size(), 1, 0);
 
-        if (status != LUA_OK) {
-            const char* message = lua_tostring(L, -1);
-            result.result = message;
-            result.is_error = true;
-            lua_pop(L, 1);
-            return result;
-        }
+    if (status != LUA_OK) {
+        result.result = ErrorMessage(L);
+        result.is_error = true;
+        return status != LUA_ERRMEM;
+    }
 
-        // Get the result
-        if (lua_isstring(L, -1)) {
-            result.result = (char*)lua_tostring(L, -1);
-            lua_pop(L, 1);
-        } else {
-            result.result = "Return value was null.";
-            result.is_error = true;
-            return result;
-        }
+    // Get the result
+    if (lua_isstring(L, -1)) {
+        result.result = lua_tostring(L, -1);
     } else {
-        result.result = "Function not found or invalid.";
+        result.result = "Return value was null.";
+        result.is_error = true;
+    }
+    return true;
+}
+
+SmartContractResult CSoteriaSmartContracts::RunFile(const char* file, const char* func, std::vector<std::string> args, const std::atomic<bool>* pfInterrupt)
+{
+    // Warn user
+    LogPrintf("smart contract; Soteria Smart Contracts are experimental and prone to bugs. Please take precautions when using this feature.\n");
+
+    // Result object
+    SmartContractResult result;
+
+    lua_State* L = luaStatePool.Acquire();
+    if (!L) {
+        result.result = "Failed to create Lua state.";
         result.is_error = true;
         return result;
     }
 
-    lua_close(L);
+    // Meter the call: count instructions from zero and cap memory on top of what the libraries use
+    CLuaMeter* meter = GetMeter(L);
+    size_t nBaseline = meter->nUsed;
+    meter->nPeak = nBaseline;
+    uint64_t nMaxMemory = GetLimitArg("-smartcontractmaxmemory", DEFAULT_SMARTCONTRACT_MAX_MEMORY);
+    meter->nMemoryLimit = nMaxMemory ? nBaseline + nMaxMemory * 1024 * 1024 : 0;
+    meter->fMemoryLimitHit = false;
+    meter->nGas = 0;
+    meter->fAborted = false;
+    meter->nGasLimit = GetLimitArg("-smartcontractgaslimit", DEFAULT_SMARTCONTRACT_GAS_LIMIT);
+    uint64_t nTimeout = GetLimitArg("-smartcontracttimeout", DEFAULT_SMARTCONTRACT_TIMEOUT);
+    meter->nDeadline = nTimeout ? GetTimeMillis() + nTimeout : 0;
+    meter->pfInterrupt = pfInterrupt;
+    lua_sethook(L, MeterHook, LUA_MASKCOUNT, METER_INTERVAL);
+
+    bool fReuse = RunInState(L, file, func, args, result);
+
+    lua_sethook(L, nullptr, 0, 0);
+    result.gas = meter->nGas;
+    result.memory = meter->nPeak - nBaseline;
+    if (result.is_error && meter->fMemoryLimitHit)
+        result.result = "Memory limit exceeded.";
+    meter->nMemoryLimit = 0;
+    meter->nGasLimit = 0;
+    meter->nDeadline = 0;
+    meter->pfInterrupt = nullptr;
+
+    luaStatePool.Release(L, fReuse);
 
     return result;
 }
+
 // Missing creation correct fs build
 std::vector<std::string> CSoteriaSmartContracts::GetPlans()
 {
@@ -8,22 +8,37 @@
 #ifndef SOTERIA_SMARTCONTRACTS_H
 #define SOTERIA_SMARTCONTRACTS_H
 
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
+//! Default for -smartcontractgaslimit, in Lua VM instructions
+static const int64_t DEFAULT_SMARTCONTRACT_GAS_LIMIT = 100000000;
+//! Default for -smartcontractmaxmemory, in megabytes
+static const int64_t DEFAULT_SMARTCONTRACT_MAX_MEMORY = 64;
+//! Default for -smartcontracttimeout, in milliseconds
+static const int64_t DEFAULT_SMARTCONTRACT_TIMEOUT = 10000;
+
 /* Soteria SmartcontractsResult */
 class SmartContractResult
 {
 public:
-    const char* result;
+    std::string result;
     bool is_error = false;
+    //! Lua VM instructions the call executed, counted in steps of 1000
+    uint64_t gas = 0;
+    //! Peak memory the call allocated on top of the libraries, in bytes
+    size_t memory = 0;
 };
 
 /* Soteria Smartcontracts*/
 class CSoteriaSmartContracts
 {
 public:
-    static SmartContractResult RunFile(const char* file, const char* func, std::vector<std::string> args={});
+    /** Call func in the contract at file. The call is aborted once *pfInterrupt is set, if given, or on shutdown. */
+    static SmartContractResult RunFile(const char* file, const char* func, std::vector<std::string> args={}, const std::atomic<bool>* pfInterrupt = nullptr);
     static std::vector<std::string> GetPlans();
 };
 
@@ -9,6 +9,7 @@ extern "C" {
 #include "json/lua_cjson.c"
 }
 #include <cctype>
+#include <cstring>
 #include "amount.h"
 #include "base58.h"
 #include "chain.h"
@@ -28,6 +29,7 @@ extern "C" {
 #include "timedata.h"
 #include <util/system.h>
 #include "util/moneystr.h"
+#include "util/strencodings.h"
 #include "util/time.h"
 #include "validation.h"
 #include "wallet/coincontrol.h"
@@ -280,33 +282,205 @@ bool RPCParse(std::string& strResult, const std::string& strCommand, const bool
     }
 }
 
-/* Call RPC method with multiple arguments */
-int RPCCall(lua_State* L, std::string command)
+//! Deepest table nesting converted between Lua and UniValue, also stops reference cycles
+static const int MAX_MARSHAL_DEPTH = 64;
+
+/*
+ * Lua raises errors with longjmp, which skips the destructors of the C++ frames
+ * it unwinds. LuaToUniValue therefore only uses Lua calls that cannot raise, and
+ * PushUniValue, whose calls allocate and can, only runs under lua_pcall.
+ */
+
+/* The string Lua's tostring gives the number at idx, built without Lua allocating */
+static std::string LuaNumberToString(lua_State* L, int idx)
 {
-    std::string args;
+    char buf[64];
+    if (lua_isinteger(L, idx)) {
+        lua_integer2str(buf, sizeof(buf), lua_tointeger(L, idx));
+        return buf;
+    }
+    int len = lua_number2str(buf, sizeof(buf), lua_tonumber(L, idx));
+    // Like Lua, mark floats that look like integers as floats
+    if (buf[strspn(buf, "-0123456789")] == '\0' && len + 2 < (int)sizeof(buf))
+        strcpy(buf + len, ".0");
+    return buf;
+}
+
+/* Convert the Lua value at idx to a UniValue. json.null and nil become null. */
+static UniValue LuaToUniValue(lua_State* L, int idx, int depth)
+{
+    switch (lua_type(L, idx)) {
+    case LUA_TNIL:
+        return NullUniValue;
+    case LUA_TBOOLEAN:
+        return UniValue((bool)lua_toboolean(L, idx));
+    case LUA_TNUMBER:
+        if (lua_isinteger(L, idx))
+            return UniValue((int64_t)lua_tointeger(L, idx));
+        return UniValue(lua_tonumber(L, idx));
+    case LUA_TSTRING: {
+        size_t len;
+        const char* str = lua_tolstring(L, idx, &len);
+        return UniValue(std::string(str, len));
+    }
+    case LUA_TLIGHTUSERDATA:
+        if (lua_touserdata(L, idx) == nullptr)
+            return NullUniValue;
+        break;
+    case LUA_TTABLE: {
+        if (depth >= MAX_MARSHAL_DEPTH)
+            throw std::runtime_error("Table nesting too deep");
+        idx = lua_absindex(L, idx);
+        if (!lua_checkstack(L, 3))
+            throw std::runtime_error("Table too deep");
+
+        // A table holding exactly the keys 1..n is an array, anything else an object
+        size_t nLength = lua_rawlen(L, idx);
+        size_t nKeys = 0;
+        bool fStringKeys = true;
+        lua_pushnil(L);
+        while (lua_next(L, idx)) {
+            nKeys++;
+            fStringKeys &= lua_type(L, -2) == LUA_TSTRING;
+            lua_pop(L, 1);
+        }
 
-    /* get number of arguments */
-    int n = lua_gettop(L);
+        if (nLength > 0 && nKeys == nLength) {
+            UniValue arr(UniValue::VARR);
+            for (size_t i = 1; i <= nLength; i++) {
+                lua_rawgeti(L, idx, i);
+                arr.push_back(LuaToUniValue(L, -1, depth + 1));
+                lua_pop(L, 1);
+            }
+            return arr;
+        }
 
-    /* loop through each argument */
-    for (int i = 1; i <= n; i++) {
-        if (lua_isstring(L, i)) {
-            std::string arg = std::string(lua_tostring(L, i));
-            args = args + " " + arg;
-        } else {
-            lua_pushliteral(L, "Invalid argument");
-            lua_error(L);
+        if (!fStringKeys)
+            throw std::runtime_error("Table must be an array or have only string keys");
+        UniValue obj(UniValue::VOBJ);
+        lua_pushnil(L);
+        while (lua_next(L, idx)) {
+            size_t len;
+            const char* key = lua_tolstring(L, -2, &len);
+            obj.pushKV(std::string(key, len), LuaToUniValue(L, -1, depth + 1));
+            lua_pop(L, 1);
+        }
+        return obj;
+    }
+    }
+    throw std::runtime_error(strprintf("Cannot convert %s to JSON", luaL_typename(L, idx)));
+}
+
+/* Push value as the Lua value json.decode would produce for it. Raises Lua errors. */
+static void PushUniValue(lua_State* L, const UniValue& value, int depth)
+{
+    if (depth >= MAX_MARSHAL_DEPTH)
+        luaL_error(L, "Result nesting too deep");
+    luaL_checkstack(L, 3, "result too deep");
+
+    switch (value.getType()) {
+    case UniValue::VNULL:
+        lua_pushlightuserdata(L, nullptr);
+        break;
+    case UniValue::VBOOL:
+        lua_pushboolean(L, value.get_bool());
+        break;
+    case UniValue::VNUM: {
+        int64_t n;
+        double d;
+        if (ParseInt64(value.getValStr(), &n))
+            lua_pushinteger(L, n);
+        else if (ParseDouble(value.getValStr(), &d))
+            lua_pushnumber(L, d);
+        else
+            luaL_error(L, "Number out of range");
+        break;
+    }
+    case UniValue::VSTR:
+        lua_pushlstring(L, value.get_str().data(), value.get_str().size());
+        break;
+    case UniValue::VARR:
+        lua_createtable(L, value.size(), 0);
+        for (size_t i = 0; i < value.size(); i++) {
+            PushUniValue(L, value[i], depth + 1);
+            lua_rawseti(L, -2, i + 1);
+        }
+        break;
+    case UniValue::VOBJ: {
+        const std::vector<std::string>& keys = value.getKeys();
+        lua_createtable(L, 0, keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            lua_pushlstring(L, keys[i].data(), keys[i].size());
+            PushUniValue(L, value[i], depth + 1);
+            lua_rawset(L, -3);
         }
+        break;
     }
+    }
+}
 
-    std::string result;
-    if (RPCParse(result, command + args, true, nullptr)) {
-        lua_pushstring(L, result.c_str());
-    } else {
-        lua_pushliteral(L, "RPC Parse error: unbalanced ' or \"");
-        lua_error(L);
+static int PushUniValueUnprotected(lua_State* L)
+{
+    PushUniValue(L, *static_cast<const UniValue*>(lua_touserdata(L, 1)), 0);
+    return 1;
+}
+
+/*
+ * Push value as PushUniValue does, catching any Lua error raised on the way.
+ * Returns false with the error message pushed instead. The caller raises it once
+ * its own C++ objects are gone.
+ */
+static bool PushUniValueProtected(lua_State* L, const UniValue& value)
+{
+    lua_pushcfunction(L, PushUniValueUnprotected);
+    lua_pushlightuserdata(L, const_cast<UniValue*>(&value));
+    return lua_pcall(L, 1, 1, 0) == LUA_OK;
+}
+
+/*
+ * Run method with the Lua arguments from firstArg on as its parameters and push
+ * its result: as a Lua value if fNative, as a JSON string otherwise. Strings are
+ * converted per parameter the same way soteria-cli converts its arguments.
+ * Returns false with the error message pushed instead.
+ */
+static bool ExecuteRPC(lua_State* L, const std::string& method, int firstArg, bool fNative)
+{
+    UniValue ret;
+    bool fSuccess = false;
+    try {
+        JSONRPCRequest request;
+        request.strMethod = method;
+        request.params = UniValue(UniValue::VARR);
+        int n = lua_gettop(L);
+        for (int i = firstArg; i <= n; i++) {
+            int idx = i - firstArg;
+            if (lua_type(L, i) == LUA_TSTRING) {
+                request.params.push_back(RPCConvertValue(method, idx, lua_tostring(L, i)));
+            } else if (lua_type(L, i) == LUA_TNUMBER) {
+                request.params.push_back(RPCConvertValue(method, idx, LuaNumberToString(L, i)));
+            } else {
+                request.params.push_back(LuaToUniValue(L, i, 0));
+            }
+        }
+
+        ret = tableRPC.execute(request);
+        // don't stringify the json in case of a string to avoid doublequotes
+        if (!fNative && !ret.isStr())
+            ret = UniValue(ret.write(2));
+        fSuccess = true;
+    } catch (const UniValue& objError) {
+        ret = UniValue(find_value(objError, "message").getValStr());
+    } catch (const std::exception& e) {
+        ret = UniValue(std::string(e.what()));
     }
+    return PushUniValueProtected(L, ret) && fSuccess;
+}
 
+/* Call RPC method with multiple arguments, returning the result as a JSON string */
+int RPCCall(lua_State* L, const char* command)
+{
+    if (!ExecuteRPC(L, command, 1, false))
+        return lua_error(L);
     return 1;
 }
 
@@ -317,24 +491,43 @@ int RPCCall(lua_State* L, std::string command)
 // Call RPC method
 static int rpc_call(lua_State* L)
 {
-    if (lua_isstring(L, 1)) {
-        const char* rpc_command = lua_tostring(L, 1);
-        std::string result;
-        if (RPCParse(result, std::string(rpc_command), true, nullptr)) {
-            lua_pushstring(L, result.c_str());
-        } else {
-            lua_pushliteral(L, "RPC Parse error: unbalanced ' or \"");
-            lua_error(L);
-        }
-    } else {
+    if (!lua_isstring(L, 1)) {
         lua_pushliteral(L, "Missing or invalid argument.");
-        lua_error(L);
+        return lua_error(L);
     }
+    const char* rpc_command = lua_tostring(L, 1);
+
+    // Raise Lua errors only after result is destroyed
+    bool fParsed, fPushed = false;
+    {
+        std::string result;
+        fParsed = RPCParse(result, std::string(rpc_command), true, nullptr);
+        if (fParsed)
+            fPushed = PushUniValueProtected(L, UniValue(result));
+    }
+    if (!fParsed) {
+        lua_pushliteral(L, "RPC Parse error: unbalanced ' or \"");
+        return lua_error(L);
+    }
+    if (!fPushed)
+        return lua_error(L);
 
     /* return the number of results */
     return 1;
 }
 
+// Call RPC method with Lua values as arguments, returning the result as a Lua value
+static int call(lua_State* L)
+{
+    if (lua_type(L, 1) != LUA_TSTRING) {
+        lua_pushliteral(L, "Missing or invalid argument.");
+        return lua_error(L);
+    }
+    if (!ExecuteRPC(L, lua_tostring(L, 1), 2, true))
+        return lua_error(L);
+    return 1;
+}
+
 // createmultisig
 static int createmultisig(lua_State* L)
 {
@@ -1014,6 +1207,7 @@ void register_soterialib(lua_State* L)
 {
     static const struct luaL_Reg soteria_main[] = {
         {"rpc_call", rpc_call},
+        {"call", call},
         {"createmultisig", createmultisig},
         {"estimatefee", estimatefee},
         {"estimatesmartfee", estimatesmartfee},
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "addressindex.h"
+#include "txdb.h"
+#include "test/test_soteria.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(addressbalanceindex_tests, BasicTestingSetup)
+
+static void CheckBalance(CBlockTreeDB& db, const uint160& hash, const std::string& asset, CAmount nReceived, CAmount nBalance)
+{
+    CAddressBalanceValue value;
+    BOOST_CHECK(db.ReadAddressBalanceIndex(hash, 1, asset, value));
+    BOOST_CHECK_EQUAL(value.received, nReceived);
+    BOOST_CHECK_EQUAL(value.balance, nBalance);
+}
+
+BOOST_AUTO_TEST_CASE(addressbalanceindex_connect_disconnect)
+{
+    CBlockTreeDB db(1 << 20, true);
+    uint160 hash;
+    hash.SetHex("0102030405060708090a0b0c0d0e0f1011121314");
+    uint256 txid1 = uint256S("0x01");
+    uint256 txid2 = uint256S("0x02");
+
+    // Block 1 pays the address twice, block 2 spends one of the outputs and pays it an asset
+    std::vector<std::pair<CAddressIndexKey, CAmount>> vBlock1 = {
+        {CAddressIndexKey(1, hash, 1, 1, txid1, 0, false), 100},
+        {CAddressIndexKey(1, hash, 1, 1, txid1, 1, false), 50},
+    };
+    std::vector<std::pair<CAddressIndexKey, CAmount>> vBlock2 = {
+        {CAddressIndexKey(1, hash, 2, 1, txid2, 0, true), -100},
+        {CAddressIndexKey(1, hash, "ASSET", 2, 1, txid2, 0, false), 7},
+    };
+
+    BOOST_CHECK(db.WriteAddressIndex(vBlock1));
+    CheckBalance(db, hash, SOTER, 150, 150);
+    BOOST_CHECK(db.WriteAddressIndex(vBlock2));
+    CheckBalance(db, hash, SOTER, 150, 50);
+    CheckBalance(db, hash, "ASSET", 7, 7);
+
+    // Connecting a block again, as after an unclean shutdown, does not count it twice
+    BOOST_CHECK(db.WriteAddressIndex(vBlock2));
+    CheckBalance(db, hash, SOTER, 150, 50);
+    CheckBalance(db, hash, "ASSET", 7, 7);
+
+    std::vector<std::pair<std::string, CAddressBalanceValue>> balances;
+    BOOST_CHECK(db.ReadAddressBalanceIndex(hash, 1, balances));
+    BOOST_CHECK_EQUAL(balances.size(), 2U);
+
+    // Disconnecting takes the amounts back, once
+    BOOST_CHECK(db.EraseAddressIndex(vBlock2));
+    CheckBalance(db, hash, SOTER, 150, 150);
+    CheckBalance(db, hash, "ASSET", 0, 0);
+    BOOST_CHECK(db.EraseAddressIndex(vBlock2));
+    CheckBalance(db, hash, SOTER, 150, 150);
+
+    // Totals that drop to zero are removed
+    BOOST_CHECK(db.EraseAddressIndex(vBlock1));
+    balances.clear();
+    BOOST_CHECK(db.ReadAddressBalanceIndex(hash, 1, balances));
+    BOOST_CHECK(balances.empty());
+}
+
+BOOST_AUTO_TEST_CASE(addressbalanceindex_build)
+{
+    CBlockTreeDB db(1 << 20, true);
+    uint160 hash1, hash2;
+    hash1.SetHex("01");
+    hash2.SetHex("02");
+    uint256 txid = uint256S("0x01");
+
+    // An address index written before the balance index existed, keyed as CBlockTreeDB keys it
+    static const char DB_ADDRESSINDEX = 'a';
+    BOOST_CHECK(db.Write(std::make_pair(DB_ADDRESSINDEX, CAddressIndexKey(1, hash1, 1, 1, txid, 0, false)), (CAmount)100));
+    BOOST_CHECK(db.Write(std::make_pair(DB_ADDRESSINDEX, CAddressIndexKey(1, hash1, 2, 1, txid, 0, true)), (CAmount)-40));
+    BOOST_CHECK(db.Write(std::make_pair(DB_ADDRESSINDEX, CAddressIndexKey(1, hash1, "ASSET", 3, 1, txid, 1, false)), (CAmount)5));
+    BOOST_CHECK(db.Write(std::make_pair(DB_ADDRESSINDEX, CAddressIndexKey(1, hash2, 1, 2, txid, 0, false)), (CAmount)30));
+    CheckBalance(db, hash1, SOTER, 0, 0);
+
+    BOOST_CHECK(db.BuildAddressBalanceIndex());
+    CheckBalance(db, hash1, SOTER, 100, 60);
+    CheckBalance(db, hash1, "ASSET", 5, 5);
+    CheckBalance(db, hash2, SOTER, 30, 30);
+
+    // Building again gives the same totals rather than adding to them
+    BOOST_CHECK(db.BuildAddressBalanceIndex());
+    CheckBalance(db, hash1, SOTER, 100, 60);
+    CheckBalance(db, hash2, SOTER, 30, 30);
+
+    // and connecting on top of it carries on from them
+    BOOST_CHECK(db.WriteAddressIndex({{CAddressIndexKey(1, hash2, 4, 1, txid, 2, false), 10}}));
+    CheckBalance(db, hash2, SOTER, 40, 40);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,220 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <assets/assets.h>
+#include <test/test_soteria.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <regex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The std::regex definitions the asset name validator used to be written with.
+ * The table-driven validator must agree with them on every input.
+ */
+namespace regex_reference {
+
+static const std::regex ROOT_NAME_CHARACTERS("^([A-Z]|[A-Z][A-Z0-9-]{0,62}[A-Z0-9])$");
+static const std::regex SUB_NAME_CHARACTERS("^([A-Z0-9]|[A-Z0-9][A-Z0-9-]{0,61}[A-Z0-9])$");
+static const std::regex UNIQUE_TAG_CHARACTERS("^[-A-Za-z0-9@$%&*()[\\]{}_.?:]+$");
+static const std::regex MSG_CHANNEL_TAG_CHARACTERS("^[A-Za-z0-9_]+$");
+static const std::regex VOTE_TAG_CHARACTERS("^[A-Z0-9._]+$");
+
+static const std::regex QUALIFIER_NAME_CHARACTERS("#[A-Z0-9._]{3,}$");
+static const std::regex SUB_QUALIFIER_NAME_CHARACTERS("#[A-Z0-9._]+$");
+static const std::regex RESTRICTED_NAME_CHARACTERS("\\$[A-Z0-9._]{3,}$");
+
+static const std::regex DOUBLE_PUNCTUATION("^.*[._]{2,}.*$");
+static const std::regex LEADING_PUNCTUATION("^[._].*$");
+static const std::regex TRAILING_PUNCTUATION("^.*[._]$");
+static const std::regex QUALIFIER_LEADING_PUNCTUATION("^[#\\$][._].*$");
+
+static const std::regex UNIQUE_INDICATOR(R"(^[^^~#!]+#[^~#!\/]+$)");
+static const std::regex MSG_CHANNEL_INDICATOR(R"(^[^^~#!]+~[^~#!\/]+$)");
+static const std::regex OWNER_INDICATOR(R"(^[^^~#!]+!$)");
+static const std::regex VOTE_INDICATOR(R"(^[^^~#!]+\^[^~#!\/]+$)");
+
+static const std::regex QUALIFIER_INDICATOR("^[#][A-Z0-9._]{3,}$");
+static const std::regex SUB_QUALIFIER_INDICATOR("^#[A-Z0-9._]+\\/#[A-Z0-9._]+$");
+static const std::regex RESTRICTED_INDICATOR("^[\\$][A-Z0-9._]{3,}$");
+
+static const std::regex SOTERIA_NAMES("^RVN$|^SOTER$|^SOTERIA$|^SOTERIA$|^#SOTER$|^#SOTERIA$|^#SOTERIA$");
+
+static const std::regex PUNYCODE_SUFFIX("^[A-Z0-9]+(-[A-Z0-9]+)*$");
+
+static bool Match(const std::string& str, const std::regex& re)
+{
+    return std::regex_match(str, re);
+}
+
+static bool IsRootNameValid(const std::string& name)
+{
+    return Match(name, ROOT_NAME_CHARACTERS) && !Match(name, DOUBLE_PUNCTUATION) && !Match(name, LEADING_PUNCTUATION)
+        && !Match(name, TRAILING_PUNCTUATION) && !Match(name, SOTERIA_NAMES);
+}
+
+static bool IsQualifierNameValid(const std::string& name)
+{
+    return Match(name, QUALIFIER_NAME_CHARACTERS) && !Match(name, DOUBLE_PUNCTUATION) && !Match(name, QUALIFIER_LEADING_PUNCTUATION)
+        && !Match(name, TRAILING_PUNCTUATION) && !Match(name, SOTERIA_NAMES);
+}
+
+static bool IsRestrictedNameValid(const std::string& name)
+{
+    return Match(name, RESTRICTED_NAME_CHARACTERS) && !Match(name, DOUBLE_PUNCTUATION) && !Match(name, LEADING_PUNCTUATION)
+        && !Match(name, TRAILING_PUNCTUATION) && !Match(name, SOTERIA_NAMES);
+}
+
+static bool IsSubQualifierNameValid(const std::string& name)
+{
+    return Match(name, SUB_QUALIFIER_NAME_CHARACTERS) && !Match(name, DOUBLE_PUNCTUATION) && !Match(name, LEADING_PUNCTUATION)
+        && !Match(name, TRAILING_PUNCTUATION);
+}
+
+static bool IsSubNameValid(const std::string& name)
+{
+    return Match(name, SUB_NAME_CHARACTERS) && !Match(name, DOUBLE_PUNCTUATION) && !Match(name, LEADING_PUNCTUATION)
+        && !Match(name, TRAILING_PUNCTUATION);
+}
+
+static bool IsMsgChannelTagValid(const std::string& tag)
+{
+    return Match(tag, MSG_CHANNEL_TAG_CHARACTERS) && !Match(tag, DOUBLE_PUNCTUATION) && !Match(tag, LEADING_PUNCTUATION)
+        && !Match(tag, TRAILING_PUNCTUATION);
+}
+
+static bool IsValidUppercasePunycode(const std::string& name)
+{
+    return name.length() >= 5 && name.substr(0, 4) == "XN--" && Match(name.substr(4), PUNYCODE_SUFFIX);
+}
+
+static bool IsAssetNameASubQualifier(const std::string& name)
+{
+    std::vector<std::string> parts;
+    boost::split(parts, name, boost::is_any_of("/"));
+    return IsQualifierNameValid(parts.front()) && parts.size() > 1;
+}
+
+static bool IsAssetNameASubasset(const std::string& name)
+{
+    std::vector<std::string> parts;
+    boost::split(parts, name, boost::is_any_of("/"));
+    return IsRootNameValid(parts.front()) && parts.size() > 1;
+}
+
+//! The indicator dispatch of IsAssetNameValid. The per type checks are shared with the validator under test.
+static bool IsAssetNameValid(const std::string& name, AssetType& assetType, std::string& error)
+{
+    if (name.length() > 128)
+        return false;
+
+    assetType = AssetType::INVALID;
+    AssetType type;
+    if (Match(name, UNIQUE_INDICATOR))
+        type = AssetType::UNIQUE;
+    else if (Match(name, MSG_CHANNEL_INDICATOR))
+        type = AssetType::MSGCHANNEL;
+    else if (Match(name, OWNER_INDICATOR))
+        type = AssetType::OWNER;
+    else if (Match(name, VOTE_INDICATOR))
+        type = AssetType::VOTE;
+    else if (Match(name, QUALIFIER_INDICATOR))
+        type = AssetType::QUALIFIER;
+    else if (Match(name, SUB_QUALIFIER_INDICATOR))
+        type = AssetType::SUB_QUALIFIER;
+    else if (Match(name, RESTRICTED_INDICATOR))
+        type = AssetType::RESTRICTED;
+    else
+        type = IsAssetNameASubasset(name) ? AssetType::SUB : AssetType::ROOT;
+
+    bool ret = IsTypeCheckNameValid(type, name, error);
+    if (ret) {
+        if (type == AssetType::QUALIFIER)
+            assetType = IsAssetNameASubQualifier(name) ? AssetType::SUB_QUALIFIER : AssetType::QUALIFIER;
+        else if (type == AssetType::SUB_QUALIFIER) {
+            if (IsAssetNameASubQualifier(name))
+                assetType = AssetType::SUB_QUALIFIER;
+        } else
+            assetType = type;
+    }
+    return ret;
+}
+
+static void ExtractVerifierStringQualifiers(const std::string& verifier, std::set<std::string>& qualifiers)
+{
+    std::string s(verifier);
+    std::regex regexSearch = std::regex(R"([A-Z0-9_.]+)");
+    std::smatch match;
+    while (std::regex_search(s, match, regexSearch)) {
+        for (auto str : match)
+            qualifiers.insert(str);
+        s = match.suffix().str();
+    }
+}
+
+} // namespace regex_reference
+
+BOOST_FIXTURE_TEST_SUITE(asset_name_tests, BasicTestingSetup)
+
+//! Random strings biased towards the characters the asset name grammar cares about
+static std::string RandomAssetName()
+{
+    static const std::string alphabet = "AAAAZZZZ000099999-.._#~!^/$@az(?\n";
+    static const std::vector<std::string> seeds = {
+        "SOTERIA", "SOTER", "#SOTER", "#KYC", "$TOKEN", "ROOT/SUB", "XN--ABC", "XN--A-B", "ROOT#TAG", "ROOT~CHAN",
+        "ROOT^VOTE", "ROOT!", "#Q/#SUB", "A.B", "A__B", "RVN"};
+
+    std::string name;
+    if (InsecureRandBool())
+        name = seeds[InsecureRandRange(seeds.size())];
+
+    int nEdits = InsecureRandRange(12);
+    for (int i = 0; i < nEdits; i++) {
+        char c = InsecureRandRange(16) == 0 ? (char)InsecureRandBits(8) : alphabet[InsecureRandRange(alphabet.size())];
+        size_t pos = InsecureRandRange(name.size() + 1);
+        if (!name.empty() && InsecureRandBool())
+            name[std::min(pos, name.size() - 1)] = c;
+        else
+            name.insert(pos, 1, c);
+    }
+    if (InsecureRandRange(32) == 0)
+        name += std::string(60 + InsecureRandRange(80), 'A');
+    return name;
+}
+
+BOOST_AUTO_TEST_CASE(asset_name_validator_matches_regex)
+{
+    for (int n = 0; n < 20000; n++) {
+        std::string name = RandomAssetName();
+
+        BOOST_CHECK_MESSAGE(IsRootNameValid(name) == regex_reference::IsRootNameValid(name), name);
+        BOOST_CHECK_MESSAGE(IsSubNameValid(name) == regex_reference::IsSubNameValid(name), name);
+        BOOST_CHECK_MESSAGE(IsQualifierNameValid(name) == regex_reference::IsQualifierNameValid(name), name);
+        BOOST_CHECK_MESSAGE(IsSubQualifierNameValid(name) == regex_reference::IsSubQualifierNameValid(name), name);
+        BOOST_CHECK_MESSAGE(IsRestrictedNameValid(name) == regex_reference::IsRestrictedNameValid(name), name);
+        BOOST_CHECK_MESSAGE(IsUniqueTagValid(name) == regex_reference::Match(name, regex_reference::UNIQUE_TAG_CHARACTERS), name);
+        BOOST_CHECK_MESSAGE(IsVoteTagValid(name) == regex_reference::Match(name, regex_reference::VOTE_TAG_CHARACTERS), name);
+        BOOST_CHECK_MESSAGE(IsMsgChannelTagValid(name) == regex_reference::IsMsgChannelTagValid(name), name);
+        BOOST_CHECK_MESSAGE(IsValidUppercasePunycode(name) == regex_reference::IsValidUppercasePunycode(name), name);
+
+        AssetType type = AssetType::INVALID, refType = AssetType::INVALID;
+        std::string error, refError;
+        bool valid = IsAssetNameValid(name, type, error);
+        BOOST_CHECK_MESSAGE(valid == regex_reference::IsAssetNameValid(name, refType, refError), name);
+        BOOST_CHECK_MESSAGE(type == refType, name);
+        BOOST_CHECK_MESSAGE(error == refError, name);
+
+        std::set<std::string> qualifiers, refQualifiers;
+        ExtractVerifierStringQualifiers(name, qualifiers);
+        regex_reference::ExtractVerifierStringQualifiers(name, refQualifiers);
+        BOOST_CHECK_MESSAGE(qualifiers == refQualifiers, name);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,16 @@
 
 BOOST_FIXTURE_TEST_SUITE(asset_tests, BasicTestingSetup)
 
+    static bool ThrowsRuntimeError(const std::string& formula, const LibBoolEE::Vals& vals)
+    {
+        try {
+            LibBoolEE::resolve(formula, vals);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
     BOOST_AUTO_TEST_CASE(name_validation_tests)
     {
         BOOST_TEST_MESSAGE("Running Name Validation Test");
@@ -730,4 +740,39 @@ BOOST_FIXTURE_TEST_SUITE(asset_tests, BasicTestingSetup)
     }
 
 
+    BOOST_AUTO_TEST_CASE(compiled_verifier_matches_resolve)
+    {
+        BOOST_TEST_MESSAGE("Running Compiled Verifier Differential Test");
+
+        const std::vector<std::string> variables = {"A", "B", "C", "D"};
+        static const char alphabet[] = "ABCD01!&|() ";
+
+        for (int n = 0; n < 20000; n++) {
+            std::string formula;
+            int length = 1 + InsecureRandRange(24);
+            for (int i = 0; i < length; i++)
+                formula += alphabet[InsecureRandRange(sizeof(alphabet) - 1)];
+
+            LibBoolEE::Program program;
+            bool compiled = true;
+            try {
+                program = LibBoolEE::compile(formula, variables);
+            } catch (const std::runtime_error&) {
+                compiled = false;
+            }
+
+            for (uint64_t valuation = 0; valuation < (uint64_t(1) << variables.size()); valuation++) {
+                LibBoolEE::Vals vals;
+                for (size_t i = 0; i < variables.size(); i++)
+                    vals.insert(make_pair(variables[i], ((valuation >> i) & 1) != 0));
+
+                if (!compiled) {
+                    BOOST_CHECK_MESSAGE(ThrowsRuntimeError(formula, vals), formula);
+                    break;
+                }
+                BOOST_CHECK_MESSAGE(program.evaluate(valuation) == LibBoolEE::resolve(formula, vals), formula);
+            }
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <assets/assets.h>
+#include <assets/assetsnapshotdb.h>
+#include <algorithm>
+#include <set>
 #include <string>
 #include <test/test_soteria.h>
 
@@ -175,4 +178,30 @@ BOOST_FIXTURE_TEST_SUITE(serialization_tests, BasicTestingSetup)
         BOOST_CHECK_MESSAGE(IsScriptNewMsgChannelAsset(scriptPubKey), "Script wasn't a message channel");
     }
 
+    BOOST_AUTO_TEST_CASE(asset_snapshot_entry_serialization)
+    {
+        BOOST_TEST_MESSAGE("Running Asset Snapshot Entry Serialization Test");
+
+        std::vector<std::pair<std::string, CAmount>> owners = {{"mz", 3}, {"ma", 1}, {"mfe", 2}};
+        CAssetSnapshotDBEntry entry("SNAPSHOT", 42, std::move(owners));
+
+        // Entries are kept sorted by address
+        BOOST_CHECK(std::is_sorted(entry.ownersAndAmounts.begin(), entry.ownersAndAmounts.end()));
+        BOOST_CHECK_EQUAL(entry.heightAndName, "42SNAPSHOT");
+
+        // Snapshots written with the old std::set layout load unchanged
+        std::set<std::pair<std::string, CAmount>> setOwners(entry.ownersAndAmounts.begin(), entry.ownersAndAmounts.end());
+        CDataStream ssOld(SER_DISK, CLIENT_VERSION);
+        ssOld << entry.height << entry.assetName << setOwners << entry.heightAndName;
+
+        CDataStream ssNew(SER_DISK, CLIENT_VERSION);
+        ssNew << entry;
+        BOOST_CHECK(ssOld.str() == ssNew.str());
+
+        CAssetSnapshotDBEntry loaded;
+        ssOld >> loaded;
+        BOOST_CHECK(loaded.ownersAndAmounts == entry.ownersAndAmounts);
+        BOOST_CHECK_EQUAL(loaded.assetName, "SNAPSHOT");
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -548,4 +548,102 @@ BOOST_FIXTURE_TEST_SUITE(miner_tests, TestingSetup)
         fCheckpointsEnabled = true;
     }
 
+    static CMutableTransaction CacheTestTx(const uint256& prevHash)
+    {
+        CMutableTransaction tx;
+        tx.vin.resize(1);
+        tx.vin[0].prevout = COutPoint(prevHash, 0);
+        tx.vin[0].scriptSig = CScript() << OP_1;
+        tx.vout.resize(1);
+        tx.vout[0].nValue = 1000;
+        tx.vout[0].scriptPubKey = CScript() << OP_TRUE;
+        return tx;
+    }
+
+    BOOST_AUTO_TEST_CASE(blocktemplatecache_test)
+    {
+        LOCK(cs_main);
+        CTxMemPool pool;
+        CBlockTemplateCache cache(pool);
+        TestMemPoolEntryHelper entry;
+        const CBlockIndex* pindexPrev = chainActive.Tip();
+
+        CMutableTransaction coinbase;
+        coinbase.vin.resize(1);
+        coinbase.vout.resize(1);
+        CMutableTransaction tx1 = CacheTestTx(InsecureRand256());
+        pool.addUnchecked(tx1.GetHash(), entry.Fee(10000).FromTx(tx1));
+
+        auto pblocktemplate = std::make_shared<CBlockTemplate>();
+        pblocktemplate->block.vtx = {MakeTransactionRef(coinbase), MakeTransactionRef(tx1)};
+        pblocktemplate->vTxFees = {-10000, 10000};
+        pblocktemplate->vTxSigOpsCost = {0, 4};
+
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1000));
+        cache.Set(pblocktemplate, pindexPrev, POW_TYPE_SOTERG, true, 1000);
+        BOOST_CHECK(cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1001) == pblocktemplate);
+
+        // A different tip, algorithm or segwit flag never hits
+        BOOST_CHECK(!cache.Get(pindexPrev->pprev, POW_TYPE_SOTERG, true, 1001));
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERC, true, 1001));
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERG, false, 1001));
+
+        // A transaction that fits is only picked up once the template is old enough
+        uint64_t nChanges = cache.GetChangeCount();
+        CMutableTransaction tx2 = CacheTestTx(InsecureRand256());
+        pool.addUnchecked(tx2.GetHash(), entry.Fee(10000).FromTx(tx2));
+        BOOST_CHECK_EQUAL(cache.GetChangeCount(), nChanges + 1);
+        BOOST_CHECK(cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1000 + CBlockTemplateCache::REFRESH_INTERVAL) == pblocktemplate);
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1001 + CBlockTemplateCache::REFRESH_INTERVAL));
+
+        // Removing a transaction outside the template keeps it, removing one in it does not
+        cache.Set(pblocktemplate, pindexPrev, POW_TYPE_SOTERG, true, 1000);
+        pool.removeRecursive(tx2);
+        BOOST_CHECK(cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1001) == pblocktemplate);
+        pool.removeRecursive(tx1);
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1001));
+
+        cache.Set(pblocktemplate, pindexPrev, POW_TYPE_SOTERG, true, 1000);
+        cache.Invalidate();
+        BOOST_CHECK(!cache.Get(pindexPrev, POW_TYPE_SOTERG, true, 1001));
+    }
+
+    //! Walk the miner's batches over [nNonce, nNonce + nCount) of a thread's range, checking each stays in bounds
+    static void CheckMinerBatches(uint32_t nNonce, uint64_t nCount, uint32_t nNonceEnd)
+    {
+        const uint64_t nStop = std::min<uint64_t>((uint64_t)nNonce + nCount, nNonceEnd);
+        while (nNonce < nStop) {
+            size_t nBatch = GetMinerHashBatch(nNonce, nNonceEnd);
+            BOOST_REQUIRE(nBatch > 0 && nBatch <= MINER_HASH_BATCH);
+            BOOST_CHECK((uint64_t)nNonce + nBatch <= nNonceEnd);
+            BOOST_CHECK_EQUAL(nNonce >> 8, (uint32_t)(nNonce + nBatch - 1) >> 8);
+            nNonce += nBatch;
+        }
+        BOOST_CHECK_EQUAL(GetMinerHashBatch(nNonceEnd, nNonceEnd), 0U);
+    }
+
+    BOOST_AUTO_TEST_CASE(miner_nonce_partition_test)
+    {
+        for (int nThreads : {1, 2, 3, 7, 16, 33, 64}) {
+            // The ranges follow on from each other, so they are disjoint and cover every nonce
+            uint32_t nNext = 0;
+            for (int i = 0; i < nThreads; i++) {
+                std::pair<uint32_t, uint32_t> range = GetMinerNonceRange(i, nThreads);
+                BOOST_CHECK_EQUAL(range.first, nNext);
+                BOOST_CHECK(range.second > range.first);
+                nNext = range.second;
+
+                // Most ranges neither start nor end on a multiple of 0x100
+                CheckMinerBatches(range.first, 0x1000, range.second);
+                CheckMinerBatches(range.second - 0x1000, 0x1000, range.second);
+            }
+            BOOST_CHECK_EQUAL(nNext, MAX_MINER_NONCE);
+        }
+
+        BOOST_CHECK_EQUAL(GetMinerHashBatch(0, 3), 3U);
+        BOOST_CHECK_EQUAL(GetMinerHashBatch(0xfd, 0x1000), 3U);
+        BOOST_CHECK_EQUAL(GetMinerHashBatch(0x100, 0x1000), MINER_HASH_BATCH);
+        BOOST_CHECK_EQUAL(GetMinerHashBatch(0x1001, 0x1000), 0U);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
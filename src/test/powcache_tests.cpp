@@ -0,0 +1,158 @@
+// Copyright (c) 2025-2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "chain.h"
+#include "primitives/powcache.h"
+#include "primitives/powcachestore.h"
+#include "test/test_soteria.h"
+#include "uint256.h"
+#include "validation.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+#include <map>
+#include <thread>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(powcache_tests, BasicTestingSetup)
+
+static std::map<uint256, uint256> LoadAll(CPowCacheStore& store)
+{
+    std::map<uint256, uint256> mapLoaded;
+    BOOST_CHECK(store.Load([&mapLoaded](const uint256& headerHash, const uint256& powHash) {
+        mapLoaded[headerHash] = powHash;
+    }));
+    return mapLoaded;
+}
+
+BOOST_AUTO_TEST_CASE(powcachestore_append_and_reload)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path();
+
+    std::vector<std::pair<uint256, uint256>> vEntries;
+    for (int i = 0; i < 100; i++)
+        vEntries.emplace_back(InsecureRand256(), InsecureRand256());
+
+    {
+        CPowCacheStore store(path);
+        BOOST_CHECK(LoadAll(store).empty());
+        BOOST_CHECK(store.Append({vEntries.begin(), vEntries.begin() + 60}));
+        BOOST_CHECK(store.Append({vEntries.begin() + 60, vEntries.end()}));
+        BOOST_CHECK_EQUAL(store.GetRecordCount(), 100U);
+    }
+
+    CPowCacheStore store(path);
+    std::map<uint256, uint256> mapLoaded = LoadAll(store);
+    BOOST_CHECK_EQUAL(mapLoaded.size(), 100U);
+    for (const auto& entry : vEntries)
+        BOOST_CHECK(mapLoaded[entry.first] == entry.second);
+
+    // A later record for the same header supersedes the earlier one
+    uint256 replaced = InsecureRand256();
+    BOOST_CHECK(store.Append({{vEntries[0].first, replaced}}));
+    store.Close();
+    mapLoaded = LoadAll(store);
+    BOOST_CHECK(mapLoaded[vEntries[0].first] == replaced);
+    store.Close();
+
+    fs::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(powcachestore_torn_and_corrupt_records)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path();
+
+    std::vector<std::pair<uint256, uint256>> vEntries;
+    for (int i = 0; i < 10; i++)
+        vEntries.emplace_back(InsecureRand256(), InsecureRand256());
+    {
+        CPowCacheStore store(path);
+        LoadAll(store);
+        BOOST_CHECK(store.Append(vEntries));
+    }
+
+    // Flip a byte in the third record and leave half a record at the end
+    FILE* file = fsbridge::fopen(path, "rb+");
+    BOOST_REQUIRE(file);
+    fseek(file, CPowCacheStore::HEADER_SIZE + 2 * CPowCacheStore::RECORD_SIZE + 5, SEEK_SET);
+    fputc(0xff ^ vEntries[2].first.begin()[5], file);
+    fseek(file, 0, SEEK_END);
+    std::vector<unsigned char> vPartial(CPowCacheStore::RECORD_SIZE / 2, 0xab);
+    fwrite(vPartial.data(), 1, vPartial.size(), file);
+    fclose(file);
+
+    CPowCacheStore store(path);
+    std::map<uint256, uint256> mapLoaded = LoadAll(store);
+    BOOST_CHECK_EQUAL(mapLoaded.size(), 9U);
+    BOOST_CHECK(!mapLoaded.count(vEntries[2].first));
+    BOOST_CHECK_EQUAL(store.GetCorruptCount(), 1U);
+
+    // The partial record was cut off, so appends stay aligned
+    BOOST_CHECK_EQUAL(fs::file_size(path), CPowCacheStore::HEADER_SIZE + 10 * CPowCacheStore::RECORD_SIZE);
+    BOOST_CHECK(store.Append({vEntries[2]}));
+    store.Close();
+    BOOST_CHECK_EQUAL(LoadAll(store).size(), 10U);
+    store.Close();
+
+    fs::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(powcache_flush_persists_new_entries)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path();
+    uint256 headerHash = InsecureRand256();
+    uint256 powHash = InsecureRand256();
+
+    {
+        CPowCache cache(1000);
+        BOOST_CHECK(cache.Open(path));
+        cache.insert(headerHash, powHash);
+        BOOST_CHECK(cache.Flush());
+    }
+
+    {
+        CPowCache cache(1000);
+        BOOST_CHECK(cache.Open(path));
+        uint256 result;
+        BOOST_CHECK(cache.get(headerHash, result));
+        BOOST_CHECK(result == powHash);
+    }
+
+    fs::remove(path);
+}
+
+BOOST_FIXTURE_TEST_CASE(powcache_headers_message_hashed_without_cs_main, TestingSetup)
+{
+    // A 2000 header message the cache has not seen yet
+    std::vector<CBlockHeader> headers(2000, chainActive.Tip()->GetBlockHeader());
+    for (size_t i = 0; i < headers.size(); i++)
+        headers[i].nNonce = i + 1;
+    CPowCache& cache = CPowCache::Instance();
+    for (const CBlockHeader& header : headers)
+        cache.erase(header.GetSHA256Hash());
+
+    // Another thread holds cs_main throughout, so none of the hashing can
+    // happen in the handler's cs_main section
+    std::promise<void> locked, done;
+    std::thread holder([&locked, &done]() {
+        LOCK(cs_main);
+        locked.set_value();
+        done.get_future().wait();
+    });
+    locked.get_future().wait();
+    std::vector<uint256> vHashes = GetBlockHeadersPoWHashes(headers);
+    done.set_value();
+    holder.join();
+
+    BOOST_REQUIRE_EQUAL(vHashes.size(), headers.size());
+    for (size_t i = 0; i < headers.size(); i++) {
+        uint256 powHash;
+        BOOST_CHECK(cache.get(headers[i].GetSHA256Hash(), powHash));
+        BOOST_CHECK(powHash == vHashes[i]);
+        BOOST_CHECK(vHashes[i] == headers[i].ComputePoWHash());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,258 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "smartcontracts/contractexecutor.h"
+#include "smartcontracts/smartcontracts.h"
+#include "fs.h"
+#include "rpc/server.h"
+#include "test/test_soteria.h"
+#include "util/time.h"
+#include <util/system.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+BOOST_FIXTURE_TEST_SUITE(smartcontracts_tests, BasicTestingSetup)
+
+static void WriteContract(const fs::path& path, const std::string& source)
+{
+    std::ofstream file(path.string(), std::ios::trunc);
+    file << source;
+}
+
+BOOST_AUTO_TEST_CASE(smartcontracts_globals_do_not_leak_between_calls)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path,
+        "function bump() counter = (counter or 0) + 1; return tostring(counter) end\n"
+        "function echo(a, b) return a .. b end\n"
+        "function tamper() rawset(_G, 'leaked', 1); load('loaded = 1')(); getmetatable('').__index.rep = nil; tostring = nil; return 'done' end\n"
+        "function check() return tostring(leaked) .. tostring(loaded) .. ('ab'):rep(2) end\n");
+
+    for (int i = 0; i < 3; i++) {
+        SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "bump");
+        BOOST_CHECK(!result.is_error);
+        BOOST_CHECK_EQUAL(result.result, "1");
+    }
+
+    SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "echo", {"abc", "def"});
+    BOOST_CHECK(!result.is_error);
+    BOOST_CHECK_EQUAL(result.result, "abcdef");
+
+    result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "missing");
+    BOOST_CHECK(result.is_error);
+
+    // Changes made to the globals and libraries themselves are undone too
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "tamper").result, "done");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "check").result, "nilnilabab");
+
+    fs::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(smartcontracts_recompile_changed_file)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path, "function f() return 'old' end\n");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "f").result, "old");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "f").result, "old");
+
+    // Same size, and most likely within the same second as the last write
+    WriteContract(path, "function f() return 'new' end\n");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "f").result, "new");
+
+    WriteContract(path, "function f() return 'newer' end\n");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "f").result, "newer");
+
+    WriteContract(path, "function f( return end\n");
+    BOOST_CHECK(CSoteriaSmartContracts::RunFile(path.string().c_str(), "f").is_error);
+
+    fs::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(smartcontracts_metering_limits)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path,
+        "function spin() while true do end end\n"
+        "function catchy() while true do pcall(spin) end end\n"
+        "function hog() local t = {} for i = 1, 1e9 do t[i] = ('x'):rep(1024) .. i end end\n"
+        "function sum(n) local s = 0 for i = 1, tonumber(n) do s = s + i end return tostring(s) end\n"
+        "function finalizer() setmetatable({}, {__gc = function() while true do end end}) collectgarbage() return 'done' end\n");
+
+    // Identical calls cost the same gas, and more work costs more gas
+    SmartContractResult small = CSoteriaSmartContracts::RunFile(path.string().c_str(), "sum", {"10000"});
+    BOOST_CHECK_EQUAL(small.result, "50005000");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "sum", {"10000"}).gas, small.gas);
+    BOOST_CHECK(CSoteriaSmartContracts::RunFile(path.string().c_str(), "sum", {"100000"}).gas > small.gas);
+
+    gArgs.ForceSetArg("-smartcontractgaslimit", "1000000");
+    SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "spin");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK(result.result.find("Out of gas") != std::string::npos);
+    BOOST_CHECK(result.gas > 1000000);
+
+    // The error ending the call can't be caught by the contract
+    result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "catchy");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK(result.result.find("Out of gas") != std::string::npos);
+
+    gArgs.ForceSetArg("-smartcontractgaslimit", "1000000000000");
+    gArgs.ForceSetArg("-smartcontracttimeout", "100");
+    result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "spin");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK(result.result.find("time limit") != std::string::npos);
+
+    gArgs.ForceSetArg("-smartcontractmaxmemory", "4");
+    gArgs.ForceSetArg("-smartcontracttimeout", "60000");
+    result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "hog");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK_EQUAL(result.result, "Memory limit exceeded.");
+    BOOST_CHECK(result.memory <= 4 * 1024 * 1024);
+
+    // Finalizers run with hooks off and so can't be metered; contracts can't install them
+    gArgs.ForceSetArg("-smartcontracttimeout", "100");
+    int64_t nStart = GetTimeMillis();
+    result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "finalizer");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK(result.result.find("__gc") != std::string::npos);
+    BOOST_CHECK(GetTimeMillis() - nStart < 1000);
+
+    // A state that hit a limit does not affect the next call
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "sum", {"10"}).result, "55");
+
+    gArgs.ForceSetArg("-smartcontractgaslimit", std::to_string(DEFAULT_SMARTCONTRACT_GAS_LIMIT));
+    gArgs.ForceSetArg("-smartcontractmaxmemory", std::to_string(DEFAULT_SMARTCONTRACT_MAX_MEMORY));
+    gArgs.ForceSetArg("-smartcontracttimeout", std::to_string(DEFAULT_SMARTCONTRACT_TIMEOUT));
+    fs::remove(path);
+}
+
+BOOST_FIXTURE_TEST_CASE(smartcontracts_native_rpc_values, TestingSetup)
+{
+    if (RPCIsInWarmup(nullptr))
+        SetRPCWarmupFinished();
+
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path,
+        "function native()\n"
+        "  local r = soteria.util.call('echo', {a = 1, b = {1, 2, 'x'}}, 2.5, true, json.null, '10')\n"
+        "  assert(r[1].a == 1 and math.type(r[1].a) == 'integer')\n"
+        "  assert(#r[1].b == 3 and r[1].b[3] == 'x')\n"
+        "  assert(r[2] == 2.5 and r[3] == true and r[4] == json.null and r[5] == '10')\n"
+        "  return 'ok'\n"
+        "end\n"
+        "function converted()\n"
+        "  local r = soteria.util.call('echojson', '10', '[1,2]')\n"
+        "  return math.type(r[1]) .. #r[2]\n"
+        "end\n"
+        "function failing()\n"
+        "  local ok, err = pcall(soteria.util.call, 'nosuchmethod')\n"
+        "  return tostring(ok) .. ' ' .. err\n"
+        "end\n"
+        "function legacy()\n"
+        "  return type(soteria.util.nodeuptime())\n"
+        "end\n"
+        "function oversized()\n"
+        "  local t = {}\n"
+        "  for i = 1, 30000 do t[i] = ('x'):rep(100) .. i end\n"
+        "  return #soteria.util.call('echo', t)[1]\n"
+        "end\n");
+
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "native").result, "ok");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "converted").result, "integer2");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "failing").result, "false Method not found");
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "legacy").result, "string");
+
+    // Running out of memory while the result is pushed ends the call cleanly
+    gArgs.ForceSetArg("-smartcontractmaxmemory", "8");
+    SmartContractResult result = CSoteriaSmartContracts::RunFile(path.string().c_str(), "oversized");
+    BOOST_CHECK(result.is_error);
+    BOOST_CHECK_EQUAL(result.result, "Memory limit exceeded.");
+    gArgs.ForceSetArg("-smartcontractmaxmemory", std::to_string(DEFAULT_SMARTCONTRACT_MAX_MEMORY));
+    BOOST_CHECK_EQUAL(CSoteriaSmartContracts::RunFile(path.string().c_str(), "native").result, "ok");
+
+    fs::remove(path);
+}
+
+BOOST_FIXTURE_TEST_CASE(smartcontracts_executor_runs_jobs, TestingSetup)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path,
+        "function add(a, b) return tostring(tonumber(a) + tonumber(b)) end\n"
+        "function fail() error('failed') end\n");
+
+    CContractExecutor executor(2, 16);
+    std::vector<uint64_t> vIds;
+    for (int i = 0; i < 8; i++) {
+        uint64_t nId;
+        BOOST_CHECK(executor.Submit("test", path.string(), i == 7 ? "fail" : "add", {std::to_string(i), "100"}, nId));
+        vIds.push_back(nId);
+    }
+
+    for (size_t i = 0; i < vIds.size(); i++) {
+        CContractJob job;
+        for (int n = 0; n < 1000; n++) {
+            BOOST_REQUIRE(executor.GetJob(vIds[i], job));
+            if (job.status == CContractJob::DONE)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        BOOST_CHECK_EQUAL(job.StatusString(), "done");
+        if (i == 7) {
+            BOOST_CHECK(job.result.is_error);
+        } else {
+            BOOST_CHECK(!job.result.is_error);
+            BOOST_CHECK_EQUAL(job.result.result, std::to_string(i + 100));
+        }
+    }
+
+    CContractJob job;
+    BOOST_CHECK(!executor.GetJob(vIds.back() + 1, job));
+
+    // Jobs are no longer taken once interrupted
+    executor.Interrupt();
+    uint64_t nId;
+    BOOST_CHECK(!executor.Submit("test", path.string(), "add", {"1", "2"}, nId));
+    executor.Stop();
+
+    fs::remove(path);
+}
+
+BOOST_FIXTURE_TEST_CASE(smartcontracts_executor_interrupts_running_calls, TestingSetup)
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.lua");
+    WriteContract(path, "function spin() while true do end end\n");
+
+    // Neither gas nor time would ever stop this call
+    gArgs.ForceSetArg("-smartcontractgaslimit", "0");
+    gArgs.ForceSetArg("-smartcontracttimeout", "0");
+
+    CContractExecutor executor(1, 16);
+    uint64_t nId;
+    BOOST_REQUIRE(executor.Submit("test", path.string(), "spin", {}, nId));
+    CContractJob job;
+    for (int n = 0; n < 1000 && job.status != CContractJob::RUNNING; n++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        BOOST_REQUIRE(executor.GetJob(nId, job));
+    }
+    BOOST_CHECK_EQUAL(job.StatusString(), "running");
+
+    int64_t nStart = GetTimeMillis();
+    executor.Interrupt();
+    executor.Stop();
+    BOOST_CHECK(GetTimeMillis() - nStart < 5000);
+    BOOST_REQUIRE(executor.GetJob(nId, job));
+    BOOST_CHECK_EQUAL(job.StatusString(), "done");
+    BOOST_CHECK(job.result.is_error);
+    BOOST_CHECK(job.result.result.find("Interrupted") != std::string::npos);
+
+    gArgs.ForceSetArg("-smartcontractgaslimit", std::to_string(DEFAULT_SMARTCONTRACT_GAS_LIMIT));
+    gArgs.ForceSetArg("-smartcontracttimeout", std::to_string(DEFAULT_SMARTCONTRACT_TIMEOUT));
+    fs::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// soterc.h pulls in soterg.h, which has its own Hash() and CHashWriter, so this
+// file stays away from hash.h and the test fixtures that pull it in.
+#include "algo/soterc/soterc.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(soterc_context_tests)
+
+//! Soterc as computed before SotercContext: a garden linked for this hash alone and the yespower_tls memory
+static uint256 SotercFreshGarden(const std::string& data, bool sotercHardened)
+{
+    SotercGarden garden;
+    LinkSotercGarden(&garden);
+
+    uint512 hash;
+    sph_sha512_init(&garden.context_sha2);
+    sph_sha512(&garden.context_sha2, data.data(), data.size());
+    sph_sha512_close(&garden.context_sha2, static_cast<void*>(&hash));
+    for (int i = 0; i < SOTERC_TREE_NODES; i++)
+        garden.nodes[i].algo = hash.ByteAt(i) % SOTERC_ALGO_COUNT;
+    if (sotercHardened)
+        garden.nodes[21].algo = SOTERC_ALGO_COUNT;
+    return TraverseSotercGarden(&garden, hash, &garden.nodes[0], NULL).trim256();
+}
+
+BOOST_AUTO_TEST_CASE(soterc_context_matches_fresh_garden)
+{
+    SotercContext context, other;
+    for (int i = 0; i < 8; i++) {
+        std::string data = "soterc context " + std::to_string(i);
+        for (bool sotercHardened : {true, false}) {
+            uint256 expected = SotercFreshGarden(data, sotercHardened);
+            // Contexts keep state between hashes, so reuse has to give the same results
+            for (int n = 0; n < 2; n++) {
+                BOOST_CHECK(Soterc(data.begin(), data.end(), context, sotercHardened) == expected);
+                BOOST_CHECK(Soterc(data.begin(), data.end(), other, sotercHardened) == expected);
+                BOOST_CHECK(Soterc(data.begin(), data.end(), sotercHardened) == expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(yespower_prealloc_matches_on_demand)
+{
+    yespower_local_t prealloc, onDemand;
+    BOOST_CHECK_EQUAL(yespower_init_local_prealloc(&prealloc, &yespower_params), 0);
+    BOOST_CHECK(prealloc.aligned != NULL);
+    yespower_init_local(&onDemand);
+
+    void* aligned = prealloc.aligned;
+    for (unsigned char i = 0; i < 4; i++) {
+        unsigned char input[80] = {i};
+        yespower_binary_t expected, computed;
+        BOOST_CHECK_EQUAL(yespower(&onDemand, input, sizeof(input), &yespower_params, &expected), 0);
+        BOOST_CHECK_EQUAL(yespower(&prealloc, input, sizeof(input), &yespower_params, &computed), 0);
+        BOOST_CHECK(memcmp(&expected, &computed, sizeof(expected)) == 0);
+    }
+    // The preallocated memory was big enough, yespower() did not replace it
+    BOOST_CHECK(prealloc.aligned == aligned);
+
+    yespower_params_t invalid = yespower_params;
+    invalid.N = 1000;
+    yespower_local_t rejected;
+    BOOST_CHECK_EQUAL(yespower_init_local_prealloc(&rejected, &invalid), -1);
+    BOOST_CHECK(rejected.aligned == NULL);
+
+    BOOST_CHECK_EQUAL(yespower_free_local(&prealloc), 0);
+    BOOST_CHECK_EQUAL(yespower_free_local(&onDemand), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
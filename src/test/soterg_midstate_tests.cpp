@@ -0,0 +1,146 @@
+// Copyright (c) 2026 The Soteria Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// soterg.h has its own Hash() and CHashWriter, so this file stays away from
+// hash.h and the test fixtures that pull it in.
+#include "algo/soterg/soterg.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(soterg_midstate_tests)
+
+//! Headers and hash selections derived from a running SHA512 chain, so every X12R first round shows up
+static void NextInput(uint512& seed, unsigned char header[80], uint256& hashSelection)
+{
+    sph_sha512_context ctx;
+    sph_sha512_init(&ctx);
+    sph_sha512(&ctx, seed.begin(), 64);
+    sph_sha512_close(&ctx, seed.begin());
+    memcpy(header, seed.begin(), 64);
+    memcpy(header + 64, seed.begin(), 16);
+    hashSelection = seed.trim256();
+}
+
+BOOST_AUTO_TEST_CASE(x12_midstate_matches_full_hash)
+{
+    uint512 seed;
+    unsigned char header[80];
+    uint256 hashSelection;
+    bool fFirstRoundSeen[X12_ROUNDS] = {};
+
+    for (int n = 0; n < 200; n++) {
+        NextInput(seed, header, hashSelection);
+
+        CX12Midstate x12r, x12st;
+        x12r.InitX12R(header, hashSelection);
+        x12st.InitX12ST(header);
+        fFirstRoundSeen[GetHashSelection(hashSelection, 0)] = true;
+
+        for (uint32_t nNonce : {0u, 1u, 0x100u, 0xdeadbeefu, ReadLE32(header + 76)}) {
+            memcpy(header + CX12Midstate::PREFIX_SIZE, &nNonce, sizeof(nNonce));
+            BOOST_CHECK(x12r.Hash(nNonce) == HashX12R(header, header + 80, hashSelection));
+            BOOST_CHECK(x12st.Hash(nNonce) == HashX12ST(header, header + 80, hashSelection));
+        }
+    }
+
+    for (int i = 0; i < X12_ROUNDS; i++)
+        BOOST_CHECK_MESSAGE(fFirstRoundSeen[i], GetSphFunctions512(static_cast<SphAlgo512>(i)).name);
+}
+
+BOOST_AUTO_TEST_CASE(x12_midstate_chain)
+{
+    unsigned char header[80] = {};
+    CX12Midstate midstate;
+
+    midstate.InitX12ST(header);
+    BOOST_CHECK(std::equal(X12ST_CHAIN, X12ST_CHAIN + X12_ROUNDS, midstate.GetChain()));
+    // None of its functions has a multi-buffer kernel, so it is never batched
+    BOOST_CHECK(!HasMultiHashRounds(X12ST_CHAIN));
+
+    uint256 hashSelection = uint256S("0x0000000000000000000000000000000000000000000000000123456789ab0000");
+    midstate.InitX12R(header, hashSelection);
+    for (int i = 0; i < X12_ROUNDS; i++)
+        BOOST_CHECK(midstate.GetChain()[i] == static_cast<SphAlgo512>(GetHashSelection(hashSelection, i)));
+}
+
+BOOST_AUTO_TEST_CASE(multihash_matches_sph)
+{
+    uint512 seed;
+    unsigned char header[80];
+    uint256 hashSelection;
+
+    const struct {
+        MultiHash512Fn multi;
+        SphAlgo512 algo;
+    } vFunctions[] = {
+        {Blake512x4_64, SphAlgo512::BLAKE},
+        {Keccak512x4_64, SphAlgo512::KECCAK},
+        {Skein512x4_64, SphAlgo512::SKEIN},
+        {CubeHash512x4_64, SphAlgo512::CUBEHASH},
+    };
+
+    for (const auto& function : vFunctions) {
+        const SphFunctions512& sph = GetSphFunctions512(function.algo);
+        for (int n = 0; n < 50; n++) {
+            uint512 lanes[MULTIHASH_LANES], expected[MULTIHASH_LANES];
+            const unsigned char* in[MULTIHASH_LANES];
+            unsigned char* out[MULTIHASH_LANES];
+            for (size_t lane = 0; lane < MULTIHASH_LANES; lane++) {
+                NextInput(seed, header, hashSelection);
+                lanes[lane] = seed;
+                SphContext512 ctx;
+                sph.init(&ctx);
+                sph.write(&ctx, lanes[lane].begin(), 64);
+                sph.close(&ctx, expected[lane].begin());
+                in[lane] = out[lane] = lanes[lane].begin();
+            }
+            // In place, as HashX12Rounds uses it
+            function.multi(in, out);
+            for (size_t lane = 0; lane < MULTIHASH_LANES; lane++)
+                BOOST_CHECK_MESSAGE(lanes[lane] == expected[lane], sph.name);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(x12_rounds_batch_matches_midstate)
+{
+    uint512 seed;
+    unsigned char header[80];
+    uint256 hashSelection;
+
+    // Mixed chains and batch sizes that leave short groups behind
+    for (size_t nBatch : {1, 2, 5, 37}) {
+        std::vector<CX12Midstate> vMidstates(nBatch);
+        std::vector<const SphAlgo512*> vChains;
+        std::vector<uint512> vRounds(nBatch);
+        std::vector<uint256> vExpected;
+        for (size_t i = 0; i < nBatch; i++) {
+            NextInput(seed, header, hashSelection);
+            if (i % 3 == 2)
+                vMidstates[i].InitX12ST(header);
+            else
+                vMidstates[i].InitX12R(header, hashSelection);
+            vChains.push_back(vMidstates[i].GetChain());
+            vMidstates[i].HashFirstRound(ReadLE32(header + 76), vRounds[i]);
+            vExpected.push_back(vMidstates[i].Hash(ReadLE32(header + 76)));
+        }
+        HashX12Rounds(vChains.data(), vRounds.data(), nBatch);
+        for (size_t i = 0; i < nBatch; i++)
+            BOOST_CHECK(vRounds[i].trim256() == vExpected[i]);
+    }
+
+    // The nonce range version a miner uses
+    NextInput(seed, header, hashSelection);
+    CX12Midstate midstate;
+    midstate.InitX12R(header, hashSelection);
+    uint256 hashes[11];
+    midstate.Hash(0xfffffffau, hashes, 11);
+    for (uint32_t i = 0; i < 11; i++)
+        BOOST_CHECK(hashes[i] == midstate.Hash(0xfffffffau + i));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
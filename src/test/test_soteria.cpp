@@ -89,8 +89,10 @@ TestingSetup::TestingSetup(const std::string &chainName) : BasicTestingSetup(cha
         }
     }
     nScriptCheckThreads = 3;
-    for (int i = 0; i < nScriptCheckThreads - 1; i++)
+    for (int i = 0; i < nScriptCheckThreads - 1; i++) {
         threadGroup.create_thread(&ThreadScriptCheck);
+        threadGroup.create_thread(&ThreadHeaderPoWCheck);
+    }
     g_connman = std::unique_ptr<CConnman>(new CConnman(0x1337, 0x1337)); // Deterministic randomness for tests.
     connman = g_connman.get();
     peerLogic.reset(new PeerLogicValidation(connman, scheduler));
@@ -11,8 +11,10 @@
 #include "validation.h"
 #include "miner.h"
 #include "pubkey.h"
+#include "pqkey.h"
 #include "txmempool.h"
 #include "random.h"
+#include "script/sigcache.h"
 #include "script/standard.h"
 #include "script/sign.h"
 #include "test/test_soteria.h"
@@ -395,4 +397,45 @@ BOOST_AUTO_TEST_SUITE(tx_validationcache_tests)
         }
     }
 
+    BOOST_FIXTURE_TEST_CASE(pq_sigcache_test, BasicTestingSetup)
+    {
+        CPQKey key;
+        key.MakeNewKey();
+        std::vector<unsigned char> vchPubKey = key.GetPubKey().GetVch();
+        uint256 sighash = GetRandHash();
+        std::vector<unsigned char> vchSig;
+        BOOST_CHECK(key.Sign(sighash, vchSig));
+
+        CTransaction tx;
+        PrecomputedTransactionData txdata(tx);
+        // Mempool acceptance stores results, block connection uses them up
+        CachingTransactionSignatureChecker storing(&tx, 0, 0, true, txdata);
+        CachingTransactionSignatureChecker connecting(&tx, 0, 0, false, txdata);
+
+        PQSignatureCacheStats before = GetPQSignatureCacheStats();
+        BOOST_CHECK(before.nMaxElements > 0);
+
+        // A miss verifies and inserts, after which the same check hits
+        BOOST_CHECK(storing.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        BOOST_CHECK(storing.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        PQSignatureCacheStats stats = GetPQSignatureCacheStats();
+        BOOST_CHECK_EQUAL(stats.nMisses - before.nMisses, 1U);
+        BOOST_CHECK_EQUAL(stats.nHits - before.nHits, 1U);
+
+        // Connecting hits and erases the entry, so checking it again misses
+        BOOST_CHECK(connecting.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        BOOST_CHECK(connecting.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        stats = GetPQSignatureCacheStats();
+        BOOST_CHECK_EQUAL(stats.nMisses - before.nMisses, 2U);
+        BOOST_CHECK_EQUAL(stats.nHits - before.nHits, 2U);
+
+        // An invalid signature is never cached
+        vchSig[0] ^= 1;
+        BOOST_CHECK(!storing.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        BOOST_CHECK(!storing.VerifyPQSignature(vchSig, vchPubKey, sighash));
+        stats = GetPQSignatureCacheStats();
+        BOOST_CHECK_EQUAL(stats.nMisses - before.nMisses, 4U);
+        BOOST_CHECK_EQUAL(stats.nHits - before.nHits, 2U);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -18,6 +18,7 @@
 #include <functional>
 #include <boost/thread.hpp>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -27,6 +28,7 @@ static constexpr char DB_BLOCK_FILES = 'f';
 static constexpr char DB_TXINDEX = 't';
 static constexpr char DB_ADDRESSINDEX = 'a';
 static constexpr char DB_ADDRESSUNSPENTINDEX = 'u';
+static constexpr char DB_ADDRESSBALANCEINDEX = 'w';
 static constexpr char DB_TIMESTAMPINDEX = 's';
 static constexpr char DB_BLOCKHASHINDEX = 'z';
 static constexpr char DB_SPENTINDEX = 'p';
@@ -354,9 +356,39 @@ bool CBlockTreeDB::ReadAddressUnspentIndex(uint160 addressHash, int type, std::v
     return true;
 }
 
+void CBlockTreeDB::UpdateAddressBalanceIndex(CDBBatch& batch, const std::vector<std::pair<CAddressIndexKey, CAmount>>& vect, bool fErase)
+{
+    std::map<std::tuple<unsigned int, uint160, std::string>, CAddressBalanceValue> mapDeltas;
+    for (std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = vect.begin(); it != vect.end(); it++) {
+        // Only count entries the address index does not have yet (or still has, when erasing),
+        // so that connecting or disconnecting a block again after a crash leaves the totals intact
+        if (Exists(std::make_pair(DB_ADDRESSINDEX, it->first)) != fErase)
+            continue;
+        CAddressBalanceValue& delta = mapDeltas[std::make_tuple(it->first.type, it->first.hashBytes, it->first.asset)];
+        CAmount nSign = fErase ? -1 : 1;
+        if (it->second > 0)
+            delta.received += nSign * it->second;
+        delta.balance += nSign * it->second;
+    }
+
+    for (const auto& delta : mapDeltas) {
+        CAddressIndexIteratorAssetKey key(std::get<0>(delta.first), std::get<1>(delta.first), std::get<2>(delta.first));
+        CAddressBalanceValue value;
+        Read(std::make_pair(DB_ADDRESSBALANCEINDEX, key), value);
+        value.received += delta.second.received;
+        value.balance += delta.second.balance;
+        if (value.IsNull()) {
+            batch.Erase(std::make_pair(DB_ADDRESSBALANCEINDEX, key));
+        } else {
+            batch.Write(std::make_pair(DB_ADDRESSBALANCEINDEX, key), value);
+        }
+    }
+}
+
 bool CBlockTreeDB::WriteAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount>>& vect)
 {
     CDBBatch batch(*this);
+    UpdateAddressBalanceIndex(batch, vect, false);
     for (std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = vect.begin(); it != vect.end(); it++)
         batch.Write(std::make_pair(DB_ADDRESSINDEX, it->first), it->second);
     return WriteBatch(batch);
@@ -365,6 +397,7 @@ bool CBlockTreeDB::WriteAddressIndex(const std::vector<std::pair<CAddressIndexKe
 bool CBlockTreeDB::EraseAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount>>& vect)
 {
     CDBBatch batch(*this);
+    UpdateAddressBalanceIndex(batch, vect, true);
     for (std::vector<std::pair<CAddressIndexKey, CAmount>>::const_iterator it = vect.begin(); it != vect.end(); it++)
         batch.Erase(std::make_pair(DB_ADDRESSINDEX, it->first));
     return WriteBatch(batch);
@@ -410,6 +443,158 @@ bool CBlockTreeDB::ReadAddressIndex(uint160 addressHash, int type, std::vector<s
     return CBlockTreeDB::ReadAddressIndex(addressHash, type, "", addressIndex, start, end);
 }
 
+CAddressIndexCursor::CAddressIndexCursor(CDBIterator* pcursorIn, unsigned int typeIn, const uint160& hashBytesIn, const std::string& assetIn, int endIn) :
+    pcursor(pcursorIn), type(typeIn), hashBytes(hashBytesIn), asset(assetIn), end(endIn), fValid(false), nValue(0)
+{
+    ReadCurrent();
+}
+
+void CAddressIndexCursor::ReadCurrent()
+{
+    std::pair<char, CAddressIndexKey> keyTmp;
+    fValid = pcursor->Valid() && pcursor->GetKey(keyTmp) && keyTmp.first == DB_ADDRESSINDEX &&
+             keyTmp.second.type == type && keyTmp.second.hashBytes == hashBytes && keyTmp.second.asset == asset &&
+             (end <= 0 || keyTmp.second.blockHeight <= end) && pcursor->GetValue(nValue);
+    if (fValid)
+        key = keyTmp.second;
+}
+
+void CAddressIndexCursor::Next()
+{
+    if (!fValid)
+        return;
+    pcursor->Next();
+    ReadCurrent();
+}
+
+std::unique_ptr<CAddressIndexCursor> CBlockTreeDB::ReadAddressIndexCursor(uint160 addressHash, int type, std::string assetName, int start, int end)
+{
+    CDBIterator* pcursor = NewIterator();
+    pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, addressHash, assetName, std::max(start, 0))));
+    return std::unique_ptr<CAddressIndexCursor>(new CAddressIndexCursor(pcursor, type, addressHash, assetName, end));
+}
+
+bool CBlockTreeDB::ReadAddressIndexAssets(uint160 addressHash, int type, std::vector<std::string>& assetNames)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorKey(type, addressHash)));
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, CAddressIndexKey> key;
+        if (pcursor->GetKey(key) && key.first == DB_ADDRESSINDEX && key.second.type == (unsigned int)type && key.second.hashBytes == addressHash) {
+            assetNames.push_back(key.second.asset);
+            // Heights are stored big-endian, so the largest height is past every entry of this asset
+            pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, addressHash, key.second.asset, -1)));
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool CBlockTreeDB::ReadAddressBalanceIndex(uint160 addressHash, int type, std::string assetName, CAddressBalanceValue& value)
+{
+    value.SetNull();
+    Read(std::make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorAssetKey(type, addressHash, assetName)), value);
+    return true;
+}
+
+bool CBlockTreeDB::ReadAddressBalanceIndex(uint160 addressHash, int type, std::vector<std::pair<std::string, CAddressBalanceValue>>& balances)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    pcursor->Seek(std::make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorKey(type, addressHash)));
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, CAddressIndexIteratorAssetKey> key;
+        if (pcursor->GetKey(key) && key.first == DB_ADDRESSBALANCEINDEX && key.second.type == (unsigned int)type && key.second.hashBytes == addressHash) {
+            CAddressBalanceValue value;
+            if (pcursor->GetValue(value)) {
+                balances.push_back(std::make_pair(key.second.asset, value));
+                pcursor->Next();
+            } else {
+                return error("failed to get address balance value");
+            }
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool CBlockTreeDB::BuildAddressBalanceIndex()
+{
+    LogPrintf("%s: Building the address balance index from the address index...\n", __func__);
+
+    CDBBatch batch(*this);
+
+    // Drop what a previous build left, so totals whose entries are gone don't linger
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(DB_ADDRESSBALANCEINDEX);
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, CAddressIndexIteratorAssetKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSBALANCEINDEX)
+            break;
+        batch.Erase(key);
+        if (batch.SizeEstimate() > (1 << 24)) {
+            if (!WriteBatch(batch))
+                return false;
+            batch.Clear();
+        }
+        pcursor->Next();
+    }
+
+    // Entries of one (address, asset) are adjacent in the address index
+    pcursor->Seek(DB_ADDRESSINDEX);
+
+    CAddressIndexIteratorAssetKey current;
+    CAddressBalanceValue value;
+    size_t nBalances = 0;
+    auto flush = [&]() {
+        if (!value.IsNull()) {
+            batch.Write(std::make_pair(DB_ADDRESSBALANCEINDEX, current), value);
+            nBalances++;
+        }
+        value.SetNull();
+    };
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, CAddressIndexKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSINDEX)
+            break;
+        CAmount nValue;
+        if (!pcursor->GetValue(nValue))
+            return error("failed to get address index value");
+
+        if (key.second.type != current.type || key.second.hashBytes != current.hashBytes || key.second.asset != current.asset) {
+            flush();
+            current = CAddressIndexIteratorAssetKey(key.second.type, key.second.hashBytes, key.second.asset);
+            if (batch.SizeEstimate() > (1 << 24)) {
+                if (!WriteBatch(batch))
+                    return false;
+                batch.Clear();
+            }
+        }
+        if (nValue > 0)
+            value.received += nValue;
+        value.balance += nValue;
+        pcursor->Next();
+    }
+    flush();
+
+    if (!WriteBatch(batch))
+        return false;
+    LogPrintf("%s: Address balance index built with %u entries\n", __func__, nBalances);
+    return true;
+}
+
 bool CBlockTreeDB::WriteTimestampIndex(const CTimestampIndexKey& timestampIndex)
 {
     CDBBatch batch(*this);
@@ -503,8 +688,9 @@ bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::ConsensusParams& consensu
         if (pcursor->GetKey(key) && key.first == DB_BLOCK_INDEX) {
             CDiskBlockIndex diskindex;
             if (pcursor->GetValue(diskindex)) {
-                // Construct block index object
-                CBlockIndex* pindexNew = insertBlockIndex(diskindex.GetBlockHash());
+                // Construct block index object. The key already holds the block hash, so
+                // there is no need to rebuild the header and recompute its PoW hash here.
+                CBlockIndex* pindexNew = insertBlockIndex(key.second);
                 pindexNew->pprev = insertBlockIndex(diskindex.hashPrev);
                 pindexNew->nHeight = diskindex.nHeight;
                 if (diskindex.nHeight > nHighest)
@@ -523,9 +709,8 @@ bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::ConsensusParams& consensu
                 // Soteria: Disable PoW Sanity check while loading block index from disk.
                 // While it is technically feasible to verify the PoW, doing so takes several minutes as it
                 // requires recomputing every PoW hash during every wallet startup.
-                // We opt instead to simply trust the data that is on your local disk.
-                //if (!CheckProofOfWork(pindexNew->GetBlockHeader(), consensusParams))
-                //    return error("%s: CheckProofOfWork failed: %s", __func__, pindexNew->ToString());
+                // We opt instead to simply trust the data that is on your local disk, and leave
+                // re-verifying it to the optional background audit (-auditblockindexpow).
 
                 pcursor->Next();
             } else {
@@ -111,6 +111,37 @@ private:
     friend class CCoinsViewDB;
 };
 
+/**
+ * Iterates the address index entries of one address and asset in (height, blockindex) order,
+ * reading them from the database one at a time.
+ */
+class CAddressIndexCursor
+{
+public:
+    ~CAddressIndexCursor() {}
+
+    bool Valid() const { return fValid; }
+    const CAddressIndexKey& GetKey() const { return key; }
+    CAmount GetValue() const { return nValue; }
+    void Next();
+
+private:
+    CAddressIndexCursor(CDBIterator* pcursorIn, unsigned int typeIn, const uint160& hashBytesIn, const std::string& assetIn, int endIn);
+    void ReadCurrent();
+
+    std::unique_ptr<CDBIterator> pcursor;
+    unsigned int type;
+    uint160 hashBytes;
+    std::string asset;
+    int end;
+
+    bool fValid;
+    CAddressIndexKey key;
+    CAmount nValue;
+
+    friend class CBlockTreeDB;
+};
+
 /** Access to the block database (blocks/index/) */
 class CBlockTreeDB : public CDBWrapper
 {
@@ -142,6 +173,15 @@ public:
     bool ReadAddressIndex(uint160 addressHash, int type,
                           std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
                           int start = 0, int end = 0);
+    /** Entries of one address and asset from height start (0 = from the first) up to end (0 = to the last) */
+    std::unique_ptr<CAddressIndexCursor> ReadAddressIndexCursor(uint160 addressHash, int type, std::string assetName,
+                                                                int start = 0, int end = 0);
+    /** The names of the assets an address has address index entries for */
+    bool ReadAddressIndexAssets(uint160 addressHash, int type, std::vector<std::string> &assetNames);
+    bool ReadAddressBalanceIndex(uint160 addressHash, int type, std::string assetName, CAddressBalanceValue &value);
+    bool ReadAddressBalanceIndex(uint160 addressHash, int type,
+                                 std::vector<std::pair<std::string, CAddressBalanceValue> > &balances);
+    bool BuildAddressBalanceIndex();
     bool WriteTimestampIndex(const CTimestampIndexKey &timestampIndex);
     bool ReadTimestampIndex(const unsigned int &high, const unsigned int &low, const bool fActiveOnly, std::vector<std::pair<uint256, unsigned int> > &vect);
     bool WriteTimestampBlockIndex(const CTimestampBlockIndexKey &blockhashIndex, const CTimestampBlockIndexValue &logicalts);
@@ -149,6 +189,10 @@ public:
     bool WriteFlag(const std::string &name, bool fValue);
     bool ReadFlag(const std::string &name, bool &fValue);
     bool LoadBlockIndexGuts(const Consensus::ConsensusParams& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, int& nHighest);
+
+private:
+    /** Add (or with fErase, take back) the amounts of address index entries to the balance index */
+    void UpdateAddressBalanceIndex(CDBBatch &batch, const std::vector<std::pair<CAddressIndexKey, CAmount> > &vect, bool fErase);
 };
 
 #endif // SOTERIA_TXDB_H
@@ -102,6 +102,15 @@ public:
     	return cacheMap.size();
     }
 
+    /** Visit every (key, value) pair without touching access times */
+    template<typename Callable>
+    void for_each(Callable&& func) const
+    {
+        for (const auto& entry : cacheMap) {
+            func(entry.first, entry.second.first);
+        }
+    }
+
 private:
     void truncate_if_needed()
     {
@@ -1202,6 +1202,50 @@ bool GetAddressIndex(uint160 addressHash, int type,
     return true;
 }
 
+bool GetAddressIndexCursor(uint160 addressHash, int type, std::string assetName,
+ std::unique_ptr<CAddressIndexCursor>& cursor, int start, int end)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    cursor = pblocktree->ReadAddressIndexCursor(addressHash, type, assetName, start, end);
+    return true;
+}
+
+bool GetAddressIndexAssets(uint160 addressHash, int type, std::vector<std::string>& assetNames)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    if (!pblocktree->ReadAddressIndexAssets(addressHash, type, assetNames))
+        return error("unable to get assets for address");
+
+    return true;
+}
+
+bool GetAddressBalance(uint160 addressHash, int type, std::string assetName, CAddressBalanceValue& value)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    if (!pblocktree->ReadAddressBalanceIndex(addressHash, type, assetName, value))
+        return error("unable to get balance for address");
+
+    return true;
+}
+
+bool GetAddressBalance(uint160 addressHash, int type,
+ std::vector<std::pair<std::string, CAddressBalanceValue>>& balances)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    if (!pblocktree->ReadAddressBalanceIndex(addressHash, type, balances))
+        return error("unable to get balances for address");
+
+    return true;
+}
+
 bool GetAddressUnspent(uint160 addressHash, int type, std::string assetName,
  std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue>>& unspentOutputs)
 {
@@ -1355,6 +1399,35 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
     return true;
 }
 
+bool ReadRawBlockFromDisk(std::vector<unsigned char>& block, const CDiskBlockPos& pos, const CMessageHeader::MessageStartChars& messageStart)
+{
+    // WriteBlockToDisk() put the message start and size right in front of the block
+    static const unsigned int BLOCK_META_SIZE = CMessageHeader::MESSAGE_START_SIZE + sizeof(unsigned int);
+    if (pos.nPos < BLOCK_META_SIZE)
+        return error("ReadRawBlockFromDisk: no block at %s", pos.ToString());
+    CDiskBlockPos posMeta(pos.nFile, pos.nPos - BLOCK_META_SIZE);
+
+    CAutoFile filein(OpenBlockFile(posMeta, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull())
+        return error("ReadRawBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
+
+    try {
+        CMessageHeader::MessageStartChars blockStart;
+        unsigned int nSize;
+        filein >> FLATDATA(blockStart) >> nSize;
+        if (memcmp(blockStart, messageStart, CMessageHeader::MESSAGE_START_SIZE))
+            return error("ReadRawBlockFromDisk: block magic mismatch at %s", pos.ToString());
+        if (nSize > MAX_SIZE)
+            return error("ReadRawBlockFromDisk: block size %u too large at %s", nSize, pos.ToString());
+        block.resize(nSize);
+        filein.read((char*)block.data(), nSize);
+    } catch (const std::exception& e) {
+        return error("%s: I/O error - %s at %s", __func__, e.what(), pos.ToString());
+    }
+
+    return true;
+}
+
 CAmount GetBlockSubsidy(int nHeight, const Consensus::ConsensusParams& consensusParams)
 {
   
@@ -2336,6 +2409,147 @@ void ThreadScriptCheck()
     scriptcheckqueue.Thread();
 }
 
+//! Headers per CHeaderPoWCheck, enough to fill the lanes of the multi-buffer hash functions a few times over
+static const size_t HEADER_POW_CHECK_BATCH = 16;
+
+/**
+ * Computes (and thereby caches) the PoW hashes of a run of headers into
+ * phashes. Run in parallel over a headers message by GetBlockHeadersPoWHashes.
+ */
+class CHeaderPoWCheck
+{
+private:
+    const CBlockHeader* pbegin;
+    const CBlockHeader* pend;
+    uint256* phashes;
+
+public:
+    CHeaderPoWCheck() : pbegin(nullptr), pend(nullptr), phashes(nullptr) {}
+    CHeaderPoWCheck(const CBlockHeader* pbeginIn, const CBlockHeader* pendIn, uint256* phashesIn) : pbegin(pbeginIn), pend(pendIn), phashes(phashesIn) {}
+
+    bool operator()()
+    {
+        std::vector<const CBlockHeader*> vHeaders;
+        for (const CBlockHeader* pheader = pbegin; pheader != pend; ++pheader)
+            vHeaders.push_back(pheader);
+        std::vector<uint256> vHashes = GetPoWHashes(vHeaders);
+        std::copy(vHashes.begin(), vHashes.end(), phashes);
+        return true;
+    }
+
+    void swap(CHeaderPoWCheck& check)
+    {
+        std::swap(pbegin, check.pbegin);
+        std::swap(pend, check.pend);
+        std::swap(phashes, check.phashes);
+    }
+};
+
+static CCheckQueue<CHeaderPoWCheck> headerpowcheckqueue(16);
+
+void ThreadHeaderPoWCheck()
+{
+    RenameThread("soteria-headerpow");
+    headerpowcheckqueue.Thread();
+}
+
+std::vector<uint256> GetBlockHeadersPoWHashes(const std::vector<CBlockHeader>& headers)
+{
+    std::vector<uint256> vHashes(headers.size());
+    std::vector<CHeaderPoWCheck> vChecks;
+    for (size_t i = 0; i < headers.size(); i += HEADER_POW_CHECK_BATCH)
+        vChecks.emplace_back(&headers[i], &headers[0] + std::min(i + HEADER_POW_CHECK_BATCH, headers.size()), &vHashes[i]);
+
+    if (!nScriptCheckThreads || vChecks.size() <= 1) {
+        for (CHeaderPoWCheck& check : vChecks)
+            check();
+        return vHashes;
+    }
+
+    CCheckQueueControl<CHeaderPoWCheck> control(&headerpowcheckqueue);
+    control.Add(vChecks);
+    control.Wait();
+    return vHashes;
+}
+
+static CCriticalSection cs_blockindexaudit;
+static CBlockIndexAuditProgress blockIndexAudit;
+
+//! Stop recording failing hashes after this many, the count keeps going
+static const size_t MAX_AUDIT_FAILURES_REPORTED = 100;
+//! Headers hashed together by the audit
+static const size_t AUDIT_BATCH_SIZE = 64;
+
+void ThreadAuditBlockIndexPoW()
+{
+    RenameThread("soteria-powaudit");
+    SetThreadPriority(THREAD_PRIORITY_LOWEST);
+
+    // Entries are never removed from mapBlockIndex while the node runs, and
+    // the header fields of a loaded entry do not change, so a snapshot of the
+    // pointers can be walked without holding cs_main.
+    std::vector<const CBlockIndex*> vIndexes;
+    {
+        LOCK(cs_main);
+        vIndexes.reserve(mapBlockIndex.size());
+        for (const std::pair<const uint256, CBlockIndex*>& item : mapBlockIndex)
+            vIndexes.push_back(item.second);
+    }
+    std::sort(vIndexes.begin(), vIndexes.end(), [](const CBlockIndex* a, const CBlockIndex* b) {
+        return a->nHeight < b->nHeight;
+    });
+
+    {
+        LOCK(cs_blockindexaudit);
+        blockIndexAudit = CBlockIndexAuditProgress();
+        blockIndexAudit.fStarted = true;
+        blockIndexAudit.nTotal = vIndexes.size();
+    }
+    LogPrintf("Auditing the PoW of %u block index entries in the background\n", vIndexes.size());
+
+    const Consensus::ConsensusParams& consensusParams = Params().GetConsensus();
+    int64_t nStart = GetTimeMillis();
+    for (size_t nBatchBegin = 0; nBatchBegin < vIndexes.size(); nBatchBegin += AUDIT_BATCH_SIZE) {
+        boost::this_thread::interruption_point();
+
+        size_t nBatchEnd = std::min(nBatchBegin + AUDIT_BATCH_SIZE, vIndexes.size());
+        std::vector<CBlockHeader> vHeaders;
+        std::vector<const CBlockHeader*> vHeaderPtrs;
+        vHeaders.reserve(nBatchEnd - nBatchBegin);
+        for (size_t i = nBatchBegin; i < nBatchEnd; i++) {
+            vHeaders.push_back(vIndexes[i]->GetBlockHeader());
+            vHeaderPtrs.push_back(&vHeaders.back());
+        }
+        // Bypass the PoW cache: it is what is being audited.
+        std::vector<uint256> vPoWHashes = ComputePoWHashes(vHeaderPtrs);
+
+        LOCK(cs_blockindexaudit);
+        for (size_t i = nBatchBegin; i < nBatchEnd; i++) {
+            const CBlockIndex* pindex = vIndexes[i];
+            const uint256& powHash = vPoWHashes[i - nBatchBegin];
+            bool fValid = powHash == pindex->GetBlockHash() && CheckProofOfWork(vHeaders[i - nBatchBegin], powHash, consensusParams);
+            blockIndexAudit.nChecked++;
+            if (!fValid) {
+                LogPrintf("ERROR: %s: PoW check failed for block index entry %s\n", __func__, pindex->ToString());
+                blockIndexAudit.nFailed++;
+                if (blockIndexAudit.vFailed.size() < MAX_AUDIT_FAILURES_REPORTED)
+                    blockIndexAudit.vFailed.push_back(pindex->GetBlockHash());
+            }
+        }
+    }
+
+    LOCK(cs_blockindexaudit);
+    blockIndexAudit.fDone = true;
+    LogPrintf("Block index PoW audit finished: %u entries checked, %u failed, %dms\n",
+        blockIndexAudit.nChecked, blockIndexAudit.nFailed, GetTimeMillis() - nStart);
+}
+
+CBlockIndexAuditProgress GetBlockIndexAuditProgress()
+{
+    LOCK(cs_blockindexaudit);
+    return blockIndexAudit;
+}
+
 // Protected by cs_main
 VersionBitsCache versionbitscache;
 
@@ -3308,6 +3522,7 @@ static int64_t nTimePostConnect = 0;
 struct PerBlockConnectTrace {
     CBlockIndex* pindex = nullptr;
     std::shared_ptr<const CBlock> pblock;
+    std::shared_ptr<const CBlockAssetActivity> assetActivity;
     std::shared_ptr<std::vector<CTransactionRef>> conflictedTxs;
     PerBlockConnectTrace() : conflictedTxs(std::make_shared<std::vector<CTransactionRef>>()) {}
 };
@@ -3343,13 +3558,14 @@ public:
         pool.NotifyEntryRemoved.disconnect(boost::bind(&ConnectTrace::NotifyEntryRemoved, this, boost::placeholders::_1, boost::placeholders::_2));
     }
 
-    void BlockConnected(CBlockIndex* pindex, std::shared_ptr<const CBlock> pblock)
+    void BlockConnected(CBlockIndex* pindex, std::shared_ptr<const CBlock> pblock, std::shared_ptr<const CBlockAssetActivity> assetActivity)
     {
         assert(!blocksConnected.back().pindex);
         assert(pindex);
         assert(pblock);
         blocksConnected.back().pindex = pindex;
         blocksConnected.back().pblock = std::move(pblock);
+        blocksConnected.back().assetActivity = std::move(assetActivity);
         blocksConnected.emplace_back();
     }
 
@@ -3406,6 +3622,8 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
     /** SOTER START */
     // Initialize sets used from removing asset entries from the mempool
     ConnectedBlockAssetData assetDataFromBlock;
+    // What the block did to assets, for BlockAssetsConnected()
+    std::shared_ptr<CBlockAssetActivity> assetActivity;
     /** SOTER END */
 
     {
@@ -3459,6 +3677,19 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
         nTimeAssetsFlush = GetTimeMicros();
         bool assetFlushed = assetCache.Flush();
         assert(assetFlushed);
+
+        // The cache is done with its sets once flushed, so they are moved rather than copied
+        assetActivity = std::make_shared<CBlockAssetActivity>();
+        assetActivity->setNewAssets = std::move(assetCache.setNewAssetsToAdd);
+        assetActivity->setNewOwnerAssets = std::move(assetCache.setNewOwnerAssetsToAdd);
+        assetActivity->setReissues = std::move(assetCache.setNewReissueToAdd);
+        assetActivity->setTransfers = std::move(assetCache.setNewTransferAssetsToAdd);
+        assetActivity->setQualifierAddresses = std::move(assetCache.setNewQualifierAddressToAdd);
+        assetActivity->setRestrictedAddresses = std::move(assetCache.setNewRestrictedAddressToAdd);
+        assetActivity->setRestrictedGlobals = std::move(assetCache.setNewRestrictedGlobalToAdd);
+        assetActivity->setRestrictedVerifiers = std::move(assetCache.setNewRestrictedVerifierToAdd);
+        if (assetActivity->IsEmpty())
+            assetActivity.reset();
         int64_t nTimeAssetFlushFinished = GetTimeMicros(); nTimeAssetFlush += nTimeAssetFlushFinished - nTimeAssetsFlush;
         LogPrint(BCLog::BENCH, "  - Flush Assets: %.2fms [%.2fs (%.2fms/blk)]\n", (nTimeAssetFlushFinished - nTimeAssetsFlush) * MILLI, nTimeAssetFlush * MICRO, nTimeAssetFlush * MILLI / nBlocksTotal);
         /** SOTER END */
@@ -3479,7 +3710,7 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
     LogPrint(BCLog::BENCH, "  - Connect postprocess: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime6 - nTime5) * MILLI, nTimePostConnect * MICRO, nTimePostConnect * MILLI / nBlocksTotal);
     LogPrint(BCLog::BENCH, "- Connect block: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime6 - nTime1) * MILLI, nTimeTotal * MICRO, nTimeTotal * MILLI / nBlocksTotal);
 
-    connectTrace.BlockConnected(pindexNew, std::move(pthisBlock));
+    connectTrace.BlockConnected(pindexNew, std::move(pthisBlock), std::move(assetActivity));
 
     /** SOTER START */
 
@@ -3748,6 +3979,8 @@ bool ActivateBestChain(CValidationState& state, const CChainParams& chainparams,
             for (const PerBlockConnectTrace& trace : connectTrace.GetBlocksConnected()) {
                 assert(trace.pblock && trace.pindex);
                 GetMainSignals().BlockConnected(trace.pblock, trace.pindex, *trace.conflictedTxs);
+                if (trace.assetActivity)
+                    GetMainSignals().BlockAssetsConnected(trace.pindex, trace.assetActivity);
             }
         }
         // When we reach this point, we switched to a new tip (stored in pindexNewTip).
@@ -4500,6 +4733,7 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
 bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, CBlockHeader* first_invalid)
 {
     if (first_invalid != nullptr) first_invalid->SetNull();
+
     {
         LOCK(cs_main);
         for (const CBlockHeader& header : headers) {
@@ -5010,6 +5244,17 @@ bool static LoadBlockIndexDB(const CChainParams& chainparams)
     pblocktree->ReadFlag("addressindex", fAddressIndex);
     LogPrintf("%s: address index %s\n", __func__, fAddressIndex ? "enabled" : "disabled");
 
+    // Address indexes from before the balance index get their balances summed up once,
+    // or again when -rebuildaddressbalanceindex asks for it
+    if (fAddressIndex) {
+        bool fAddressBalanceIndex = false;
+        pblocktree->ReadFlag("addressbalanceindex", fAddressBalanceIndex);
+        if (!fAddressBalanceIndex || gArgs.GetBoolArg("-rebuildaddressbalanceindex", false)) {
+            if (!pblocktree->BuildAddressBalanceIndex() || !pblocktree->WriteFlag("addressbalanceindex", true))
+                return error("%s: failed to build the address balance index", __func__);
+        }
+    }
+
     // Check whether we have a timestamp index
     pblocktree->ReadFlag("timestampindex", fTimestampIndex);
     LogPrintf("%s: timestamp index %s\n", __func__, fTimestampIndex ? "enabled" : "disabled");
@@ -5399,6 +5644,7 @@ bool LoadBlockIndex(const CChainParams& chainparams)
         // Use the provided setting for -addressindex in the new database
         fAddressIndex = gArgs.GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX);
         pblocktree->WriteFlag("addressindex", fAddressIndex);
+        pblocktree->WriteFlag("addressbalanceindex", true);
         LogPrintf("%s: address index %s\n", __func__, fAddressIndex ? "enabled" : "disabled");
 
         // Use the provided setting for -timestampindex in the new database
@@ -44,6 +44,7 @@
 #include <assets/assetsnapshotdb.h>
 #include <assets/snapshotrequestdb.h>
 
+class CAddressIndexCursor;
 class CBlockIndex;
 class CBlockTreeDB;
 class CBlockUndo;
@@ -180,6 +181,8 @@ static constexpr int64_t DEFAULT_DB_MAX_FILE_SIZE = 2;
 static constexpr unsigned int DEFAULT_BANSCORE_THRESHOLD = 100;
 /** Default for -persistmempool */
 static constexpr bool DEFAULT_PERSIST_MEMPOOL = true;
+/** Default for -auditblockindexpow */
+static constexpr bool DEFAULT_AUDIT_BLOCKINDEX_POW = false;
 /** Default for -mempoolreplacement */
 static constexpr bool DEFAULT_ENABLE_REPLACEMENT = false;
 /** Default for using fee filter */
@@ -328,6 +331,29 @@ bool LoadChainTip(const CChainParams& chainparams) EXCLUSIVE_LOCKS_REQUIRED(cs_m
 void UnloadBlockIndex();
 /** Run an instance of the script checking thread */
 void ThreadScriptCheck();
+/** Run an instance of the header PoW pre-validation thread */
+void ThreadHeaderPoWCheck();
+/**
+ * The PoW hashes (GetHash()) of a headers message, in order. Computed and
+ * cached on the header PoW threads, so call it without holding cs_main.
+ */
+std::vector<uint256> GetBlockHeadersPoWHashes(const std::vector<CBlockHeader>& headers) LOCKS_EXCLUDED(cs_main);
+
+/** Progress of the background block index PoW audit */
+struct CBlockIndexAuditProgress
+{
+    bool fStarted = false;
+    bool fDone = false;
+    uint64_t nTotal = 0;
+    uint64_t nChecked = 0;
+    uint64_t nFailed = 0;
+    //! Hashes of the block index entries whose stored PoW did not check out
+    std::vector<uint256> vFailed;
+};
+/** Recompute and check the PoW of every loaded block index entry at low priority (-auditblockindexpow) */
+void ThreadAuditBlockIndexPoW();
+/** Copy out the progress of the block index PoW audit */
+CBlockIndexAuditProgress GetBlockIndexAuditProgress();
 /** Check whether we are doing an initial block download (synchronizing from disk or network) */
 bool IsInitialBlockDownload();
 bool IsInitialSyncSpeedUp();
@@ -466,6 +492,12 @@ bool GetAddressIndex(uint160 addressHash, int type, std::string assetName,
 bool GetAddressIndex(uint160 addressHash, int type,
                      std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
                      int start = 0, int end = 0);
+bool GetAddressIndexCursor(uint160 addressHash, int type, std::string assetName,
+                           std::unique_ptr<CAddressIndexCursor> &cursor, int start = 0, int end = 0);
+bool GetAddressIndexAssets(uint160 addressHash, int type, std::vector<std::string> &assetNames);
+bool GetAddressBalance(uint160 addressHash, int type, std::string assetName, CAddressBalanceValue &value);
+bool GetAddressBalance(uint160 addressHash, int type,
+                       std::vector<std::pair<std::string, CAddressBalanceValue> > &balances);
 bool GetAddressUnspent(uint160 addressHash, int type, std::string assetName,
                        std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &unspentOutputs);
 bool GetAddressUnspent(uint160 addressHash, int type,
@@ -474,6 +506,12 @@ bool GetAddressUnspent(uint160 addressHash, int type,
 /** Functions for disk access for blocks */
 bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus::ConsensusParams& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::ConsensusParams& consensusParams);
+/**
+ * Read the serialized block at pos as it is stored, without deserializing it.
+ * It is the block's network serialization including witness data. Only the
+ * message start and size WriteBlockToDisk() put in front of it are checked.
+ */
+bool ReadRawBlockFromDisk(std::vector<unsigned char>& block, const CDiskBlockPos& pos, const CMessageHeader::MessageStartChars& messageStart);
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CDiskBlockPos& pos, const uint256& hashBlock);
 
 /** Functions for validating blocks and updating the block tree */
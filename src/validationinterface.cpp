@@ -30,6 +30,7 @@ struct MainSignalsInstance {
     boost::signals2::signal<void (const CBlockIndex *, const CBlockIndex *, bool fInitialDownload)> UpdatedBlockTip;
     boost::signals2::signal<void (const CTransactionRef &)> TransactionAddedToMempool;
     boost::signals2::signal<void (const std::shared_ptr<const CBlock> &, const CBlockIndex *pindex, const std::vector<CTransactionRef>&)> BlockConnected;
+    boost::signals2::signal<void (const CBlockIndex *, const std::shared_ptr<const CBlockAssetActivity> &)> BlockAssetsConnected;
     boost::signals2::signal<void (const std::shared_ptr<const CBlock> &)> BlockDisconnected;
     boost::signals2::signal<void (const CBlockLocator &)> SetBestChain;
     boost::signals2::signal<void (int64_t nBestBlockTime, CConnman* connman)> Broadcast;
@@ -37,6 +38,7 @@ struct MainSignalsInstance {
     boost::signals2::signal<void (const CBlockIndex *, const std::shared_ptr<const CBlock>&)> NewPoWValidBlock;
     boost::signals2::signal<void (const uint256 &)> BlockFound;
     boost::signals2::signal<void (const CMessage &)> NewAssetMessage;
+    boost::signals2::signal<void (const CContractJob &)> SmartContractFinished;
     boost::signals2::signal<void (const std::string &)> AssetInventory;
 //    boost::signals2::signal<void (std::shared_ptr<CReserveScript>&)> ScriptForMining;
     
@@ -72,6 +74,7 @@ void RegisterValidationInterface(CValidationInterface* pwalletIn) {
     g_signals.m_internals->UpdatedBlockTip.connect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, boost::placeholders::_1, boost::placeholders::_2, boost::placeholders::_3));
     g_signals.m_internals->TransactionAddedToMempool.connect(boost::bind(&CValidationInterface::TransactionAddedToMempool, pwalletIn, _1));
     g_signals.m_internals->BlockConnected.connect(boost::bind(&CValidationInterface::BlockConnected, pwalletIn, boost::placeholders::_1, boost::placeholders::_2, boost::placeholders::_3));
+    g_signals.m_internals->BlockAssetsConnected.connect(boost::bind(&CValidationInterface::BlockAssetsConnected, pwalletIn, boost::placeholders::_1, boost::placeholders::_2));
     g_signals.m_internals->BlockDisconnected.connect(boost::bind(&CValidationInterface::BlockDisconnected, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->SetBestChain.connect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->Broadcast.connect(boost::bind(&CValidationInterface::ResendWalletTransactions, pwalletIn, boost::placeholders::_1, boost::placeholders::_2));
@@ -79,6 +82,7 @@ void RegisterValidationInterface(CValidationInterface* pwalletIn) {
     g_signals.m_internals->NewPoWValidBlock.connect(boost::bind(&CValidationInterface::NewPoWValidBlock, pwalletIn, boost::placeholders::_1, boost::placeholders::_2));
     g_signals.m_internals->BlockFound.connect(boost::bind(&CValidationInterface::BlockFound, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->NewAssetMessage.connect(boost::bind(&CValidationInterface::NewAssetMessage, pwalletIn, boost::placeholders::_1));
+    g_signals.m_internals->SmartContractFinished.connect(boost::bind(&CValidationInterface::SmartContractFinished, pwalletIn, boost::placeholders::_1));
 //    g_signals.m_internals->ScriptForMining.connect(boost::bind(&CValidationInterface::GetScriptForMining, pwalletIn, _1));
 }
 
@@ -88,11 +92,13 @@ void UnregisterValidationInterface(CValidationInterface* pwalletIn) {
     g_signals.m_internals->SetBestChain.disconnect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->TransactionAddedToMempool.disconnect(boost::bind(&CValidationInterface::TransactionAddedToMempool, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->BlockConnected.disconnect(boost::bind(&CValidationInterface::BlockConnected, pwalletIn, boost::placeholders::_1, boost::placeholders::_2, boost::placeholders::_3));
+    g_signals.m_internals->BlockAssetsConnected.disconnect(boost::bind(&CValidationInterface::BlockAssetsConnected, pwalletIn, boost::placeholders::_1, boost::placeholders::_2));
     g_signals.m_internals->BlockDisconnected.disconnect(boost::bind(&CValidationInterface::BlockDisconnected, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->UpdatedBlockTip.disconnect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, boost::placeholders::_1, boost::placeholders::_2, boost::placeholders::_3));
     g_signals.m_internals->NewPoWValidBlock.disconnect(boost::bind(&CValidationInterface::NewPoWValidBlock, pwalletIn, boost::placeholders::_1, boost::placeholders::_2));
     g_signals.m_internals->BlockFound.disconnect(boost::bind(&CValidationInterface::BlockFound, pwalletIn, boost::placeholders::_1));
     g_signals.m_internals->NewAssetMessage.disconnect(boost::bind(&CValidationInterface::NewAssetMessage, pwalletIn, boost::placeholders::_1));
+    g_signals.m_internals->SmartContractFinished.disconnect(boost::bind(&CValidationInterface::SmartContractFinished, pwalletIn, boost::placeholders::_1));
 //    g_signals.m_internals->ScriptForMining.disconnect(boost::bind(&CValidationInterface::GetScriptForMining, pwalletIn, _1));
 }
 
@@ -102,11 +108,13 @@ void UnregisterAllValidationInterfaces() {
     g_signals.m_internals->SetBestChain.disconnect_all_slots();
     g_signals.m_internals->TransactionAddedToMempool.disconnect_all_slots();
     g_signals.m_internals->BlockConnected.disconnect_all_slots();
+    g_signals.m_internals->BlockAssetsConnected.disconnect_all_slots();
     g_signals.m_internals->BlockDisconnected.disconnect_all_slots();
     g_signals.m_internals->UpdatedBlockTip.disconnect_all_slots();
     g_signals.m_internals->NewPoWValidBlock.disconnect_all_slots();
     g_signals.m_internals->BlockFound.disconnect_all_slots();
     g_signals.m_internals->NewAssetMessage.disconnect_all_slots();
+    g_signals.m_internals->SmartContractFinished.disconnect_all_slots();
 //    g_signals.m_internals->ScriptForMining.disconnect_all_slots();
 }
 
@@ -122,6 +130,10 @@ void CMainSignals::BlockConnected(const std::shared_ptr<const CBlock> &pblock, c
     m_internals->BlockConnected(pblock, pindex, vtxConflicted);
 }
 
+void CMainSignals::BlockAssetsConnected(const CBlockIndex *pindex, const std::shared_ptr<const CBlockAssetActivity> &activity) {
+    m_internals->BlockAssetsConnected(pindex, activity);
+}
+
 void CMainSignals::BlockDisconnected(const std::shared_ptr<const CBlock> &pblock) {
     m_internals->BlockDisconnected(pblock);
 }
@@ -149,3 +161,7 @@ void CMainSignals::BlockFound(const uint256 &hash) {
 void CMainSignals::NewAssetMessage(const CMessage& message) {
     m_internals->NewAssetMessage(message);
 }
+
+void CMainSignals::SmartContractFinished(const CContractJob& job) {
+    m_internals->SmartContractFinished(job);
+}
@@ -22,6 +22,8 @@ class CValidationState;
 class uint256;
 class CScheduler;
 class CMessage;
+class CContractJob;
+struct CBlockAssetActivity;
 
 // These functions dispatch to one or all registered wallets
 
@@ -49,6 +51,8 @@ protected:
      * Provides a vector of transactions evicted from the mempool as a result.
      */
     virtual void BlockConnected(const std::shared_ptr<const CBlock> &block, const CBlockIndex *pindex, const std::vector<CTransactionRef> &txnConflicted) {}
+    /** Notifies listeners of the asset changes of a block being connected, after its BlockConnected(). Not called for blocks without any. */
+    virtual void BlockAssetsConnected(const CBlockIndex *pindex, const std::shared_ptr<const CBlockAssetActivity> &activity) {}
     /** Notifies listeners of a block being disconnected */
     virtual void BlockDisconnected(const std::shared_ptr<const CBlock> &block) {}
     /** Notifies listeners of the new active block chain on-disk. */
@@ -69,6 +73,8 @@ protected:
 
     virtual void BlockFound(const uint256 &hash) {};
     virtual void NewAssetMessage(const CMessage &message) {};
+    /** Notifies listeners that a smart contract call submitted to the contract executor finished. Called on an executor thread. */
+    virtual void SmartContractFinished(const CContractJob &job) {};
 
 //    virtual void GetScriptForMining(std::shared_ptr<CReserveScript>&) {};
 
@@ -98,6 +104,7 @@ public:
     void UpdatedBlockTip(const CBlockIndex *, const CBlockIndex *, bool fInitialDownload);
     void TransactionAddedToMempool(const CTransactionRef &);
     void BlockConnected(const std::shared_ptr<const CBlock> &, const CBlockIndex *pindex, const std::vector<CTransactionRef> &);
+    void BlockAssetsConnected(const CBlockIndex *, const std::shared_ptr<const CBlockAssetActivity> &);
     void BlockDisconnected(const std::shared_ptr<const CBlock> &);
     void SetBestChain(const CBlockLocator &);
     void Broadcast(int64_t nBestBlockTime, CConnman* connman);
@@ -105,6 +112,7 @@ public:
     void NewPoWValidBlock(const CBlockIndex *, const std::shared_ptr<const CBlock>&);
     void BlockFound(const uint256 &);
     void NewAssetMessage(const CMessage&);
+    void SmartContractFinished(const CContractJob&);
 //    void ScriptForMining(std::shared_ptr<CReserveScript>&);
 
 };
@@ -12,6 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "assets/assets.h"
+#include "assets/messages.h"
+#include "assets/myassetsdb.h"
 #include "consensus/validation.h"
 #include "rpc/server.h"
 #include "test/test_soteria.h"
@@ -622,6 +625,59 @@ BOOST_FIXTURE_TEST_SUITE(wallet_tests, WalletTestingSetup)
         BOOST_CHECK_EQUAL(values[1], "val_rr1");
     }
 
+    static CMutableTransaction AssetTransferTx(const COutPoint& prevout, const std::string& strAssetName, CAmount nAmount)
+    {
+        CKey key;
+        key.MakeNewKey(true);
+        CScript scriptPubKey = GetScriptForDestination(key.GetPubKey().GetID());
+        CAssetTransfer(strAssetName, nAmount).ConstructTransaction(scriptPubKey);
+
+        CMutableTransaction tx;
+        tx.vin.emplace_back(prevout);
+        tx.vout.emplace_back(0, scriptPubKey);
+        tx.vout.emplace_back(COIN, GetScriptForDestination(key.GetPubKey().GetID()));
+        return tx;
+    }
+
+    BOOST_AUTO_TEST_CASE(asset_index_test)
+    {
+        BOOST_TEST_MESSAGE("Running Asset Index Test");
+
+        LOCK2(cs_main, pwalletMain->cs_wallet);
+
+        // A received asset output is indexed under its asset name only
+        CWalletTx wtxReceive(pwalletMain, MakeTransactionRef(AssetTransferTx(COutPoint(GetRandHash(), 0), "INDEXED", 100 * COIN)));
+        BOOST_CHECK(pwalletMain->AddToWallet(wtxReceive));
+        const COutPoint received(wtxReceive.GetHash(), 0);
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED") == std::set<COutPoint>{received});
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("OTHER").empty());
+
+        // Spending it replaces it with the spending transaction's output
+        CWalletTx wtxSpend(pwalletMain, MakeTransactionRef(AssetTransferTx(received, "INDEXED", 100 * COIN)));
+        BOOST_CHECK(pwalletMain->AddToWallet(wtxSpend));
+        const COutPoint sent(wtxSpend.GetHash(), 0);
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED") == std::set<COutPoint>{sent});
+
+        // Zapping the spend makes the received output unspent again
+        std::vector<uint256> vHashIn{wtxSpend.GetHash()}, vHashOut;
+        BOOST_CHECK_EQUAL(pwalletMain->ZapSelectTx(vHashIn, vHashOut), DB_LOAD_OK);
+        BOOST_CHECK_EQUAL(vHashOut.size(), 1U);
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED") == std::set<COutPoint>{received});
+
+        // So does abandoning a spend of it
+        CWalletTx wtxAbandon(pwalletMain, MakeTransactionRef(AssetTransferTx(received, "INDEXED", 100 * COIN)));
+        BOOST_CHECK(pwalletMain->AddToWallet(wtxAbandon));
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED") == std::set<COutPoint>{COutPoint(wtxAbandon.GetHash(), 0)});
+        BOOST_CHECK(pwalletMain->AbandonTransaction(wtxAbandon.GetHash()));
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED") == std::set<COutPoint>{received});
+
+        // Zapping the receiving transaction leaves nothing for the asset
+        vHashIn = {wtxReceive.GetHash()};
+        vHashOut.clear();
+        BOOST_CHECK_EQUAL(pwalletMain->ZapSelectTx(vHashIn, vHashOut), DB_LOAD_OK);
+        BOOST_CHECK(pwalletMain->GetAssetOutPoints("INDEXED").empty());
+    }
+
     class ListCoinsTestingSetup : public TestChain100Setup
     {
     public:
@@ -717,4 +773,96 @@ BOOST_FIXTURE_TEST_SUITE(wallet_tests, WalletTestingSetup)
         BOOST_CHECK_EQUAL(list.begin()->second.size(), (uint64_t)2L);
     }
 
+    class MessageChannelScanSetup : public TestChain100Setup
+    {
+    public:
+        MessageChannelScanSetup()
+        {
+            pmessagechanneldb = new CMessageChannelDB(1 << 20, true);
+            pMessageSubscribedChannelsCache = new CLRUCache<std::string, int>(1000);
+            vpwallets.insert(vpwallets.begin(), &wallet);
+        }
+
+        ~MessageChannelScanSetup()
+        {
+            vpwallets.erase(vpwallets.begin());
+            LOCK(cs_messaging);
+            setDirtyChannelsAdd.clear();
+            setDirtyChannelsRemove.clear();
+            setSubscribedChannelsAskedForFalse.clear();
+            setDirtySeenAddressAdd.clear();
+            setAddressAskedForFalse.clear();
+            delete pMessageSubscribedChannelsCache;
+            pMessageSubscribedChannelsCache = nullptr;
+            delete pmessagechanneldb;
+            pmessagechanneldb = nullptr;
+        }
+
+        //! Height of the last block the saved scan progress covers on the active chain
+        int ScanProgressHeight()
+        {
+            LOCK(cs_main);
+            CBlockLocator locator;
+            BOOST_REQUIRE(pmessagechanneldb->ReadScanProgress(locator));
+            return FindForkInGlobalIndex(chainActive, locator)->nHeight;
+        }
+
+        CWallet wallet;
+    };
+
+    BOOST_FIXTURE_TEST_CASE(message_channel_scan_resume_test, MessageChannelScanSetup)
+    {
+        std::string strError;
+        size_t nFound;
+
+        // A scan interrupted after a batch saves how far it got, and the next one carries on from there
+        BOOST_CHECK(ScanForMessageChannels(strError, 30, 1));
+        BOOST_CHECK_EQUAL(ScanProgressHeight(), 30);
+        BOOST_CHECK(ScanForMessageChannels(strError, 30, 1));
+        BOOST_CHECK_EQUAL(ScanProgressHeight(), 60);
+
+        // Reorganize away from block 50, which the saved progress covers
+        {
+            CValidationState state;
+            BOOST_CHECK(InvalidateBlock(state, Params(), chainActive[50]));
+        }
+        BOOST_CHECK_EQUAL(chainActive.Height(), 49);
+        CKey key;
+        key.MakeNewKey(true);
+        for (int i = 0; i < 60; i++)
+            CreateAndProcessBlock({}, GetScriptForRawPubKey(key.GetPubKey()));
+
+        // The scan resumes from the fork, not from the disconnected block 60
+        BOOST_CHECK(ScanForMessageChannels(strError, 30, 1));
+        BOOST_CHECK_EQUAL(ScanProgressHeight(), 79);
+
+        // A channel subscribed to by block connection while the scan runs is not one it found
+        {
+            LOCK(cs_messaging);
+            AddChannel("LIVE!");
+        }
+        BOOST_CHECK(ScanForMessageChannels(strError, 30, 0, &nFound));
+        BOOST_CHECK_EQUAL(ScanProgressHeight(), chainActive.Height());
+        BOOST_CHECK_EQUAL(nFound, 0U);
+        BOOST_CHECK(IsChannelSubscribed("LIVE!"));
+    }
+
+    BOOST_FIXTURE_TEST_CASE(message_channel_scan_count_test, MessageChannelScanSetup)
+    {
+        LOCK(cs_messaging);
+
+        // Already subscribed to, as by the block connection path
+        AddChannel("ASSET!");
+        BOOST_CHECK_EQUAL(ApplyMessageChannelScanEntry({"ASSET", TX_NEW_ASSET, false, "address1"}), 0U);
+
+        BOOST_CHECK_EQUAL(ApplyMessageChannelScanEntry({"OTHER", TX_NEW_ASSET, false, "address1"}), 1U);
+        BOOST_CHECK(IsChannelSubscribed("OTHER!"));
+        BOOST_CHECK_EQUAL(ApplyMessageChannelScanEntry({"OTHER", TX_REISSUE_ASSET, false, "address1"}), 0U);
+
+        // The owner token subscribes to the owner channel
+        BOOST_CHECK_EQUAL(ApplyMessageChannelScanEntry({"OTHER!", TX_NEW_ASSET, true, "address2"}), 0U);
+        BOOST_CHECK_EQUAL(ApplyMessageChannelScanEntry({"THIRD!", TX_TRANSFER_ASSET, true, "address2"}), 1U);
+        BOOST_CHECK(IsChannelSubscribed("THIRD!"));
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
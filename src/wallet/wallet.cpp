@@ -150,6 +150,15 @@ const CWalletTx* CWallet::GetWalletTx(const uint256& hash) const
     return &(it->second);
 }
 
+std::set<COutPoint> CWallet::GetAssetOutPoints(const std::string& strAssetName) const
+{
+    LOCK(cs_wallet);
+    auto it = mapAssetOutPoints.find(strAssetName);
+    if (it == mapAssetOutPoints.end())
+        return std::set<COutPoint>();
+    return it->second;
+}
+
 CPubKey CWallet::GenerateNewKey(CWalletDB& walletdb, bool internal)
 {
     AssertLockHeld(cs_wallet);                                 // mapKeyMetadata
@@ -688,6 +697,63 @@ void CWallet::AddToSpends(const uint256& wtxid)
         AddToSpends(txin.prevout, wtxid);
 }
 
+void CWallet::UpdateAssetIndex(const COutPoint& outpoint)
+{
+    auto it = mapWallet.find(outpoint.hash);
+    if (it == mapWallet.end() || outpoint.n >= it->second.tx->vout.size())
+        return;
+    const CWalletTx& wtx = it->second;
+    CAssetOutputEntry data;
+    if (!GetAssetData(wtx.tx->vout[outpoint.n].scriptPubKey, data))
+        return;
+
+    // Outputs of abandoned and conflicted transactions can't be spent
+    if (!wtx.isAbandoned() && wtx.GetDepthInMainChain() >= 0 && !IsSpent(outpoint.hash, outpoint.n)) {
+        mapAssetOutPoints[data.assetName].insert(outpoint);
+        return;
+    }
+    auto mi = mapAssetOutPoints.find(data.assetName);
+    if (mi == mapAssetOutPoints.end())
+        return;
+    mi->second.erase(outpoint);
+    if (mi->second.empty())
+        mapAssetOutPoints.erase(mi);
+}
+
+void CWallet::UpdateAssetIndex(const uint256& wtxid)
+{
+    auto it = mapWallet.find(wtxid);
+    if (it == mapWallet.end())
+        return;
+    const CTransaction& tx = *it->second.tx;
+    for (unsigned int i = 0; i < tx.vout.size(); i++)
+        UpdateAssetIndex(COutPoint(wtxid, i));
+    // Whether this transaction counts as spending its inputs may have changed too
+    if (tx.IsCoinBase())
+        return;
+    for (const CTxIn& txin : tx.vin)
+        UpdateAssetIndex(txin.prevout);
+}
+
+void CWallet::RemoveFromAssetIndex(const uint256& wtxid)
+{
+    auto it = mapWallet.find(wtxid);
+    if (it == mapWallet.end())
+        return;
+    const CTransaction& tx = *it->second.tx;
+    for (unsigned int i = 0; i < tx.vout.size(); i++) {
+        CAssetOutputEntry data;
+        if (!GetAssetData(tx.vout[i].scriptPubKey, data))
+            continue;
+        auto mi = mapAssetOutPoints.find(data.assetName);
+        if (mi == mapAssetOutPoints.end())
+            continue;
+        mi->second.erase(COutPoint(wtxid, i));
+        if (mi->second.empty())
+            mapAssetOutPoints.erase(mi);
+    }
+}
+
 bool CWallet::EncryptWallet(const SecureString& strWalletPassphrase)
 {
     if (IsCrypted())
@@ -1061,6 +1127,9 @@ bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose)
         }
     }
 
+    if (fInsertedNew || fUpdated)
+        UpdateAssetIndex(hash);
+
     //// debug print
     LogPrintf("AddToWallet %s  %s%s\n", wtxIn.GetHash().ToString(), (fInsertedNew ? "new" : ""), (fUpdated ? "update" : ""));
 
@@ -1095,6 +1164,7 @@ bool CWallet::LoadToWallet(const CWalletTx& wtxIn)
     wtx.BindWallet(this);
     wtxOrdered.insert(std::make_pair(wtx.nOrderPos, TxPair(&wtx, nullptr)));
     AddToSpends(hash);
+    UpdateAssetIndex(hash);
     for (const CTxIn& txin : wtx.tx->vin) {
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
@@ -1223,6 +1293,7 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
             wtx.setAbandoned();
             wtx.MarkDirty();
             walletdb.WriteTx(wtx);
+            UpdateAssetIndex(now);
             NotifyTransactionChanged(this, wtx.GetHash(), CT_UPDATED);
             // Iterate over all its outputs, and mark transactions in the wallet that spend them abandoned too
             TxSpends::const_iterator iter = mapTxSpends.lower_bound(COutPoint(hashTx, 0));
@@ -1287,6 +1358,7 @@ void CWallet::MarkConflicted(const uint256& hashBlock, const uint256& hashTx)
             wtx.hashBlock = hashBlock;
             wtx.MarkDirty();
             walletdb.WriteTx(wtx);
+            UpdateAssetIndex(now);
             // Iterate over all its outputs, and mark transactions in the wallet that spend them conflicted too
             TxSpends::const_iterator iter = mapTxSpends.lower_bound(COutPoint(now, 0));
             while (iter != mapTxSpends.end() && iter->first.hash == now) {
@@ -1357,6 +1429,37 @@ void CWallet::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock)
     for (const CTransactionRef& ptx : pblock->vtx) {
         SyncTransaction(ptx);
     }
+
+    // Wallet transactions that conflicted with this block, and their
+    // descendants, are no longer conflicted, so their asset outputs are
+    // available again
+    std::set<uint256> todo;
+    std::set<uint256> done;
+    for (const CTransactionRef& ptx : pblock->vtx) {
+        for (const CTxIn& txin : ptx->vin) {
+            std::pair<TxSpends::const_iterator, TxSpends::const_iterator> range = mapTxSpends.equal_range(txin.prevout);
+            for (TxSpends::const_iterator it = range.first; it != range.second; ++it) {
+                if (it->second != ptx->GetHash())
+                    todo.insert(it->second);
+            }
+        }
+    }
+    while (!todo.empty()) {
+        uint256 now = *todo.begin();
+        todo.erase(now);
+        done.insert(now);
+        auto it = mapWallet.find(now);
+        if (it == mapWallet.end() || it->second.nIndex != -1 || it->second.hashUnset())
+            continue;
+        UpdateAssetIndex(now);
+        TxSpends::const_iterator iter = mapTxSpends.lower_bound(COutPoint(now, 0));
+        while (iter != mapTxSpends.end() && iter->first.hash == now) {
+            if (!done.count(iter->second)) {
+                todo.insert(iter->second);
+            }
+            iter++;
+        }
+    }
 }
 
 
@@ -2296,12 +2399,22 @@ void CWallet::AvailableAssets(std::map<std::string, std::vector<COutput>>& mapAs
     AvailableCoinsAll(vCoins, mapAssetCoins, false, true, fOnlySafe, coinControl, nMinimumAmount, nMaximumAmount, nMinimumSumAmount, nMaximumCount, nMinDepth, nMaxDepth);
 }
 
+void CWallet::AvailableAssets(const std::set<std::string>& setAssetNames, std::map<std::string, std::vector<COutput>>& mapAssetCoins, bool fOnlySafe, const CCoinControl* coinControl, const CAmount& nMinimumAmount, const CAmount& nMaximumAmount, const CAmount& nMinimumSumAmount, const uint64_t& nMaximumCount, const int& nMinDepth, const int& nMaxDepth) const
+{
+    if (!AreAssetsDeployed())
+        return;
+
+    std::vector<COutput> vCoins;
+
+    AvailableCoinsAll(vCoins, mapAssetCoins, false, true, fOnlySafe, coinControl, nMinimumAmount, nMaximumAmount, nMinimumSumAmount, nMaximumCount, nMinDepth, nMaxDepth, &setAssetNames);
+}
+
 void CWallet::AvailableCoinsWithAssets(std::vector<COutput>& vCoins, std::map<std::string, std::vector<COutput>>& mapAssetCoins, bool fOnlySafe, const CCoinControl* coinControl, const CAmount& nMinimumAmount, const CAmount& nMaximumAmount, const CAmount& nMinimumSumAmount, const uint64_t& nMaximumCount, const int& nMinDepth, const int& nMaxDepth) const
 {
     AvailableCoinsAll(vCoins, mapAssetCoins, true, AreAssetsDeployed(), fOnlySafe, coinControl, nMinimumAmount, nMaximumAmount, nMinimumSumAmount, nMaximumCount, nMinDepth, nMaxDepth);
 }
 
-void CWallet::AvailableCoinsAll(std::vector<COutput>& vCoins, std::map<std::string, std::vector<COutput> >& mapAssetCoins, bool fGetSOTER, bool fGetAssets, bool fOnlySafe, const CCoinControl* coinControl, const CAmount& nMinimumAmount, const CAmount& nMaximumAmount, const CAmount& nMinimumSumAmount, const uint64_t& nMaximumCount, const int& nMinDepth, const int& nMaxDepth) const
+void CWallet::AvailableCoinsAll(std::vector<COutput>& vCoins, std::map<std::string, std::vector<COutput> >& mapAssetCoins, bool fGetSOTER, bool fGetAssets, bool fOnlySafe, const CCoinControl* coinControl, const CAmount& nMinimumAmount, const CAmount& nMaximumAmount, const CAmount& nMinimumSumAmount, const uint64_t& nMaximumCount, const int& nMinDepth, const int& nMaxDepth, const std::set<std::string>* setAssetNames) const
 {
     vCoins.clear();
 
@@ -2318,8 +2431,43 @@ void CWallet::AvailableCoinsAll(std::vector<COutput>& vCoins, std::map<std::stri
         std::map<std::string, CAmount> mapAssetTotals;
         std::map<uint256, COutPoint> mapOutPoints;
         std::set<std::string> setAssetMaxFound;
+
+        // Asset only lookups visit just the transactions with unspent outputs
+        // of the requested assets, in the same txid order as a walk over mapWallet
+        std::vector<const std::pair<const uint256, CWalletTx>*> vWalletTx;
+        if (!fGetSOTER) {
+            if (!fGetAssets || !AreAssetsDeployed())
+                return;
+            std::set<uint256> setAssetTx;
+            auto AddAssetTx = [&setAssetTx](const std::set<COutPoint>& setOutPoints) {
+                for (const COutPoint& out : setOutPoints)
+                    setAssetTx.insert(out.hash);
+            };
+            if (setAssetNames) {
+                for (const std::string& strAssetName : *setAssetNames) {
+                    auto it = mapAssetOutPoints.find(strAssetName);
+                    if (it != mapAssetOutPoints.end())
+                        AddAssetTx(it->second);
+                }
+            } else {
+                for (const auto& asset : mapAssetOutPoints)
+                    AddAssetTx(asset.second);
+            }
+            vWalletTx.reserve(setAssetTx.size());
+            for (const uint256& hash : setAssetTx) {
+                auto it = mapWallet.find(hash);
+                if (it != mapWallet.end())
+                    vWalletTx.push_back(&*it);
+            }
+        } else {
+            vWalletTx.reserve(mapWallet.size());
+            for (const auto& entry : mapWallet)
+                vWalletTx.push_back(&entry);
+        }
+
         // Turn the OutPoints into a map that is easily interatable.
-        for (const auto& entry : mapWallet) {
+        for (const auto* pentry : vWalletTx) {
+            const auto& entry = *pentry;
             const uint256& wtxid = entry.first;
             const CWalletTx* pcoin = &entry.second;
 
@@ -2413,6 +2561,9 @@ void CWallet::AvailableCoinsAll(std::vector<COutput>& vCoins, std::map<std::stri
                     if (!GetAssetData(pcoin->tx->vout[i].scriptPubKey, output_data))
                         continue;
 
+                    if (setAssetNames && !setAssetNames->count(output_data.assetName))
+                        continue;
+
                     address = EncodeDestination(output_data.destination);
 
                     // If we already have the maximum amount or size for this asset, skip it
@@ -3337,10 +3488,14 @@ bool CWallet::CreateTransactionAll(const std::vector<CRecipient>& vecSend, CWall
             /** SOTER START */
             std::vector<COutput> vAvailableCoins;
             std::map<std::string, std::vector<COutput>> mapAssetCoins;
-            if (fTransferAsset || fReissueAsset || assetType == AssetType::SUB || assetType == AssetType::UNIQUE || assetType == AssetType::MSGCHANNEL || assetType == AssetType::SUB_QUALIFIER || assetType == AssetType::RESTRICTED)
-                AvailableCoinsWithAssets(vAvailableCoins, mapAssetCoins, true, &coin_control);
-            else
-                AvailableCoins(vAvailableCoins, true, &coin_control);
+            AvailableCoins(vAvailableCoins, true, &coin_control);
+            if (fTransferAsset || fReissueAsset || assetType == AssetType::SUB || assetType == AssetType::UNIQUE || assetType == AssetType::MSGCHANNEL || assetType == AssetType::SUB_QUALIFIER || assetType == AssetType::RESTRICTED) {
+                // Only the assets being sent are selected from, so look up just those in the asset index
+                std::set<std::string> setAssetNames;
+                for (const auto& assetValue : mapAssetValue)
+                    setAssetNames.insert(assetValue.first);
+                AvailableAssets(setAssetNames, mapAssetCoins, true, &coin_control);
+            }
             /** SOTER END */
             // Create change script that will be used if we need change
             // TODO: pass in scriptChange instead of reservekey so
@@ -3897,8 +4052,17 @@ DBErrors CWallet::ZapSelectTx(std::vector<uint256>& vHashIn, std::vector<uint256
 {
     AssertLockHeld(cs_wallet); // mapWallet
     DBErrors nZapSelectTxRet = CWalletDB(*dbw, "cr+").ZapSelectTx(vHashIn, vHashOut);
-    for (uint256 hash : vHashOut)
-        mapWallet.erase(hash);
+    for (uint256 hash : vHashOut) {
+        auto it = mapWallet.find(hash);
+        if (it == mapWallet.end())
+            continue;
+        CTransactionRef ptx = it->second.tx;
+        RemoveFromAssetIndex(hash);
+        mapWallet.erase(it);
+        // The outputs it spent are unspent again
+        for (const CTxIn& txin : ptx->vin)
+            UpdateAssetIndex(txin.prevout);
+    }
 
     if (nZapSelectTxRet == DB_NEED_REWRITE) {
         if (dbw->Rewrite("\x04pool")) {
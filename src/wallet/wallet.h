@@ -711,6 +711,20 @@ private:
     void AddToSpends(const COutPoint& outpoint, const uint256& wtxid);
     void AddToSpends(const uint256& wtxid);
 
+    /**
+     * Unspent outputs of wallet transactions that carry an asset, by asset
+     * name. Outputs of abandoned and conflicted transactions are left out.
+     * Ownership, locks and confirmation depth are checked when queried, so
+     * asset lookups scale with the wallet's unspent asset outputs instead of
+     * its history.
+     */
+    std::map<std::string, std::set<COutPoint>> mapAssetOutPoints;
+    /* Add outpoint to, or remove it from, mapAssetOutPoints according to its current state */
+    void UpdateAssetIndex(const COutPoint& outpoint);
+    /* Update the index entries of wtxid's outputs and of the outputs it spends */
+    void UpdateAssetIndex(const uint256& wtxid);
+    void RemoveFromAssetIndex(const uint256& wtxid);
+
     /* Mark a transaction (and its in-wallet descendants) as conflicting with a particular block. */
     void MarkConflicted(const uint256& hashBlock, const uint256& hashTx);
 
@@ -834,6 +848,9 @@ public:
 
     const CWalletTx* GetWalletTx(const uint256& hash) const;
 
+    /** The unspent wallet outputs that carry strAssetName, as tracked by the asset index */
+    std::set<COutPoint> GetAssetOutPoints(const std::string& strAssetName) const;
+
     //! check whether we are allowed to upgrade (or already support) to the named feature
     bool CanSupportFeature(enum WalletFeature wf) const { AssertLockHeld(cs_wallet); return nWalletMaxVersion >= wf; }
 
@@ -845,7 +862,8 @@ public:
                             bool fOnlySafe = true, const CCoinControl *coinControl = nullptr,
                             const CAmount& nMinimumAmount = 1, const CAmount& nMaximumAmount = MAX_MONEY,
                             const CAmount& nMinimumSumAmount = MAX_MONEY, const uint64_t& nMaximumCount = 0,
-                            const int& nMinDepth = 0, const int& nMaxDepth = 9999999) const;
+                            const int& nMinDepth = 0, const int& nMaxDepth = 9999999,
+                            const std::set<std::string>* setAssetNames = nullptr) const;
 
     /**
      * Helper function that calls AvailableCoinsAll, used for transfering assets
@@ -855,6 +873,14 @@ public:
                          const CAmount &nMaximumAmount = MAX_MONEY, const CAmount &nMinimumSumAmount = MAX_MONEY,
                          const uint64_t &nMaximumCount = 0, const int &nMinDepth = 0, const int &nMaxDepth = 9999999) const;
 
+    /**
+     * Helper function that calls AvailableCoinsAll, used for transfering the assets in setAssetNames only
+     */
+    void AvailableAssets(const std::set<std::string>& setAssetNames, std::map<std::string, std::vector<COutput> > &mapAssetCoins,
+                         bool fOnlySafe = true, const CCoinControl *coinControl = nullptr, const CAmount &nMinimumAmount = 1,
+                         const CAmount &nMaximumAmount = MAX_MONEY, const CAmount &nMinimumSumAmount = MAX_MONEY,
+                         const uint64_t &nMaximumCount = 0, const int &nMinDepth = 0, const int &nMaxDepth = 9999999) const;
+
     /**
      * Helper function that calls AvailableCoinsAll, used to receive all coins, Assets and SOTER
      */
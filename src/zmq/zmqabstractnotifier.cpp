@@ -12,7 +12,7 @@ CZMQAbstractNotifier::~CZMQAbstractNotifier()
     assert(!psocket);
 }
 
-bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/)
+bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/, const std::shared_ptr<const CBlock>& /*pblock*/)
 {
     return true;
 }
@@ -22,7 +22,17 @@ bool CZMQAbstractNotifier::NotifyTransaction(const CTransaction &/*transaction*/
     return true;
 }
 
+bool CZMQAbstractNotifier::NotifyBlockAssets(const CBlockIndex * /*pindex*/, const CBlockAssetActivity &/*activity*/)
+{
+    return true;
+}
+
 bool CZMQAbstractNotifier::NotifyMessage(const CMessage &/*message*/)
 {
     return true;
 }
+
+bool CZMQAbstractNotifier::NotifyContractJob(const CContractJob &/*job*/)
+{
+    return true;
+}
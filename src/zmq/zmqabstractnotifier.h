@@ -8,10 +8,14 @@
 #define SOTERIA_ZMQ_ZMQABSTRACTNOTIFIER_H
 
 #include "zmqconfig.h"
+#include <memory>
 #include <string>
+class CBlock;
 class CBlockIndex;
+struct CBlockAssetActivity;
 class CZMQAbstractNotifier;
 class CMessage;
+class CContractJob;
 
 typedef CZMQAbstractNotifier* (*CZMQNotifierFactory)();
 
@@ -35,9 +39,12 @@ public:
     virtual bool Initialize(void *pcontext) = 0;
     virtual void Shutdown() = 0;
 
-    virtual bool NotifyBlock(const CBlockIndex *pindex);
+    //! pblock: the block of pindex if it is still in memory, otherwise null
+    virtual bool NotifyBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock);
     virtual bool NotifyTransaction(const CTransaction &transaction);
+    virtual bool NotifyBlockAssets(const CBlockIndex *pindex, const CBlockAssetActivity &activity);
     virtual bool NotifyMessage(const CMessage& message);
+    virtual bool NotifyContractJob(const CContractJob& job);
 
 protected:
     void *psocket;
@@ -46,6 +46,13 @@ CZMQNotificationInterface* CZMQNotificationInterface::Create()
     factories["pubrawblock"] = CZMQAbstractNotifier::Create<CZMQPublishRawBlockNotifier>;
     factories["pubrawtx"] = CZMQAbstractNotifier::Create<CZMQPublishRawTransactionNotifier>;
     factories["pubrawmessage"] = CZMQAbstractNotifier::Create<CZMQPublishNewAssetMessageNotifier>;
+    factories["pubcontractresult"] = CZMQAbstractNotifier::Create<CZMQPublishContractResultNotifier>;
+    factories["pubassettransfer"] = CZMQAbstractNotifier::Create<CZMQPublishAssetTransferNotifier>;
+    factories["pubassetissue"] = CZMQAbstractNotifier::Create<CZMQPublishAssetIssueNotifier>;
+    factories["pubassetreissue"] = CZMQAbstractNotifier::Create<CZMQPublishAssetReissueNotifier>;
+    factories["pubassettag"] = CZMQAbstractNotifier::Create<CZMQPublishAssetTagNotifier>;
+    factories["pubassetfreeze"] = CZMQAbstractNotifier::Create<CZMQPublishAssetFreezeNotifier>;
+    factories["pubassetverifier"] = CZMQAbstractNotifier::Create<CZMQPublishAssetVerifierNotifier>;
 
     for (const auto& entry : factories)
     {
@@ -133,13 +140,20 @@ void CZMQNotificationInterface::Shutdown()
 
 void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload)
 {
+    LOCK(cs_notifiers);
+    std::shared_ptr<const CBlock> pblockNew;
+    if (pindexConnected == pindexNew)
+        pblockNew = pblockConnected;
+    pblockConnected.reset();
+    pindexConnected = nullptr;
+
     if (fInitialDownload || pindexNew == pindexFork) // In IBD or blocks were disconnected without any new ones
         return;
 
     for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
     {
         CZMQAbstractNotifier *notifier = *i;
-        if (notifier->NotifyBlock(pindexNew))
+        if (notifier->NotifyBlock(pindexNew, pblockNew))
         {
             i++;
         }
@@ -153,6 +167,7 @@ void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, co
 
 void CZMQNotificationInterface::NewAssetMessage(const CMessage& message)
 {
+    LOCK(cs_notifiers);
     for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
     {
         CZMQAbstractNotifier *notifier = *i;
@@ -168,12 +183,31 @@ void CZMQNotificationInterface::NewAssetMessage(const CMessage& message)
     }
 }
 
+void CZMQNotificationInterface::SmartContractFinished(const CContractJob& job)
+{
+    LOCK(cs_notifiers);
+    for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
+    {
+        CZMQAbstractNotifier *notifier = *i;
+        if (notifier->NotifyContractJob(job))
+        {
+            i++;
+        }
+        else
+        {
+            notifier->Shutdown();
+            i = notifiers.erase(i);
+        }
+    }
+}
+
 void CZMQNotificationInterface::TransactionAddedToMempool(const CTransactionRef& ptx)
 {
     // Used by BlockConnected and BlockDisconnected as well, because they're
     // all the same external callback.
     const CTransaction& tx = *ptx;
 
+    LOCK(cs_notifiers);
     for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
     {
         CZMQAbstractNotifier *notifier = *i;
@@ -189,14 +223,38 @@ void CZMQNotificationInterface::TransactionAddedToMempool(const CTransactionRef&
     }
 }
 
-void CZMQNotificationInterface::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected, const std::vector<CTransactionRef>& vtxConflicted)
+void CZMQNotificationInterface::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex, const std::vector<CTransactionRef>& vtxConflicted)
 {
+    {
+        LOCK(cs_notifiers);
+        pblockConnected = pblock;
+        pindexConnected = pindex;
+    }
+
     for (const CTransactionRef& ptx : pblock->vtx) {
         // Do a normal notify for each transaction added in the block
         TransactionAddedToMempool(ptx);
     }
 }
 
+void CZMQNotificationInterface::BlockAssetsConnected(const CBlockIndex *pindex, const std::shared_ptr<const CBlockAssetActivity>& activity)
+{
+    LOCK(cs_notifiers);
+    for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
+    {
+        CZMQAbstractNotifier *notifier = *i;
+        if (notifier->NotifyBlockAssets(pindex, *activity))
+        {
+            i++;
+        }
+        else
+        {
+            notifier->Shutdown();
+            i = notifiers.erase(i);
+        }
+    }
+}
+
 void CZMQNotificationInterface::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock)
 {
     for (const CTransactionRef& ptx : pblock->vtx) {
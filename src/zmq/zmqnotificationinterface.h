@@ -7,6 +7,7 @@
 #ifndef SOTERIA_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 #define SOTERIA_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 
+#include "sync.h"
 #include "validationinterface.h"
 #include <string>
 #include <map>
@@ -30,16 +31,23 @@ protected:
 
     // CValidationInterface
     void TransactionAddedToMempool(const CTransactionRef& tx) override;
-    void BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected, const std::vector<CTransactionRef>& vtxConflicted) override;
+    void BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex, const std::vector<CTransactionRef>& vtxConflicted) override;
+    void BlockAssetsConnected(const CBlockIndex *pindex, const std::shared_ptr<const CBlockAssetActivity>& activity) override;
     void BlockDisconnected(const std::shared_ptr<const CBlock>& pblock) override;
     void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload) override;
     void NewAssetMessage(const CMessage& message) override;
+    void SmartContractFinished(const CContractJob& job) override;
 
 private:
     CZMQNotificationInterface();
 
     void *pcontext;
+    //! Contract results are published from executor threads, so notifiers are shared between threads
+    CCriticalSection cs_notifiers;
     std::list<CZMQAbstractNotifier*> notifiers;
+    //! The last block BlockConnected() saw, kept for the UpdatedBlockTip() that follows so rawblock needn't read it back from disk
+    std::shared_ptr<const CBlock> pblockConnected;
+    const CBlockIndex* pindexConnected = nullptr;
 };
 
 #endif // SOTERIA_ZMQ_ZMQNOTIFICATIONINTERFACE_H
@@ -11,6 +11,8 @@
 #include "validation.h"
 #include <util/system.h>
 #include "rpc/server.h"
+#include "smartcontracts/contractexecutor.h"
+#include "assets/assets.h"
 #include <map>
 #include <string>
 #include <utility>
@@ -22,6 +24,13 @@ static const char *MSG_HASHTX      = "hashtx";
 static const char *MSG_RAWBLOCK    = "rawblock";
 static const char *MSG_RAWTX       = "rawtx";
 static const char *MSG_RAWASSETMSG = "rawmessage";
+static const char *MSG_CONTRACTRESULT = "contractresult";
+static const char *MSG_ASSETTRANSFER = "assettransfer";
+static const char *MSG_ASSETISSUE = "assetissue";
+static const char *MSG_ASSETREISSUE = "assetreissue";
+static const char *MSG_ASSETTAG = "assettag";
+static const char *MSG_ASSETFREEZE = "assetfreeze";
+static const char *MSG_ASSETVERIFIER = "assetverifier";
 
 // Internal function to send multipart message
 static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
@@ -66,6 +75,40 @@ static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
     return 0;
 }
 
+// Internal function to send one part of a multipart message, which is closed afterwards
+static int zmq_send_part(void *sock, zmq_msg_t *msg, bool more)
+{
+    int rc = zmq_msg_send(msg, sock, more ? ZMQ_SNDMORE : 0);
+    zmq_msg_close(msg);
+    if (rc == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        return -1;
+    }
+    return 0;
+}
+
+// Internal function to copy a buffer into a message part and send it
+static int zmq_send_part(void *sock, const void* data, size_t size, bool more)
+{
+    zmq_msg_t msg;
+    if (zmq_msg_init_size(&msg, size) != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        return -1;
+    }
+    memcpy(zmq_msg_data(&msg), data, size);
+    return zmq_send_part(sock, &msg, more);
+}
+
+typedef std::shared_ptr<const std::vector<unsigned char>> ZMQSharedBuffer;
+
+// Called by ZMQ, possibly on its I/O thread, once it is done with a buffer sent without copying
+static void zmq_release_buffer(void * /*data*/, void *hint)
+{
+    delete static_cast<ZMQSharedBuffer*>(hint);
+}
+
 bool CZMQAbstractPublishNotifier::Initialize(void *pcontext)
 {
     assert(!psocket);
@@ -152,7 +195,41 @@ bool CZMQAbstractPublishNotifier::SendMessage(const char *command, const void* d
     return true;
 }
 
-bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
+bool CZMQAbstractPublishNotifier::SendMessage(const char *command, const ZMQSharedBuffer& data)
+{
+    assert(psocket);
+
+    unsigned char msgseq[sizeof(uint32_t)];
+    WriteLE32(&msgseq[0], nSequence);
+
+    // ZMQ keeps its own reference to the buffer until it has gone out on every connection
+    ZMQSharedBuffer* hint = new ZMQSharedBuffer(data);
+    zmq_msg_t msg;
+    if (zmq_msg_init_data(&msg, const_cast<unsigned char*>(data->data()), data->size(), zmq_release_buffer, hint) != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        delete hint;
+        return false;
+    }
+
+    if (zmq_send_part(psocket, command, strlen(command), true) == -1)
+    {
+        zmq_msg_close(&msg);
+        return false;
+    }
+    if (zmq_send_part(psocket, &msg, true) == -1)
+        return false;
+
+    if (zmq_send_part(psocket, msgseq, sizeof(msgseq), false) == -1)
+        return false;
+
+    /* increment memory only sequence number after sending */
+    nSequence++;
+
+    return true;
+}
+
+bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& /*pblock*/)
 {
     uint256 hash = pindex->GetBlockHash();
     LogPrint(BCLog::ZMQ, "zmq: Publish hashblock %s\n", hash.GetHex());
@@ -172,25 +249,43 @@ bool CZMQPublishHashTransactionNotifier::NotifyTransaction(const CTransaction &t
     return SendMessage(MSG_HASHTX, data, 32);
 }
 
-bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
+bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock)
 {
     LogPrint(BCLog::ZMQ, "zmq: Publish rawblock %s\n", pindex->GetBlockHash().GetHex());
 
-    const Consensus::ConsensusParams& consensusParams = Params().GetConsensus();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
-    {
-        LOCK(cs_main);
-        CBlock block;
-        if(!ReadBlockFromDisk(block, pindex, consensusParams))
+    // The bytes are put straight into the buffer ZMQ sends from, and cs_main is
+    // only held to look up where the block is stored, never during I/O
+    std::shared_ptr<std::vector<unsigned char>> data = std::make_shared<std::vector<unsigned char>>();
+    const int nVersion = PROTOCOL_VERSION | RPCSerializationFlags();
+    if (pblock) {
+        // Just connected, so still in memory
+        data->reserve(::GetSerializeSize(*pblock, SER_NETWORK, nVersion));
+        CVectorWriter(SER_NETWORK, nVersion, *data, 0, *pblock);
+    } else {
+        CDiskBlockPos pos;
         {
-            zmqError("Can't read block from disk");
-            return false;
+            LOCK(cs_main);
+            pos = pindex->GetBlockPos();
+        }
+        if (!(nVersion & SERIALIZE_TRANSACTION_NO_WITNESS)) {
+            // Blocks are stored in their network serialization with witness data
+            if (!ReadRawBlockFromDisk(*data, pos, Params().MessageStart()))
+            {
+                zmqError("Can't read block from disk");
+                return false;
+            }
+        } else {
+            CBlock block;
+            if (!ReadBlockFromDisk(block, pos, Params().GetConsensus()) || block.GetHash() != pindex->GetBlockHash())
+            {
+                zmqError("Can't read block from disk");
+                return false;
+            }
+            CVectorWriter(SER_NETWORK, nVersion, *data, 0, block);
         }
-
-        ss << block;
     }
 
-    return SendMessage(MSG_RAWBLOCK, &(*ss.begin()), ss.size());
+    return SendMessage(MSG_RAWBLOCK, data);
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &transaction)
@@ -202,6 +297,81 @@ bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &tr
     return SendMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
 }
 
+//! The records of one asset topic for one asset of a block
+struct CZMQAssetRecords
+{
+    uint64_t nRecords = 0;
+    std::vector<unsigned char> vchRecords;
+
+    template <typename... Args>
+    void Add(const Args&... args)
+    {
+        CVectorWriter(SER_NETWORK, PROTOCOL_VERSION, vchRecords, vchRecords.size(), args...);
+        nRecords++;
+    }
+};
+
+bool CZMQPublishAssetNotifier::NotifyBlockAssets(const CBlockIndex *pindex, const CBlockAssetActivity &activity)
+{
+    const char *command = nullptr;
+    std::map<std::string, CZMQAssetRecords> mapRecords;
+    switch (topic) {
+    case ZMQAssetTopic::TRANSFER:
+        command = MSG_ASSETTRANSFER;
+        for (const CAssetCacheNewTransfer& transfer : activity.setTransfers)
+            mapRecords[transfer.transfer.strName].Add(transfer.out, transfer.address, transfer.transfer.nAmount, transfer.transfer.message, transfer.transfer.nExpireTime);
+        break;
+    case ZMQAssetTopic::ISSUE:
+        command = MSG_ASSETISSUE;
+        for (const CAssetCacheNewAsset& newAsset : activity.setNewAssets) {
+            const CNewAsset& asset = newAsset.asset;
+            mapRecords[asset.strName].Add(newAsset.address, asset.nAmount, asset.units, asset.nReissuable, asset.nHasIPFS ? asset.strIPFSHash : std::string());
+        }
+        for (const CAssetCacheNewOwner& owner : activity.setNewOwnerAssets)
+            mapRecords[owner.assetName].Add(owner.address, (CAmount)OWNER_ASSET_AMOUNT, (int8_t)OWNER_UNITS, (int8_t)0, std::string());
+        break;
+    case ZMQAssetTopic::REISSUE:
+        command = MSG_ASSETREISSUE;
+        for (const CAssetCacheReissueAsset& reissue : activity.setReissues)
+            mapRecords[reissue.reissue.strName].Add(reissue.out, reissue.address, reissue.reissue.nAmount, reissue.reissue.nUnits, reissue.reissue.nReissuable, reissue.reissue.strIPFSHash);
+        break;
+    case ZMQAssetTopic::TAG:
+        command = MSG_ASSETTAG;
+        for (const CAssetCacheQualifierAddress& tag : activity.setQualifierAddresses)
+            mapRecords[tag.assetName].Add(tag.address, (uint8_t)tag.type);
+        break;
+    case ZMQAssetTopic::FREEZE:
+        command = MSG_ASSETFREEZE;
+        for (const CAssetCacheRestrictedAddress& freeze : activity.setRestrictedAddresses)
+            mapRecords[freeze.assetName].Add(freeze.address, (uint8_t)freeze.type);
+        // Global freezes have no address
+        for (const CAssetCacheRestrictedGlobal& freeze : activity.setRestrictedGlobals)
+            mapRecords[freeze.assetName].Add(std::string(), (uint8_t)freeze.type);
+        break;
+    case ZMQAssetTopic::VERIFIER:
+        command = MSG_ASSETVERIFIER;
+        for (const CAssetCacheRestrictedVerifiers& verifier : activity.setRestrictedVerifiers)
+            mapRecords[verifier.assetName].Add(verifier.verifier);
+        break;
+    }
+    assert(command);
+
+    if (mapRecords.empty())
+        return true;
+
+    LogPrint(BCLog::ZMQ, "zmq: Publish %s for %u assets of block %s\n", command, mapRecords.size(), pindex->GetBlockHash().GetHex());
+    for (const auto& entry : mapRecords) {
+        std::shared_ptr<std::vector<unsigned char>> data = std::make_shared<std::vector<unsigned char>>();
+        CVectorWriter(SER_NETWORK, PROTOCOL_VERSION, *data, 0, pindex->GetBlockHash(), pindex->nHeight, COMPACTSIZE(entry.second.nRecords));
+        data->insert(data->end(), entry.second.vchRecords.begin(), entry.second.vchRecords.end());
+
+        std::string strTopic = strprintf("%s|%s|", command, entry.first);
+        if (!SendMessage(strTopic.c_str(), data))
+            return false;
+    }
+    return true;
+}
+
 bool CZMQPublishNewAssetMessageNotifier::NotifyMessage(const CMessage &message)
 {
     LogPrint(BCLog::ZMQ, "zmq: Publish message %s\n", message.ToString());
@@ -210,3 +380,19 @@ bool CZMQPublishNewAssetMessageNotifier::NotifyMessage(const CMessage &message)
     std::string str = zmqmessage.createJsonString();
     return SendMessage(MSG_RAWASSETMSG, &(*str.begin()), str.size());
 }
+
+bool CZMQPublishContractResultNotifier::NotifyContractJob(const CContractJob &job)
+{
+    LogPrint(BCLog::ZMQ, "zmq: Publish contractresult %u\n", job.nId);
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("id", job.nId);
+    obj.pushKV("contract", job.strContract);
+    obj.pushKV("function", job.strFunction);
+    obj.pushKV("error", job.result.is_error);
+    obj.pushKV("result", job.result.result);
+    obj.pushKV("gas", job.result.gas);
+    obj.pushKV("memory", (uint64_t)job.result.memory);
+    std::string str = obj.write();
+    return SendMessage(MSG_CONTRACTRESULT, &(*str.begin()), str.size());
+}
@@ -9,6 +9,9 @@
 
 #include "zmqabstractnotifier.h"
 
+#include <memory>
+#include <vector>
+
 class CBlockIndex;
 class CMessage;
 
@@ -27,6 +30,11 @@ public:
     */
     bool SendMessage(const char *command, const void* data, size_t size);
 
+    /* send the same three parts, with ZMQ holding on to data until it is sent
+       instead of copying it
+    */
+    bool SendMessage(const char *command, const std::shared_ptr<const std::vector<unsigned char>>& data);
+
     bool Initialize(void *pcontext) override;
     void Shutdown() override;
 };
@@ -34,7 +42,7 @@ public:
 class CZMQPublishHashBlockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock) override;
 };
 
 class CZMQPublishHashTransactionNotifier : public CZMQAbstractPublishNotifier
@@ -46,7 +54,7 @@ public:
 class CZMQPublishRawBlockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock) override;
 };
 
 class CZMQPublishRawTransactionNotifier : public CZMQAbstractPublishNotifier
@@ -55,10 +63,81 @@ public:
     bool NotifyTransaction(const CTransaction &transaction) override;
 };
 
+/** The asset changes a CZMQPublishAssetNotifier publishes, one topic each */
+enum class ZMQAssetTopic
+{
+    TRANSFER,   //!< assettransfer: asset outputs created by transfers
+    ISSUE,      //!< assetissue: new assets, owner tokens included
+    REISSUE,    //!< assetreissue
+    TAG,        //!< assettag: qualifiers added to or removed from addresses
+    FREEZE,     //!< assetfreeze: restricted assets frozen or unfrozen, per address or globally
+    VERIFIER    //!< assetverifier: verifier strings set for restricted assets
+};
+
+/**
+ * Publishes the asset changes of every connected block, one message per block
+ * and asset. The topic is "<topic>|<asset name>|" so subscribers can filter by
+ * asset with ZMQ's prefix matching, '|' not being part of any asset name. The
+ * body is the block hash, the block height and the records for the asset, in
+ * compact binary form (see doc/zmq.md).
+ */
+class CZMQPublishAssetNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    explicit CZMQPublishAssetNotifier(ZMQAssetTopic topicIn) : topic(topicIn) {}
+
+    bool NotifyBlockAssets(const CBlockIndex *pindex, const CBlockAssetActivity &activity) override;
+
+private:
+    const ZMQAssetTopic topic;
+};
+
+class CZMQPublishAssetTransferNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetTransferNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::TRANSFER) {}
+};
+
+class CZMQPublishAssetIssueNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetIssueNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::ISSUE) {}
+};
+
+class CZMQPublishAssetReissueNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetReissueNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::REISSUE) {}
+};
+
+class CZMQPublishAssetTagNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetTagNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::TAG) {}
+};
+
+class CZMQPublishAssetFreezeNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetFreezeNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::FREEZE) {}
+};
+
+class CZMQPublishAssetVerifierNotifier : public CZMQPublishAssetNotifier
+{
+public:
+    CZMQPublishAssetVerifierNotifier() : CZMQPublishAssetNotifier(ZMQAssetTopic::VERIFIER) {}
+};
+
 class CZMQPublishNewAssetMessageNotifier : public CZMQAbstractPublishNotifier
 {
 public:
     bool NotifyMessage(const CMessage& message) override;
 };
 
+class CZMQPublishContractResultNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyContractJob(const CContractJob& job) override;
+};
+
 #endif // SOTERIA_ZMQ_ZMQPUBLISHNOTIFIER_H
@@ -166,6 +166,18 @@ class AssetTest(SoteriaTestFramework):
         assert_equal(len(soteria_assets), 2)
         assert_equal(soteria_assets[0], "SOTERIA2")
         assert_equal(soteria_assets[1], "SOTERIA3")
+
+        self.log.info("Checking listassetspage()...")
+        paged_assets = []
+        page = n0.listassetspage("SOTERIA*", False, 2)
+        while True:
+            assert(len(page["assets"]) <= 2)
+            paged_assets += page["assets"]
+            if page["next"] == "":
+                break
+            page = n0.listassetspage("SOTERIA*", False, 2, page["next"])
+        assert_equal(paged_assets, n0.listassets(asset="SOTERIA*", verbose=False))
+        assert_equal(n0.listassetspage("SOTERIA2", False)["assets"], ["SOTERIA2"])
         self.sync_all()
 
     def issue_param_checks(self):
@@ -9,8 +9,10 @@
 """Test the ZMQ notification interface."""
 
 import configparser
+import io
 import os
 import struct
+from test_framework.messages import COutPoint, deser_compact_size, deser_string, deser_uint256
 from test_framework.test_framework import SoteriaTestFramework, SkipTest
 from test_framework.util import assert_equal, hash256, x16_hash_block
 
@@ -73,13 +75,24 @@ class ZMQTest(SoteriaTestFramework):
         self.rawblock = ZMQSubscriber(socket, b"rawblock")
         self.rawtx = ZMQSubscriber(socket, b"rawtx")
 
-        self.extra_args = [["-zmqpub%s=%s" % (sub.topic.decode(), address) for sub in [self.hashblock, self.hashtx, self.rawblock, self.rawtx]], []]
+        # Asset topics go to a socket of their own, subscribed to one asset only.
+        asset_address = "tcp://127.0.0.1:28767"
+        self.asset_socket = self.zmq_context.socket(zmq.SUB)
+        self.asset_socket.set(zmq.RCVTIMEO, 60000)
+        self.asset_socket.connect(asset_address)
+        # Prefix without the closing '|', so the owner token ZMQ_ASSET! comes along
+        self.asset_socket.setsockopt(zmq.SUBSCRIBE, b"assetissue|ZMQ_ASSET")
+        self.asset_socket.setsockopt(zmq.SUBSCRIBE, b"assettransfer|ZMQ_ASSET|")
+
+        self.extra_args = [["-zmqpub%s=%s" % (sub.topic.decode(), address) for sub in [self.hashblock, self.hashtx, self.rawblock, self.rawtx]] +
+                           ["-zmqpub%s=%s" % (topic, asset_address) for topic in ["assetissue", "assettransfer"]], []]
         self.add_nodes(self.num_nodes, self.extra_args)
         self.start_nodes()
 
     def run_test(self):
         try:
             self._zmq_test()
+            self._zmq_asset_test()
         finally:
             # Destroy the ZMQ context.
             self.log.debug("Destroying ZMQ context")
@@ -108,6 +121,8 @@ class ZMQTest(SoteriaTestFramework):
             # Should receive the generated raw block.
             block = self.rawblock.receive()
             assert_equal(genhashes[x], x16_hash_block(block[:80].hex(), "2"))
+            # It is the block's full network serialization, as getblock returns it.
+            assert_equal(block.hex(), self.nodes[1].getblock(hash_data, 0))
 
         self.log.info("Wait for tx from second node")
         payment_txid = self.nodes[1].sendtoaddress(self.nodes[0].getnewaddress(), 1.0)
@@ -121,6 +136,61 @@ class ZMQTest(SoteriaTestFramework):
         hex_data = self.rawtx.receive()
         assert_equal(payment_txid, hash256(hex_data).hex())
 
+    def _receive_asset_records(self, topic, block_hash, height):
+        """Receive an asset notification with the given topic and return a reader positioned at its records, and their count"""
+        received_topic, body, _ = self.asset_socket.recv_multipart()
+        assert_equal(received_topic, topic)
+        f = io.BytesIO(body)
+        assert_equal(deser_uint256(f), int(block_hash, 16))
+        assert_equal(struct.unpack("<i", f.read(4))[0], height)
+        return f, deser_compact_size(f)
+
+    def _zmq_asset_test(self):
+        n0, n1 = self.nodes[0], self.nodes[1]
+        self.log.info("Activate assets")
+        n0.generate(432)
+        self.sync_all()
+
+        self.log.info("Issue an asset")
+        address0 = n0.getnewaddress()
+        n0.issue(asset_name="ZMQ_ASSET", qty=1000, to_address=address0, units=2)
+        block_hash = n0.generate(1)[0]
+        height = n0.getblockcount()
+
+        # Assets are published in name order, so the asset comes before its owner token
+        f, count = self._receive_asset_records(b"assetissue|ZMQ_ASSET|", block_hash, height)
+        assert_equal(count, 1)
+        assert_equal(deser_string(f).decode(), address0)
+        assert_equal(struct.unpack("<q", f.read(8))[0], 1000 * 100000000)
+        assert_equal(struct.unpack("<bb", f.read(2)), (2, 1))
+        assert_equal(deser_string(f), b"")
+
+        f, count = self._receive_asset_records(b"assetissue|ZMQ_ASSET!|", block_hash, height)
+        assert_equal(count, 1)
+        deser_string(f)
+        assert_equal(struct.unpack("<q", f.read(8))[0], 100000000)
+
+        self.log.info("Transfer some of it")
+        address1 = n1.getnewaddress()
+        txid = n0.transfer(asset_name="ZMQ_ASSET", qty=200, to_address=address1)[0]
+        block_hash = n0.generate(1)[0]
+        height = n0.getblockcount()
+
+        # The transfer and the asset change
+        f, count = self._receive_asset_records(b"assettransfer|ZMQ_ASSET|", block_hash, height)
+        assert_equal(count, 2)
+        amounts = {}
+        for _ in range(count):
+            out = COutPoint()
+            out.deserialize(f)
+            assert_equal(out.hash, int(txid, 16))
+            address = deser_string(f).decode()
+            amounts[address] = struct.unpack("<q", f.read(8))[0]
+            assert_equal(deser_string(f), b"")
+            f.read(8)
+        assert_equal(amounts[address1], 200 * 100000000)
+        assert_equal(sum(amounts.values()), 1000 * 100000000)
+
 
 if __name__ == '__main__':
     ZMQTest().main()
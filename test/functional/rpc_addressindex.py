@@ -10,9 +10,10 @@
 import binascii
 import time
 from test_framework.test_framework import SoteriaTestFramework
-from test_framework.util import connect_nodes_bi, assert_equal
+from test_framework.util import connect_nodes_bi, assert_equal, assert_raises_rpc_error
 from test_framework.script import CScript, OP_HASH160, OP_EQUAL, OP_DUP, OP_EQUALVERIFY, OP_CHECKSIG
 from test_framework.mininode import CTransaction, CTxIn, CTxOut, COutPoint
+from test_framework.address import scripthash_to_p2sh
 
 class AddressIndexTest(SoteriaTestFramework):
 
@@ -107,6 +108,40 @@ class AddressIndexTest(SoteriaTestFramework):
         assert_equal(multi_tx_ids[4], tx_id2)
         assert_equal(multi_tx_ids[5], tx_idb2)
 
+        # Check that paging with a cursor returns the same txids
+        self.log.info("Testing txid pages...")
+        paged_tx_ids = []
+        page = {"next": ""}
+        while page["next"] is not None:
+            page = self.nodes[1].getaddresstxids({"addresses": ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br", "mo9ncXisMeAoXwqcV5EWuyncbmCcQN4rVs"],
+                                                  "cursor": page["next"], "limit": 4})
+            assert(len(page["txids"]) <= 4)
+            paged_tx_ids += page["txids"]
+        assert_equal(paged_tx_ids, multi_tx_ids)
+
+        paged_deltas = []
+        page = {"next": ""}
+        while page["next"] is not None:
+            page = self.nodes[1].getaddressdeltas({"addresses": ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br", "mo9ncXisMeAoXwqcV5EWuyncbmCcQN4rVs"],
+                                                   "cursor": page["next"], "limit": 2})
+            assert(len(page["deltas"]) <= 2)
+            paged_deltas += page["deltas"]
+        assert_equal(paged_deltas, self.nodes[1].getaddressdeltas({"addresses": ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br", "mo9ncXisMeAoXwqcV5EWuyncbmCcQN4rVs"]}))
+        assert_raises_rpc_error(-8, "Invalid cursor", self.nodes[1].getaddresstxids, {"addresses": ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br"], "cursor": "zz"})
+
+        # A page that fills up exactly at the end of an address must not lose the height range for the next one.
+        # Each address has two deltas in blocks 108 to 111, and one below them.
+        range_query = {"addresses": ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br", "mo9ncXisMeAoXwqcV5EWuyncbmCcQN4rVs"], "start": 108, "end": 111}
+        paged_deltas = []
+        page = {"next": ""}
+        while page["next"] is not None:
+            page = self.nodes[1].getaddressdeltas(dict(range_query, cursor=page["next"], limit=2))
+            assert(len(page["deltas"]) <= 2)
+            paged_deltas += page["deltas"]
+        assert_equal(len(paged_deltas), 4)
+        assert(all(108 <= delta["height"] <= 111 for delta in paged_deltas))
+        assert_equal(paged_deltas, self.nodes[1].getaddressdeltas(range_query))
+
         # Check that balances are correct
         balance0 = self.nodes[1].getaddressbalance("2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br")
         assert_equal(balance0["balance"], 45 * 100000000)
@@ -343,6 +378,41 @@ class AddressIndexTest(SoteriaTestFramework):
         assert_equal(utxos_with_info["height"], 267)
         assert_equal(utxos_with_info["hash"], expected_tip_block_hash)
 
+        # The index orders the entries of a transaction by their little endian output index,
+        # so 256 sorts before 1. Pages that end inside such a transaction must still resume in index order.
+        self.log.info("Testing pages inside a transaction with more than 256 outputs to one address...")
+        address_hash5 = bytes(range(20))
+        address5 = scripthash_to_p2sh(address_hash5)
+        unspent = self.nodes[0].listunspent()
+        tx = CTransaction()
+        tx.vin = [CTxIn(COutPoint(int(unspent[0]["txid"], 16), unspent[0]["vout"]))]
+        tx.vout = [CTxOut(1000 + i, CScript([OP_HASH160, address_hash5, OP_EQUAL])) for i in range(300)]
+        tx.rehash()
+        signed_tx = self.nodes[0].signrawtransaction(binascii.hexlify(tx.serialize()).decode("utf-8"))
+        self.nodes[0].sendrawtransaction(signed_tx["hex"], True)
+        self.nodes[0].generate(1)
+        self.sync_all()
+
+        all_deltas = self.nodes[1].getaddressdeltas({"addresses": [address5]})
+        assert_equal(len(all_deltas), 300)
+        paged_deltas = []
+        page = {"next": ""}
+        while page["next"] is not None:
+            page = self.nodes[1].getaddressdeltas({"addresses": [address5], "cursor": page["next"], "limit": 70})
+            paged_deltas += page["deltas"]
+        assert_equal(paged_deltas, all_deltas)
+
+        # The balance index summed up again from the address index matches the one blocks were connected into
+        self.log.info("Testing a rebuilt address balance index...")
+        balance_addresses = ["2N2JD6wb56AfK4tfmM6PwdVmoYk2dCKf4Br", "mo9ncXisMeAoXwqcV5EWuyncbmCcQN4rVs", address1, address2, address5]
+        balances = [self.nodes[1].getaddressbalance(address) for address in balance_addresses]
+        self.restart_node(1, ["-addressindex", "-rebuildaddressbalanceindex"])
+        for address, balance in zip(balance_addresses, balances):
+            amounts = [delta["soterios"] for delta in self.nodes[1].getaddressdeltas({"addresses": [address]})]
+            assert_equal(self.nodes[1].getaddressbalance(address), balance)
+            assert_equal(balance["balance"], sum(amounts))
+            assert_equal(balance["received"], sum(amount for amount in amounts if amount > 0))
+
         self.log.info("All Tests Passed")
 
 
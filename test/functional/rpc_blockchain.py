@@ -15,6 +15,7 @@ Test the following RPCs:
     - getblockhash
     - getblockheader
     - getchaintxstats
+    - getblockindexaudit
     - getnetworkhashps
     - verifychain
 
@@ -25,7 +26,7 @@ from decimal import Decimal
 import http.client
 import subprocess
 from test_framework.test_framework import SoteriaTestFramework
-from test_framework.util import assert_equal, assert_greater_than, assert_greater_than_or_equal, assert_raises, assert_raises_rpc_error, assert_is_hex_string, assert_is_hash_string
+from test_framework.util import wait_until, assert_equal, assert_greater_than, assert_greater_than_or_equal, assert_raises, assert_raises_rpc_error, assert_is_hex_string, assert_is_hash_string
 
 class BlockchainTest(SoteriaTestFramework):
     def set_test_params(self):
@@ -41,6 +42,7 @@ class BlockchainTest(SoteriaTestFramework):
         self._test_getnetworkhashps()
         self._test_stopatheight()
         assert self.nodes[0].verifychain(4, 0)
+        self._test_getblockindexaudit()
 
     def _test_getblockchaininfo(self):
         self.log.info("Test getblockchaininfo")
@@ -216,6 +218,21 @@ class BlockchainTest(SoteriaTestFramework):
         self.start_node(0)
         assert_equal(self.nodes[0].getblockcount(), 207)
 
+    def _test_getblockindexaudit(self):
+        audit = self.nodes[0].getblockindexaudit()
+        assert_equal(audit['started'], False)
+        assert_equal(audit['checked'], 0)
+
+        self.restart_node(0, ['-auditblockindexpow'])
+        node = self.nodes[0]
+        wait_until(lambda: node.getblockindexaudit()['done'], err_msg="block index PoW audit did not finish", timeout=60)
+        audit = node.getblockindexaudit()
+        assert_equal(audit['total'], node.getblockcount() + 1)
+        assert_equal(audit['checked'], audit['total'])
+        assert_equal(audit['progress'], 1)
+        assert_equal(audit['failed'], 0)
+        assert_equal(audit['failedhashes'], [])
+
 
 if __name__ == '__main__':
     BlockchainTest().main()